@@ -0,0 +1,11 @@
+# $Header$
+def generate(env, **kw):
+    if not kw.get('depsOnly', 0):
+        env.Tool('addLibrary', library = ['CRfluxCore'])
+    env.Tool('addLibrary', library = env['clhepLibs'])
+    env.Tool('astroLib')
+    env.Tool('facilitiesLib')
+    if env['PLATFORM'] != 'win32':
+        env.Tool('addLibrary', library = ['pthread'])
+def exists(env):
+    return 1;
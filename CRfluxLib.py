@@ -2,6 +2,7 @@
 def generate(env, **kw):
     if not kw.get('depsOnly', 0):
         env.Tool('addLibrary', library = ['CRflux'])
+    env.Tool('CRfluxCoreLib')
     env.Tool('addLibrary', library = env['cfitsioLibs'])
     env.Tool('addLibrary', library = env['clhepLibs'])
     env.Tool('EventLib')
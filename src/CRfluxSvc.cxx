@@ -6,7 +6,10 @@
 
 #include "FluxSvc/IRegisterSource.h"
 #include "ICRfluxSvc.h"
+#include "CrSamplingCounters.hh"
+#include "CrDiagnostics.hh"
 #include <iostream>
+#include <sstream>
 
 
 class CRfluxSvc : public Service, virtual public ICRfluxSvc
@@ -77,6 +80,22 @@ StatusCode CRfluxSvc::initialize()
 
 StatusCode CRfluxSvc::finalize()
 {
+    if (CrSamplingCounters::enabled()){
+        // efficiencies of the rejection loops of this job
+        MsgStream log(msgSvc(), name());
+        std::ostringstream counters;
+        CrSamplingCounters::print(counters);
+        log << MSG::INFO << "rejection sampling counters:" << endreq
+            << counters.str() << endreq;
+    }
+    // the warnings of the components, most of them printed once only
+    std::ostringstream warnings;
+    CrDiagnostics::summary(warnings);
+    if (!warnings.str().empty()){
+        MsgStream log(msgSvc(), name());
+        log << MSG::INFO << "warnings of the CRflux components (times):" << endreq
+            << warnings.str() << endreq;
+    }
     return StatusCode::SUCCESS;
 }
 
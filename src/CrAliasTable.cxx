@@ -0,0 +1,57 @@
+/****************************************************************************
+ * CrAliasTable.cxx:
+ ****************************************************************************
+ * Vose's version of Walker's alias method: the weights are scaled to a
+ * mean of 1, and each column below 1 is filled up by one above.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include "CrAliasTable.hh"
+
+void CrAliasTable::build(const std::vector<double>& weights)
+{
+  unsigned int n = weights.size();
+  m_prob.assign(n, 1.0);
+  m_alias.resize(n);
+  for (unsigned int k = 0; k < n; k++){ m_alias[k] = k; }
+  if (n < 2){ return; }
+
+  double total = 0;
+  for (unsigned int k = 0; k < n; k++){
+    if (weights[k] > 0){ total += weights[k]; }
+  }
+  if (!(total>0)){
+    // nothing to choose from; the first one is given back
+    for (unsigned int k = 1; k < n; k++){ m_prob[k] = 0; m_alias[k] = 0; }
+    return;
+  }
+
+  // scale to a mean of 1 and pair the columns below 1 with those above
+  std::vector<unsigned int> small, large;
+  for (unsigned int k = 0; k < n; k++){
+    m_prob[k] = (weights[k] > 0 ? weights[k] : 0)*n/total;
+    if (m_prob[k] < 1.0){ small.push_back(k); } else { large.push_back(k); }
+  }
+  while (!small.empty() && !large.empty()){
+    unsigned int s = small.back(); small.pop_back();
+    unsigned int l = large.back();
+    m_alias[s] = l;
+    m_prob[l] -= 1.0-m_prob[s];
+    if (m_prob[l] < 1.0){ large.pop_back(); small.push_back(l); }
+  }
+  // the rest is 1 up to rounding errors
+  for (unsigned int k = 0; k < small.size(); k++){ m_prob[small[k]] = 1.0; }
+  for (unsigned int k = 0; k < large.size(); k++){ m_prob[large[k]] = 1.0; }
+}
+
+// Gives back the index for a uniform random number r
+unsigned int CrAliasTable::index(double r) const
+{
+  unsigned int n = m_prob.size();
+  double u = r*n;
+  unsigned int k = static_cast<unsigned int>(u);
+  if (k >= n){ k = n-1; }
+  return (u-k < m_prob[k]) ? k : m_alias[k];
+}
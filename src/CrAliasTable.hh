@@ -0,0 +1,42 @@
+/**
+ * CrAliasTable:
+ *  Walker alias table of discrete weights, for the choice of a
+ *  component or an ion species with one random number.
+ */
+
+//$Header$
+
+#ifndef CrAliasTable_H
+#define CrAliasTable_H
+
+#include <vector>
+
+/** @class CrAliasTable
+ *  @brief choice among n weights in constant time
+ *
+ * Column k of the table is chosen with a uniform random number u*n,
+ * and the fractional part of u*n decides between k and its alias, so
+ * a choice costs one random number and no search.
+ */
+class CrAliasTable
+{
+public:
+  CrAliasTable() {}
+
+  /// Build the table of the weights; negative ones count as 0.  With
+  /// no positive weight, index() gives back 0.
+  void build(const std::vector<double>& weights);
+
+  /// Gives back the index for a uniform random number r in [0, 1);
+  /// the table must not be empty
+  unsigned int index(double r) const;
+
+  /// Gives back the number of weights
+  unsigned int size() const { return m_prob.size(); }
+
+private:
+  std::vector<double> m_prob;         ///< probability to keep column k
+  std::vector<unsigned int> m_alias;  ///< index taken otherwise
+};
+
+#endif // CrAliasTable_H
@@ -8,52 +8,28 @@
 #ifndef CrAlphaPrimary_H
 #define CrAlphaPrimary_H
 
-#include <utility>
-#include <string>
-
-#include "CrSpectrum.hh"
-
-// Forward declaration:
-class CLHEP::HepRandomEngine;
+#include "CrPrimarySpectrum.hh"
+
+/// Constants of the primary alphas, see CrPrimarySpectrum
+struct CrAlphaSpecies {
+  static constexpr double restE = 3.72; ///< [GeV]
+  static constexpr double charge = 2.0;
+  static constexpr double normalization = 1.50; ///< A of org_spec
+  static constexpr double index = 2.77; ///< a of org_spec
+  static constexpr double cutoffIndex = -12.0;
+  static constexpr bool relativistic = false;
+  static constexpr double highE = 40000.0; ///< [GeV] // corresponds to 100 GeV/n
+  static constexpr double eastWestCoeff = -12.0;
+  static constexpr double polarity = 1.0;
+  static const char* particle() { return "He"; }
+  static const char* title() { return "CrAlphaPrimary"; }
+};
 
-class CrAlphaPrimary : public CrSpectrum
+class CrAlphaPrimary : public CrPrimaryComponent<CrAlphaSpecies>
 {
 public:
   CrAlphaPrimary();
   ~CrAlphaPrimary();
-  
-  // Set satellite position, altitude and observation time and
-  // calculate energies related to COR.
-  // These energies will be used to generate particles.
-  void setPosition(double latitude, double longitude);
-  void setPosition(double latitude, double longitude, double time);
-  void setPosition(double latitude, double longitude, double time, 
-		   double altitude);
-
-  // Set geomagnetic cutoff rigidity and calculate the energies related.
-  // These energies are used to generate the particle. 
-  void setCutOffRigidity(double cor);
-
-  // Gives back particle direction in (cos(theta), phi)
-  std::pair<double,double> dir(double energy, CLHEP::HepRandomEngine* engine) const;
-
-  // Gives back particle energy
-  double energySrc(CLHEP::HepRandomEngine* engine) const;
-
-  // flux() returns the value averaged over the region from which
-  // the particle is coming from and the unit is [c/s/m^2/sr]
-  double flux() const;
-
-  // Gives back solid angle from which particle comes
-  double solidAngle() const;
-
-  // Gives back particle name
-  const char* particleName() const;
-
-  // Gives back the name of the component
-  std::string title() const;
-
 };
 
 #endif // CrAlphaPrimary_H
-
@@ -0,0 +1,328 @@
+/****************************************************************************
+ * CrBatchMath.cxx:
+ ****************************************************************************
+ * log and exp follow fdlibm (e_log.c and e_exp.c): the argument is
+ * reduced with the exponent of the double, and a polynomial (a
+ * rational function for exp) of the rest is added.  Special cases
+ * are selected, not branched to, so that the loops over the lanes
+ * have no branches.  The exponent is read and written with integer
+ * operations on the bits of the double, and converted with the
+ * 2**52 shifter instead of a conversion instruction, which AVX2 lacks
+ * for 64 bit integers.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "CrBatchMath.hh"
+
+// gcc clones the functions below for each instruction set and picks
+// one when the library is loaded (needs ifunc, i.e. glibc)
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) \
+  && defined(__linux__) && (__GNUC__ >= 6)
+#define CRFLUX_BATCH_DISPATCH 1
+#define CRFLUX_BATCH_TARGETS __attribute__((target_clones("avx512f","avx2","default")))
+#else
+#define CRFLUX_BATCH_TARGETS
+#endif
+
+// no fused multiply-add, which only some of the clones would use:
+// the results are then the same with any instruction set
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("fp-contract=off")
+#elif defined(__clang__)
+#pragma clang fp contract(off)
+#endif
+
+// the lanes are inlined into each clone to get its instruction set
+#if defined(__GNUC__)
+#define CRFLUX_BATCH_INLINE inline __attribute__((always_inline))
+#else
+#define CRFLUX_BATCH_INLINE inline
+#endif
+
+typedef unsigned long long Bits;
+
+// private function definitions.
+namespace {
+  const int lanes = CrBatchMath::lanes;
+
+  inline Bits toBits(double x){
+    Bits b;
+    std::memcpy(&b, &x, sizeof(b));
+    return b;
+  }
+
+  inline double fromBits(Bits b){
+    double x;
+    std::memcpy(&x, &b, sizeof(x));
+    return x;
+  }
+
+  // a if c, else b, without a branch
+  inline double select(bool c, double a, double b){
+    Bits mask = Bits(0) - Bits(c);
+    return fromBits((toBits(a) & mask) | (toBits(b) & ~mask));
+  }
+
+  const double ln2_hi = 6.93147180369123816490e-01;
+  const double ln2_lo = 1.90821492927058770002e-10;
+  const double log2e  = 1.44269504088896338700e+00;
+  // adding it rounds to an integer kept in the low bits of the mantissa
+  const double shifter = 6755399441055744.0; // 1.5 * 2**52
+  const double two54 = 18014398509481984.0;
+
+  // log: log(1+f) = f - f*f/2 + s*(f*f/2 + R(s*s)) with s = f/(2+f)
+  const double Lg1 = 6.666666666666735130e-01;
+  const double Lg2 = 3.999999999940941908e-01;
+  const double Lg3 = 2.857142874366239149e-01;
+  const double Lg4 = 2.222219843214978396e-01;
+  const double Lg5 = 1.818357216161805012e-01;
+  const double Lg6 = 1.531383769920937332e-01;
+  const double Lg7 = 1.479819860511658591e-01;
+
+  // exp: exp(r) = 1 + 2r/(2-c) - r with c = r - r*r*P(r*r)
+  const double P1 =  1.66666666666666019037e-01;
+  const double P2 = -2.77777777770155933842e-03;
+  const double P3 =  6.61375632143793436117e-05;
+  const double P4 = -1.65339022054652515390e-06;
+  const double P5 =  4.13813679705723846039e-08;
+
+  // exp(x) overflows above and is 0 below
+  const double expMax = 709.79;
+  const double expMin = -745.2;
+
+  CRFLUX_BATCH_INLINE void logLane(const double* __restrict x, double* __restrict y){
+    for (int j = 0; j < lanes; j++){
+      double v = x[j];
+      // subnormals are scaled into the normal range first
+      bool tiny = v < std::numeric_limits<double>::min();
+      double u = v*select(tiny, two54, 1.0);
+      Bits b = toBits(u);
+      // u = m * 2**e with m in [1, 2)
+      double e = fromBits(0x4330000000000000ULL | ((b >> 52) & 0x7ff))
+        - (4503599627370496.0 + 1023.0);
+      e -= select(tiny, 54.0, 0.0);
+      double m = fromBits((b & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+      // m in [sqrt(2)/2, sqrt(2))
+      bool big = m > M_SQRT2;
+      m *= select(big, 0.5, 1.0);
+      e += select(big, 1.0, 0.0);
+
+      double f = m - 1;
+      double s = f/(2+f);
+      double z = s*s;
+      double w = z*z;
+      double t1 = w*(Lg2+w*(Lg4+w*Lg6));
+      double t2 = z*(Lg1+w*(Lg3+w*(Lg5+w*Lg7)));
+      double R = t2+t1;
+      double hfsq = 0.5*f*f;
+      double r = e*ln2_hi - ((hfsq - (s*(hfsq+R) + e*ln2_lo)) - f);
+
+      r = select(v == 0, -std::numeric_limits<double>::infinity(), r);
+      r = select(v < 0, std::numeric_limits<double>::quiet_NaN(), r);
+      // +inf and NaN give themselves
+      y[j] = select(v < std::numeric_limits<double>::infinity(), r, v);
+    }
+  }
+
+  CRFLUX_BATCH_INLINE void expLane(const double* __restrict x, double* __restrict y){
+    for (int j = 0; j < lanes; j++){
+      double v = x[j];
+      double xc = select(v > expMax, expMax, v);
+      xc = select(xc < expMin, expMin, xc);
+      // x = k*ln2 + r with |r| <= ln2/2
+      double kd = xc*log2e + shifter;
+      kd = kd - shifter;
+      double hi = xc - kd*ln2_hi;
+      double lo = kd*ln2_lo;
+      double r = hi - lo;
+      double t = r*r;
+      double c = r - t*(P1+t*(P2+t*(P3+t*(P4+t*P5))));
+      double ex = 1 - ((lo - (r*c)/(2.0-c)) - hi);
+
+      // 2**k in two factors, each a normal double, so that the
+      // product under- or overflows as exp(x) does
+      double k1 = (kd*0.5 - 0.25 + shifter) - shifter;
+      double k2 = kd - k1;
+      double s1 = fromBits((toBits(k1 + shifter) + 1023) << 52);
+      double s2 = fromBits((toBits(k2 + shifter) + 1023) << 52);
+      ex = ex*s1*s2;
+
+      // NaN gives itself
+      y[j] = select(v == v, ex, v);
+    }
+  }
+
+  // pow(x, y) = exp(y*log(x)), for x > 0
+  CRFLUX_BATCH_INLINE void powLane(const double* __restrict x, const double* __restrict y,
+                      double* __restrict z){
+    double l[lanes];
+    logLane(x, l);
+    for (int j = 0; j < lanes; j++){ l[j] *= y[j]; }
+    expLane(l, z);
+  }
+
+  // Copies m <= lanes elements of x into a lane, padded with 1; the
+  // lanes are local, so the output of a function may be its input
+  inline void load(int m, const double* x, double* lane){
+    if (m == lanes){
+      for (int j = 0; j < lanes; j++){ lane[j] = x[j]; }
+    } else {
+      for (int j = 0; j < lanes; j++){ lane[j] = 1.0; }
+      for (int j = 0; j < m; j++){ lane[j] = x[j]; }
+    }
+  }
+
+  inline void store(int m, const double* lane, double* y){
+    if (m == lanes){
+      for (int j = 0; j < lanes; j++){ y[j] = lane[j]; }
+    } else {
+      for (int j = 0; j < m; j++){ y[j] = lane[j]; }
+    }
+  }
+
+  inline int laneSize(int n, int i){
+    return n-i < lanes ? n-i : lanes;
+  }
+} // End of noname-namespace: private function definitions.
+
+
+CRFLUX_BATCH_TARGETS
+void CrBatchMath::log(int n, const double* x, double* y)
+{
+  double a[lanes], b[lanes];
+  for (int i = 0; i < n; i += lanes){
+    int m = laneSize(n, i);
+    load(m, x+i, a);
+    logLane(a, b);
+    store(m, b, y+i);
+  }
+}
+
+CRFLUX_BATCH_TARGETS
+void CrBatchMath::exp(int n, const double* x, double* y)
+{
+  double a[lanes], b[lanes];
+  for (int i = 0; i < n; i += lanes){
+    int m = laneSize(n, i);
+    load(m, x+i, a);
+    expLane(a, b);
+    store(m, b, y+i);
+  }
+}
+
+CRFLUX_BATCH_TARGETS
+void CrBatchMath::pow(int n, const double* x, const double* y, double* z)
+{
+  double a[lanes], b[lanes], c[lanes];
+  for (int i = 0; i < n; i += lanes){
+    int m = laneSize(n, i);
+    load(m, x+i, a);
+    load(m, y+i, b);
+    powLane(a, b, c);
+    store(m, c, z+i);
+  }
+}
+
+CRFLUX_BATCH_TARGETS
+void CrBatchMath::pow(int n, const double* x, double y, double* z)
+{
+  double a[lanes], b[lanes], c[lanes];
+  for (int j = 0; j < lanes; j++){ b[j] = y; }
+  for (int i = 0; i < n; i += lanes){
+    int m = laneSize(n, i);
+    load(m, x+i, a);
+    powLane(a, b, c);
+    store(m, c, z+i);
+  }
+}
+
+CRFLUX_BATCH_TARGETS
+void CrBatchMath::powerLaw(int n, const double* E, double A, double a, double* f)
+{
+  double b[lanes], c[lanes];
+  for (int i = 0; i < n; i += lanes){
+    int m = laneSize(n, i);
+    load(m, E+i, b);
+    logLane(b, c);
+    for (int j = 0; j < lanes; j++){ c[j] *= -a; }
+    expLane(c, b);
+    for (int j = 0; j < lanes; j++){ b[j] *= A; }
+    store(m, b, f+i);
+  }
+}
+
+CRFLUX_BATCH_TARGETS
+void CrBatchMath::cutoffPowerLaw(int n, const double* E, double A, double a,
+                                 double cut, double b, double* f)
+{
+  // A*E**-a * exp(-(E/cut)**b) = A*exp(-a*log(E) - exp(b*(log(E)-log(cut))))
+  const double logCut = std::log(cut);
+  double x[lanes], l[lanes], q[lanes];
+  for (int i = 0; i < n; i += lanes){
+    int m = laneSize(n, i);
+    load(m, E+i, x);
+    logLane(x, l);
+    for (int j = 0; j < lanes; j++){ x[j] = b*(l[j]-logCut); }
+    expLane(x, q);
+    for (int j = 0; j < lanes; j++){ x[j] = -a*l[j] - q[j]; }
+    expLane(x, q);
+    for (int j = 0; j < lanes; j++){ q[j] *= A; }
+    store(m, q, f+i);
+  }
+}
+
+CRFLUX_BATCH_TARGETS
+void CrBatchMath::powerLawInverse(int n, const double* value, double A, double a,
+                                  double* E)
+{
+  const double c = (-a+1)/A;
+  const double exponent = 1./(-a+1);
+  double x[lanes], l[lanes];
+  for (int i = 0; i < n; i += lanes){
+    int m = laneSize(n, i);
+    load(m, value+i, x);
+    for (int j = 0; j < lanes; j++){ x[j] *= c; }
+    logLane(x, l);
+    for (int j = 0; j < lanes; j++){ l[j] *= exponent; }
+    expLane(l, x);
+    store(m, x, E+i);
+  }
+}
+
+CRFLUX_BATCH_TARGETS
+int CrBatchMath::accept(int n, const double* u, const double* f, const double* g,
+                        int* index)
+{
+  int accepted = 0;
+  bool ok[lanes];
+  for (int i = 0; i < n; i += lanes){
+    int m = laneSize(n, i);
+    if (m == lanes){
+      for (int j = 0; j < lanes; j++){ ok[j] = u[i+j] <= f[i+j]/g[i+j]; }
+    } else {
+      for (int j = 0; j < m; j++){ ok[j] = u[i+j] <= f[i+j]/g[i+j]; }
+    }
+    // the index is written always and kept if accepted
+    for (int j = 0; j < m; j++){
+      index[accepted] = i+j;
+      accepted += ok[j] ? 1 : 0;
+    }
+  }
+  return accepted;
+}
+
+const char* CrBatchMath::instructionSet()
+{
+#ifdef CRFLUX_BATCH_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")){ return "avx512f"; }
+  if (__builtin_cpu_supports("avx2")){ return "avx2"; }
+#endif
+  return "default";
+}
@@ -0,0 +1,138 @@
+/****************************************************************************
+ * CrComponentMix.cxx:
+ ****************************************************************************
+ * Flux-weighted selection among the components (primary, reentrant,
+ * splash, ...) of the entry-point classes CrProton, CrAlpha, CrElectron,
+ * CrPositron, CrGamma, CrNeutron, CrHeavyIon and CrHeavyIonVertical.
+ * The weights are turned into a Walker alias table (CrAliasTable).
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <CLHEP/Random/RandomEngine.h>
+
+#include "CrComponentMix.hh"
+#include "CrSpectrum.hh"
+
+CrComponentMix::CrComponentMix()
+  : m_useSolidAngle(false), m_dirty(true), m_rebuilds(0)
+{
+}
+
+CrComponentMix::~CrComponentMix()
+{
+}
+
+void CrComponentMix::setComponents(const std::vector<CrSpectrum*>& components,
+                                   bool useSolidAngle)
+{
+  m_components = components;
+  m_useSolidAngle = useSolidAngle;
+  m_dirty = true;
+}
+
+void CrComponentMix::invalidate()
+{
+  m_dirty = true;
+}
+
+unsigned long CrComponentMix::rebuilds() const
+{
+  return m_rebuilds;
+}
+
+// The fluxes follow the position, time, ... of the components, which
+// their epochs count
+void CrComponentMix::update()
+{
+  bool changed = m_dirty;
+  for (unsigned int k = 0; k < m_components.size() && !changed; k++){
+    changed = m_components[k]->epoch() != m_epochs[k];
+  }
+  if (changed){ rebuild(); }
+}
+
+// Build the alias table from the current weights
+void CrComponentMix::rebuild()
+{
+  unsigned int n = m_components.size();
+  std::vector<double> weight(n);
+  m_epochs.resize(n);
+  for (unsigned int k = 0; k < n; k++){
+    m_epochs[k] = m_components[k]->epoch();
+    // a single component needs no weight
+    if (n < 2){ continue; }
+    weight[k] = m_components[k]->cachedFlux();
+    if (m_useSolidAngle){ weight[k] *= m_components[k]->solidAngle(); }
+  }
+  m_table.build(weight);
+  m_dirty = false;
+  m_rebuilds++;
+}
+
+// Gives back the index of the component for a uniform random number r
+unsigned int CrComponentMix::index(double r)
+{
+  update();
+  return m_table.index(r);
+}
+
+// Gives back a component in the ratio of the weights
+CrSpectrum* CrComponentMix::select(CLHEP::HepRandomEngine* engine)
+{
+  if (m_components.empty()){ return 0; }
+  // the random number is drawn even for a single component, as it
+  // always was, so that the particles of a seed stay the same
+  double r = engine->flat();
+  if (m_components.size() == 1){ return m_components.front(); }
+  return m_components[index(r)];
+}
+
+// Fill n particles.
+// The component of every particle is selected first, then each
+// component fills all of its particles in one block, and the blocks
+// are scattered back so that the order of the components stays random.
+void CrComponentMix::sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                                 double* energy, double* cosTheta, double* phi,
+                                 const CrSpectrum** source, unsigned int* ion)
+{
+  if (n <= 0 || m_components.empty()){ return; }
+
+  // select the component of each particle
+  std::vector<unsigned int> which(n, 0);
+  std::vector<int> count(m_components.size(), 0);
+  if (m_components.size() > 1){
+    std::vector<double> rnum(n);
+    engine->flatArray(n, &rnum[0]);
+    update();
+    for (int i = 0; i < n; i++){ which[i] = m_table.index(rnum[i]); }
+  }
+  for (int i = 0; i < n; i++){ count[which[i]]++; }
+
+  // fill the particles of each component and put them in place
+  std::vector<double> e, c, p;
+  std::vector<unsigned int> z;
+  for (unsigned int k = 0; k < m_components.size(); k++){
+    if (count[k] == 0){ continue; }
+    e.resize(count[k]);
+    c.resize(count[k]);
+    p.resize(count[k]);
+    if (ion){
+      z.resize(count[k]);
+      m_components[k]->sampleBlock(engine, count[k], &e[0], &c[0], &p[0], &z[0]);
+    } else {
+      m_components[k]->sampleBlock(engine, count[k], &e[0], &c[0], &p[0]);
+    }
+    int j = 0;
+    for (int i = 0; i < n; i++){
+      if (which[i] != k){ continue; }
+      energy[i] = e[j];
+      cosTheta[i] = c[j];
+      phi[i] = p[j];
+      if (source){ source[i] = m_components[k]; }
+      if (ion){ ion[i] = z[j]; }
+      j++;
+    }
+  }
+}
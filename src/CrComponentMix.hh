@@ -0,0 +1,82 @@
+/**
+ * CrComponentMix:
+ *  Selects one of the components of an entry-point class
+ *  (CrProton, CrAlpha, ...) in the ratio of their flux.
+ */
+
+//$Header$
+
+#ifndef CrComponentMix_H
+#define CrComponentMix_H
+
+#include <vector>
+#include "CrAliasTable.hh"
+
+class CrSpectrum;
+namespace CLHEP {class HepRandomEngine;}
+
+/** @class CrComponentMix
+ *  @brief flux-weighted choice among the components of a source
+ *
+ * The weight of a component is flux()*solidAngle(), or flux() only,
+ * as chosen in setComponents().  The weights are kept in a Walker
+ * alias table (CrAliasTable), so a component costs one random number
+ * and no search.
+ * The table is built on the first selection after the epoch of a
+ * component has changed (see CrSpectrum::epoch(); or after
+ * invalidate()), from CrSpectrum::cachedFlux(), so the fluxes are
+ * evaluated once per position and not once per particle.
+ * The components are not owned by the mixture.
+ */
+class CrComponentMix
+{
+public:
+  CrComponentMix();
+  ~CrComponentMix();
+
+  /// Set the components and how they are weighted
+  void setComponents(const std::vector<CrSpectrum*>& components,
+                     bool useSolidAngle);
+
+  /// Force a rebuild of the table at the next selection; to be called
+  /// when the flux of a component changes within an epoch.
+  void invalidate();
+
+  /// Gives back a component in the ratio of the weights.  It draws
+  /// one random number, also when there is a single component.
+  CrSpectrum* select(CLHEP::HepRandomEngine* engine);
+
+  /// Gives back the index of the component for a uniform random number r
+  unsigned int index(double r);
+
+  /// Fill n particles: kinetic energy [GeV], cos(theta) and phi [rad].
+  /// The components of all the particles are chosen first, with one
+  /// random number each if there are several, then each component
+  /// fills its share with CrSpectrum::sampleBlock().
+  /// source[i], if given, is set to the component of particle i, and
+  /// ion[i] to the index in CrIonSpecies of its heavy ion (see
+  /// CrSpectrum::sampleBlock()).
+  void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                   double* energy, double* cosTheta, double* phi,
+                   const CrSpectrum** source=0, unsigned int* ion=0);
+
+  /// Gives back the number of times the table has been built
+  unsigned long rebuilds() const;
+
+private:
+  // Rebuild the alias table if it is out of date
+  void update();
+
+  // Build the alias table from the current weights
+  void rebuild();
+
+  std::vector<CrSpectrum*> m_components;
+  bool m_useSolidAngle;
+  bool m_dirty; ///< the table must be rebuilt before use
+  unsigned long m_rebuilds;
+
+  CrAliasTable m_table;
+  std::vector<unsigned long> m_epochs; ///< of the components in the table
+};
+
+#endif // CrComponentMix_H
@@ -15,6 +15,9 @@
 
 #include <cmath>
 #include <iostream>
+#include <sstream>
+
+#include "CrDiagnostics.hh"
 
 typedef double G4double;
 
@@ -147,7 +150,13 @@ double CrCoordinateTransfer::interpolate(double lat, double lon, const double *
 
 	if(fabs(lat) > 30)
 	{
-		std::cout << "Warning -- CrCoordinateTransfer::interpolate -- Latitude is out of range."  << std::endl;
+		static CrDiagnostics::Message& message =
+			CrDiagnostics::message("CrCoordinateTransfer: latitude out of range");
+		if (CrDiagnostics::report(message)){
+			std::ostringstream text;
+			text << "Warning -- CrCoordinateTransfer::interpolate -- Latitude " << lat << " is out of range.";
+			CrDiagnostics::print(message, text.str());
+		}
 	}
 
     return array[ilat   + 13*ilon    ] * (1.-a) * (1.-b) +
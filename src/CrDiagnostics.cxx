@@ -0,0 +1,123 @@
+/****************************************************************************
+ * CrDiagnostics.cxx:
+ ****************************************************************************
+ * The messages live in a map which is never shrunk, so the references
+ * kept by the components (in static variables) stay valid.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+#include "CrDiagnostics.hh"
+
+namespace {
+  std::mutex& registryMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  std::map<std::string, CrDiagnostics::Message>& registry()
+  {
+    static std::map<std::string, CrDiagnostics::Message> messages;
+    return messages;
+  }
+
+  std::atomic<long> s_limit(1);
+  std::atomic<std::ostream*> s_stream(&std::cout);
+
+  // Gives back true if the count is limit times a power of 10
+  bool reminder(unsigned long count, long limit)
+  {
+    unsigned long step = limit > 0 ? limit : 1;
+    if (count % step != 0){ return false; }
+    count /= step;
+    while (count % 10 == 0){ count /= 10; }
+    return count == 1;
+  }
+}
+
+CrDiagnostics::Message& CrDiagnostics::message(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  Message& m = registry()[name];
+  m.name = name;
+  return m;
+}
+
+bool CrDiagnostics::report(Message& message)
+{
+  unsigned long count = message.count.fetch_add(1, std::memory_order_relaxed) + 1;
+  long limit = s_limit;
+  if (limit < 0){ return true; }
+  if (limit == 0 || s_stream.load() == 0){ return false; }
+  return long(count) <= limit || reminder(count, limit);
+}
+
+void CrDiagnostics::print(const Message& message, const std::string& text)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  std::ostream* out = s_stream;
+  if (out == 0){ return; }
+  unsigned long count = message.count;
+  long limit = s_limit;
+  *out << text;
+  if (limit >= 0 && long(count) == limit){
+    *out << " (further ones are only counted)";
+  } else if (limit >= 0 && long(count) > limit){
+    *out << " (" << count << " times so far)";
+  }
+  *out << std::endl;
+}
+
+std::vector<const CrDiagnostics::Message*> CrDiagnostics::messages()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  std::vector<const Message*> list;
+  std::map<std::string, Message>::const_iterator it;
+  for (it = registry().begin(); it != registry().end(); ++it){
+    list.push_back(&it->second);
+  }
+  return list;
+}
+
+void CrDiagnostics::reset()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  std::map<std::string, Message>::iterator it;
+  for (it = registry().begin(); it != registry().end(); ++it){
+    it->second.count = 0;
+  }
+}
+
+void CrDiagnostics::summary(std::ostream& out)
+{
+  std::vector<const Message*> list = messages();
+  for (unsigned int i = 0; i < list.size(); i++){
+    unsigned long count = list[i]->count;
+    if (count == 0){ continue; }
+    out << std::left << std::setw(64) << list[i]->name << std::right
+        << " " << std::setw(12) << count << std::endl;
+  }
+}
+
+void CrDiagnostics::setLimit(long limit)
+{
+  s_limit = limit;
+}
+
+long CrDiagnostics::limit()
+{
+  return s_limit;
+}
+
+void CrDiagnostics::setStream(std::ostream* out)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  s_stream = out;
+}
@@ -0,0 +1,75 @@
+/**
+ * CrDiagnostics:
+ *  Counted, rate-limited warnings of the components, for conditions
+ *  which may repeat at every position update or every particle.
+ */
+
+//$Header$
+
+#ifndef CrDiagnostics_H
+#define CrDiagnostics_H
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** @class CrDiagnostics
+ *  @brief warnings counted per kind, printed the first few times
+ *
+ * Each kind of warning (e.g. a cutoff rigidity restricted to 0.5 GV)
+ * has a Message, named after the component and the condition, made
+ * on its first use.  report() counts every occurrence; only the first
+ * limit() occurrences of a kind are printed, then one reminder with
+ * the count at 10, 100, 1000, ... times the limit.  summary() gives
+ * the count of every kind, and CRfluxSvc prints it at finalize.
+ *
+ * The text of a warning is made only if it is printed:
+ * @verbatum
+ *   static CrDiagnostics::Message& low = CrDiagnostics::message("...");
+ *   if (CrDiagnostics::report(low)){
+ *     std::ostringstream text; ...
+ *     CrDiagnostics::print(low, text.str());
+ *   }
+ * @endverbatum
+ * The counters are atomic and the lines are printed under a lock, so
+ * the components of several threads may report.
+ */
+class CrDiagnostics
+{
+public:
+  struct Message {
+    Message() : count(0) {}
+    std::string name;
+    std::atomic<unsigned long> count;
+  };
+
+  /// Gives back the message of that name, made at the first call
+  static Message& message(const std::string& name);
+
+  /// Count an occurrence; gives back true if it is to be printed
+  static bool report(Message& message);
+
+  /// Print the text of an occurrence with the count when the
+  /// following ones are no longer printed
+  static void print(const Message& message, const std::string& text);
+
+  /// Gives back all the messages, sorted by name
+  static std::vector<const Message*> messages();
+
+  /// Set all the counts to 0
+  static void reset();
+
+  /// Print one line per kind that occurred, with its count
+  static void summary(std::ostream& out);
+
+  /// Number of occurrences of a kind printed (default 1); 0 prints
+  /// none, a negative limit all of them
+  static void setLimit(long limit);
+  static long limit();
+
+  /// Stream of the warnings (default std::cout); 0 for none
+  static void setStream(std::ostream* out);
+};
+
+#endif // CrDiagnostics_H
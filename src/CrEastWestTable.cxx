@@ -0,0 +1,151 @@
+/****************************************************************************
+ * CrEastWestTable.cxx:
+ ****************************************************************************
+ * EW_dir drew the azimuth uniformly until one was accepted, computing
+ * the cutoff of that direction and of the west horizon at each trial.
+ * Near the cutoff most trials were rejected.  The bounds tabulated
+ * here follow the azimuth distribution closely, so that less than
+ * one trial in ten is rejected, each costing one cutoff.
+ *
+ * Interpolating tabulated quantiles of phi between nodes of (q, x),
+ * without the accept step, was tried first: it is off by up to 1% of
+ * the distribution where the cutoff of the east horizon comes close
+ * to the rigidity, which a KS test of 1e6 particles sees.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+#include <CLHEP/Random/RandomEngine.h>
+
+#include "CrEastWestTable.hh"
+#include "CrSamplingCounters.hh"
+
+namespace {
+  // cells in q = cos(magLat)^3*sin(theta), in [0,1]
+  const int nQ = 16;
+  // cells in log(x), x = rigidity/cutoff, between xMin and xMax; the
+  // cell 0 takes x below xMin, and above xMax the bound is 1
+  const int nX = 96;
+  const double logXMin = log(0.03);
+  const double logXMax = log(60.);
+  // bins in phi within [0,pi]
+  const int nPhi = 32;
+
+  // cutoff in the direction (q, cos(phi)) relative to the vertical one
+  double cutOffRatio(double q, double cosPhi)
+  {
+    double tmp = 1+sqrt(1-q*cosPhi);
+    return 4.0/(tmp*tmp);
+  }
+
+  // the probability of acceptance of EW_dirRejection, 1/(1+(x/r)^coeff),
+  // relative to that of the west horizon, written with s = x^-coeff:
+  //   (s + west^-coeff)/(s + r^-coeff)
+  // It decreases with r, increases with west and is monotonic in s.
+  double ratioToWest(double s, double westPower, double r, double coeff)
+  {
+    if (s == HUGE_VAL){ return 1.; } // far above the cutoff
+    return (s+westPower)/(s+pow(r, -coeff));
+  }
+}
+
+const CrEastWestTable& CrEastWestTable::instance(double coeff)
+{
+  static std::mutex mutex;
+  static std::map<double, CrEastWestTable*> tables;
+  std::lock_guard<std::mutex> lock(mutex);
+  CrEastWestTable*& table = tables[coeff];
+  if (table == 0){ table = new CrEastWestTable(coeff); }
+  return *table;
+}
+
+CrEastWestTable::CrEastWestTable(double coeff)
+  : m_coeff(coeff), m_bound(nQ*(nX+1)*nPhi), m_cumulative(nQ*(nX+1)*(nPhi+1))
+{
+  for (int iq = 0; iq < nQ; iq++){
+    double q0 = double(iq)/nQ;
+    double q1 = double(iq+1)/nQ;
+    // the cutoff of the west horizon decreases with q
+    double westPower = pow(cutOffRatio(q0, -1.), -coeff);
+
+    for (int ix = 0; ix <= nX; ix++){
+      // s = x^-coeff at both ends of the cell; the cell 0 reaches x=0
+      double s0 = ix==0 ? 0 : exp(-coeff*(logXMin + (logXMax-logXMin)*(ix-1)/nX));
+      double s1 = exp(-coeff*(logXMin + (logXMax-logXMin)*ix/nX));
+
+      int cell = iq*(nX+1)+ix;
+      float* bound = &m_bound[cell*nPhi];
+      float* cumulative = &m_cumulative[cell*(nPhi+1)];
+      double sum = 0;
+      cumulative[0] = 0;
+      for (int j = 0; j < nPhi; j++){
+        // the lowest cutoff of the bin is at its upper end in phi,
+        // at q0 for cos(phi)>=0 and at q1 below
+        double cosPhi = cos(M_PI*(j+1)/nPhi);
+        double r = cutOffRatio(cosPhi >= 0 ? q0 : q1, cosPhi);
+        double b0 = ratioToWest(s0, westPower, r, coeff);
+        double b1 = ratioToWest(s1, westPower, r, coeff);
+        // a little above, for the rounding to float
+        bound[j] = float((b0 > b1 ? b0 : b1)*(1+1e-5));
+        sum += bound[j];
+        cumulative[j+1] = float(sum);
+      }
+      for (int j = 1; j < nPhi; j++){ cumulative[j] = float(cumulative[j]/sum); }
+      cumulative[nPhi] = 1;
+    }
+  }
+}
+
+// Gives back phi [rad] for (q, x), drawing from engine
+double CrEastWestTable::sample(double q, double x, CLHEP::HepRandomEngine* engine) const
+{
+  CRFLUX_COUNTER(counter, "CrEastWestTable phi");
+  if (q < 0){ q = 0; }
+  int iq = int(q*nQ);
+  if (iq > nQ-1){ iq = nQ-1; }
+
+  double s = pow(x, -m_coeff);
+  double westPower = pow(cutOffRatio(q, -1.), -m_coeff);
+
+  // the bound of the cell, or 1 above xMax
+  const float* bound = 0;
+  const float* cumulative = 0;
+  double logX = x>0 ? log(x) : -HUGE_VAL;
+  if (logX < logXMax){
+    int ix = logX < logXMin ? 0 : 1+int((logX-logXMin)/(logXMax-logXMin)*nX);
+    if (ix > nX){ ix = nX; }
+    int cell = iq*(nX+1)+ix;
+    bound = &m_bound[cell*nPhi];
+    cumulative = &m_cumulative[cell*(nPhi+1)];
+  }
+
+  while(1){
+    // the lower half of r gives phi in [0,pi], the upper one 2pi-phi
+    double r = engine->flat();
+    bool upper = r >= 0.5;
+    r = upper ? 2*r-1 : 2*r;
+
+    double phi, b;
+    if (bound == 0){
+      phi = M_PI*r;
+      b = 1;
+    } else {
+      // bin j with cumulative[j] <= r < cumulative[j+1]
+      int j = std::upper_bound(cumulative+1, cumulative+nPhi, r) - (cumulative+1);
+      double f = (r-cumulative[j])/(cumulative[j+1]-cumulative[j]);
+      phi = M_PI*(j+f)/nPhi;
+      b = bound[j];
+    }
+    CRFLUX_COUNT_ATTEMPT(counter, 2);
+    if (engine->flat()*b <= ratioToWest(s, westPower, cutOffRatio(q, cos(phi)), m_coeff)){
+      CRFLUX_COUNT_ACCEPT(counter);
+      return upper ? 2*M_PI-phi : phi;
+    }
+  }
+}
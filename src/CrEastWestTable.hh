@@ -0,0 +1,54 @@
+/**
+ * CrEastWestTable:
+ *  Tabulated bounds of the azimuth distribution of the East-West
+ *  effect, from which CrSpectrum::EW_dir draws phi.
+ */
+
+//$Header$
+
+#ifndef CrEastWestTable_H
+#define CrEastWestTable_H
+
+#include <vector>
+
+namespace CLHEP {class HepRandomEngine;}
+
+/** @class CrEastWestTable
+ *  @brief azimuth of the East-West effect from tabulated bounds
+ *
+ * CrSpectrum::EW_dir accepts an azimuth phi with the probability
+ *   1/(1+(rig/cor(theta,phi))^coeff)
+ * where, with the Stoermer formula, the cutoff in the direction
+ * (theta, phi) is cor(theta,phi) = cor*4/(1+sqrt(1-q*cos(phi)))^2,
+ * cor the vertical cutoff and q = cos(magLat)^3*sin(theta).
+ * The azimuth distribution thus depends on q and x = rig/cor only
+ * (and on coeff, fixed for a species), not on the position as such.
+ *
+ * The distribution is symmetric about phi=pi and grows with phi in
+ * [0,pi].  For cells of (q, log(x)) the table holds an upper bound of
+ * the density in bins of phi and its cumulative sum: phi is drawn by
+ * inversion of the bound and accepted with the ratio of the density
+ * to the bound, which gives exactly the particles of the accept/reject
+ * loop in phi but with few rejections.  A table is made once per coeff.
+ */
+class CrEastWestTable
+{
+public:
+  /// Gives back the table of coeff, made at the first call
+  static const CrEastWestTable& instance(double coeff);
+
+  explicit CrEastWestTable(double coeff);
+
+  /// Gives back phi in [0,2pi) [rad] for q = cos(magLat)^3*sin(theta)
+  /// and x = rigidity/(vertical cutoff rigidity)
+  double sample(double q, double x, CLHEP::HepRandomEngine* engine) const;
+
+  double coeff() const { return m_coeff; }
+
+private:
+  double m_coeff;
+  std::vector<float> m_bound;      ///< [cell][bin] bound of the density
+  std::vector<float> m_cumulative; ///< [cell][bin] normalised sum of the bounds
+};
+
+#endif // CrEastWestTable_H
@@ -31,7 +31,6 @@
 
 #include <cstdlib>
 #include <cmath>
-#include <map>
 #include <vector>
 
 // CLHEP
@@ -70,6 +69,8 @@ CrElectron::CrElectron(const std::string& paramstring)
      };
   };	   
 
+  m_mix.setComponents(m_subComponents, m_subComponents.size() > 1);
+
   m_engine = CLHEP::HepRandom::getTheEngine(); //new HepJamesRandom;
 }
 
@@ -84,37 +85,18 @@ CrElectron::~CrElectron()
 }
 
 
-// Gives back component in the ratio of the flux
-CrSpectrum* CrElectron::selectComponent()
+// Set the random engine of the source
+void CrElectron::setEngine(CLHEP::HepRandomEngine* engine)
 {
-  std::map<CrSpectrum*,G4double> integ_flux;
-  G4double                       total_flux = 0;
-  std::vector<CrSpectrum*>::iterator i;
-
-  // calculate the total flux
-  if(m_subComponents.size() > 1)
-  {
-     for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-        total_flux += (*i)->solidAngle()*(*i)->flux();
-        integ_flux[*i] = total_flux; // Don't divide by 4 pi it's not needed here
-     }
-  }
-  else
-  {
-     for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-        total_flux += (*i)->flux();
-        integ_flux[*i] = total_flux;
-     }
-  }
-  // select component based on the flux
-  G4double  rnum = m_engine->flat() * total_flux;
-  for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-    if (integ_flux[*i] >= rnum) { break; }
-  }
+  m_engine = engine;
+}
 
-  m_component = *i;
 
-  return *i;
+// Gives back component in the ratio of the flux
+CrSpectrum* CrElectron::selectComponent()
+{
+  m_component = m_mix.select(m_engine);
+  return m_component;
 }
 
 
@@ -134,6 +116,13 @@ std::pair<G4double,G4double> CrElectron::dir(G4double energy)
   return m_component->dir(energy, m_engine);
 }
 
+// Fill n particles at once
+void CrElectron::sampleBlock(int n, G4double* energy, G4double* cosTheta,
+                            G4double* phi, const CrSpectrum** source)
+{
+  m_mix.sampleBlock(m_engine, n, energy, cosTheta, phi, source);
+}
+
 
 // Gives back the total flux (summation of each component's flux)
 G4double CrElectron::flux(G4double /* time */) const
@@ -144,14 +133,14 @@ G4double CrElectron::flux(G4double /* time */) const
   if(m_subComponents.size() > 1)
   {
      for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-        total_flux += (*i)->solidAngle()*(*i)->flux();
+        total_flux += (*i)->solidAngle()*(*i)->cachedFlux();
      }
      return total_flux / (4 * M_PI);
   }
   else
   {
      for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-        total_flux += (*i)->flux();
+        total_flux += (*i)->cachedFlux();
         //    cout << "flux of this component = " << (*i)->flux() << endl;
      }
      return total_flux;
@@ -177,7 +166,7 @@ void CrElectron::dump()
   std::vector<CrSpectrum*>::const_iterator i;
   for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
     std::cout << "title: " << (*i)->title() << std::endl;
-    std::cout << " flux(c/s/m^2/sr)= " << (*i)->flux() << std::endl;
+    std::cout << " flux(c/s/m^2/sr)= " << (*i)->cachedFlux() << std::endl;
     std::cout << " geographic latitude/longitude(deg)= " 
          << (*i)->latitude() << " " << (*i)->longitude() << std::endl;
     std::cout << " geomagnetic latitude/longitude(deg)= " 
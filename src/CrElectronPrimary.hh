@@ -8,50 +8,28 @@
 #ifndef CrElectronPrimary_H
 #define CrElectronPrimary_H
 
-#include <utility>
-#include <string>
-
-#include "CrSpectrum.hh"
-
-// Forward declaration:
-class CLHEP::HepRandomEngine;
+#include "CrPrimarySpectrum.hh"
+
+/// Constants of the primary electrons, see CrPrimarySpectrum
+struct CrElectronSpecies {
+  static constexpr double restE = 5.11e-4; ///< [GeV]
+  static constexpr double charge = 1.0;
+  static constexpr double normalization = 6.5e-1; ///< A of org_spec
+  static constexpr double index = 3.3; ///< a of org_spec
+  static constexpr double cutoffIndex = -6.0;
+  static constexpr bool relativistic = true;
+  static constexpr double highE = 1000.0; ///< [GeV]
+  static constexpr double eastWestCoeff = -6.0;
+  static constexpr double polarity = -1.0;
+  static const char* particle() { return "e-"; }
+  static const char* title() { return "CrElectronPrimary"; }
+};
 
-class CrElectronPrimary : public CrSpectrum
+class CrElectronPrimary : public CrPrimaryComponent<CrElectronSpecies>
 {
 public:
   CrElectronPrimary();
   ~CrElectronPrimary();
-  
-  // Set satellite position, altitude and observation time and
-  // calculate energies related to COR.
-  // These energies will be used to generate particles.
-  void setPosition(double latitude, double longitude);
-  void setPosition(double latitude, double longitude, double time);
-  void setPosition(double latitude, double longitude, double time, double altitude);
-
-  // Set geomagnetic cutoff rigidity and calculate the energies related.
-  // These energies are used to generate the particle. 
-  void setCutOffRigidity(double cor);
-
-  // Gives back particle direction in (cos(theta), phi)
-  std::pair<double,double> dir(double energy, CLHEP::HepRandomEngine* engine) const;
-
-  // Gives back particle energy
-  double energySrc(CLHEP::HepRandomEngine* engine) const;
-
-  // flux() returns the value averaged over the region from which
-  // the particle is coming from and the unit is [c/s/m^2/sr]
-  double flux() const;
-
-  // Gives back solid angle from which particle comes
-  double solidAngle() const;
-
-  // Gives back particle name
-  const char* particleName() const;
-
-  // Gives back the name of the component
-  std::string title() const;
-
 };
-#endif // CrElectronPrimary_H
 
+#endif // CrElectronPrimary_H
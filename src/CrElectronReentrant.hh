@@ -12,16 +12,10 @@
 #include <string>
 
 #include "CrSpectrum.hh"
+#include "CrLatitudeBinnedModel.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
-class CrElectronReentrant_0001;
-class CrElectronReentrant_0102;
-class CrElectronReentrant_0203;
-class CrElectronReentrant_0304;
-class CrElectronReentrant_0405;
-class CrElectronReentrant_0506;
-class CrElectronReentrant_0611;
 
 class CrElectronReentrant : public CrSpectrum
 {
@@ -48,16 +42,12 @@ public:
   // Gives back the name of the component
   std::string title() const;
 
-  // cr particle generator sorted in theta_M
-private:
-  CrElectronReentrant_0001* crElectronReentrant_0001;
-  CrElectronReentrant_0102* crElectronReentrant_0102;
-  CrElectronReentrant_0203* crElectronReentrant_0203;
-  CrElectronReentrant_0304* crElectronReentrant_0304;
-  CrElectronReentrant_0405* crElectronReentrant_0405;
-  CrElectronReentrant_0506* crElectronReentrant_0506;
-  CrElectronReentrant_0611* crElectronReentrant_0611;
+  // Gives back the table of the model
+  const CrLatitudeBinnedModel& model() const;
 
+  // spectra sorted in theta_M
+private:
+  CrLatitudeBinnedModel m_model;
 
 };
 #endif // CrElectronReentrant_H
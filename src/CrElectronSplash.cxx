@@ -58,7 +58,7 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrElectronSplash.hh"
-#include "CrElectronSubSplash.hh"
+#include "CrLeptonSecondaryModel.hh"
 
 
 typedef double G4double;
@@ -109,25 +109,13 @@ namespace {
 
 CrElectronSplash::CrElectronSplash():CrSpectrum()
 {
-  crElectronSplash_0001 = new CrElectronSplash_0001();
-  crElectronSplash_0102 = new CrElectronSplash_0102();
-  crElectronSplash_0203 = new CrElectronSplash_0203();
-  crElectronSplash_0304 = new CrElectronSplash_0304();
-  crElectronSplash_0405 = new CrElectronSplash_0405();
-  crElectronSplash_0506 = new CrElectronSplash_0506();
-  crElectronSplash_0611 = new CrElectronSplash_0611();
+  crLeptonSecondaryModel(m_model, false);
 }
 
 
 CrElectronSplash::~CrElectronSplash()
 {
-  delete crElectronSplash_0001;
-  delete crElectronSplash_0102;
-  delete crElectronSplash_0203;
-  delete crElectronSplash_0304;
-  delete crElectronSplash_0405;
-  delete crElectronSplash_0506;
-  delete crElectronSplash_0611;
+  ;
 }
 
 
@@ -150,61 +138,7 @@ std::pair<G4double,G4double> CrElectronSplash::dir
 // Gives back particle energy
 G4double CrElectronSplash::energySrc(CLHEP::HepRandomEngine* engine) const
 {
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.05){
-    return crElectronSplash_0001->energy(engine);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.05 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.05;
-    r2 = 0.15-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crElectronSplash_0001->energy(engine);
-    } else {
-      return crElectronSplash_0102->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crElectronSplash_0102->energy(engine);
-    } else {
-      return crElectronSplash_0203->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crElectronSplash_0203->energy(engine);
-    } else {
-      return crElectronSplash_0304->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crElectronSplash_0304->energy(engine);
-    } else {
-      return crElectronSplash_0405->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crElectronSplash_0405->energy(engine);
-    } else {
-      return crElectronSplash_0506->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crElectronSplash_0506->energy(engine);
-    } else {
-      return crElectronSplash_0611->energy(engine);
-    }
-  } else{
-      return crElectronSplash_0611->energy(engine);
-  }
-
+  return m_model.sampleEnergy(fabs(m_geomagneticLatitude)*M_PI/180.0, engine);
 }
 
 
@@ -216,47 +150,16 @@ G4double CrElectronSplash::energySrc(CLHEP::HepRandomEngine* engine) const
 G4double CrElectronSplash::flux() const
 {
   // energy integrated vertically downward flux, [c/s/m^2/sr]
-  G4double downwardFlux; 
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.05){
-    downwardFlux = crElectronSplash_0001->downwardFlux();
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.05 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.05;
-    r2 = 0.15-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crElectronSplash_0001->downwardFlux()
-             +r1*crElectronSplash_0102->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crElectronSplash_0102->downwardFlux()
-             +r1*crElectronSplash_0203->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crElectronSplash_0203->downwardFlux()
-             +r1*crElectronSplash_0304->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crElectronSplash_0304->downwardFlux()
-             +r1*crElectronSplash_0405->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crElectronSplash_0405->downwardFlux()
-             +r1*crElectronSplash_0506->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crElectronSplash_0506->downwardFlux()
-             +r1*crElectronSplash_0611->downwardFlux() )/(r1+r2);
-  } else{
-    downwardFlux = crElectronSplash_0611->downwardFlux();
-  }
+  G4double downwardFlux = m_model.flux(fabs(m_geomagneticLatitude)*M_PI/180.0);
 
   return m_normalization*downwardFlux; // [c/s/m^2/sr]
+}
 
 
+// Gives back the table of the model
+const CrLatitudeBinnedModel& CrElectronSplash::model() const
+{
+  return m_model;
 }
 
 
@@ -12,16 +12,10 @@
 #include <string>
 
 #include "CrSpectrum.hh"
+#include "CrLatitudeBinnedModel.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
-class CrElectronSplash_0001;
-class CrElectronSplash_0102;
-class CrElectronSplash_0203;
-class CrElectronSplash_0304;
-class CrElectronSplash_0405;
-class CrElectronSplash_0506;
-class CrElectronSplash_0611;
 
 class CrElectronSplash : public CrSpectrum
 {
@@ -48,16 +42,12 @@ public:
   // Gives back the name of the component
   std::string title() const;
 
-  // cr particle generator sorted in theta_M
-private:
-  CrElectronSplash_0001* crElectronSplash_0001;
-  CrElectronSplash_0102* crElectronSplash_0102;
-  CrElectronSplash_0203* crElectronSplash_0203;
-  CrElectronSplash_0304* crElectronSplash_0304;
-  CrElectronSplash_0405* crElectronSplash_0405;
-  CrElectronSplash_0506* crElectronSplash_0506;
-  CrElectronSplash_0611* crElectronSplash_0611;
+  // Gives back the table of the model
+  const CrLatitudeBinnedModel& model() const;
 
+  // spectra sorted in theta_M
+private:
+  CrLatitudeBinnedModel m_model;
 
 };
 #endif // CrElectronSplash_H
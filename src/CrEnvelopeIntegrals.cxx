@@ -0,0 +1,56 @@
+/****************************************************************************
+ * CrEnvelopeIntegrals.cxx:
+ ****************************************************************************
+ * The areas are summed in the order of the pieces, as the components
+ * summed envelope1_area + envelope2_area + ..., so the shares are the
+ * same numbers as those computed per particle before.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include "CrEnvelopeIntegrals.hh"
+
+CrEnvelopeIntegrals::CrEnvelopeIntegrals()
+  : m_lowE(0), m_highE(0), m_pieces(0), m_line(false), m_area(0)
+{
+  ;
+}
+
+void CrEnvelopeIntegrals::set(int n, const double* low, const double* high,
+                              double line)
+{
+  if (n > maxPieces){ n = maxPieces; }
+  m_pieces = n;
+  m_area = 0;
+  for (int k = 0; k < n; k++){
+    m_low[k] = low[k];
+    m_high[k] = high[k];
+    m_area = k==0 ? high[k]-low[k] : m_area + (high[k]-low[k]);
+    m_share[k] = m_area;
+  }
+  m_line = line != 0;
+  if (m_line){ m_area = m_area + line; }
+  for (int k = 0; k < n; k++){
+    m_share[k] = m_share[k]/m_area;
+  }
+}
+
+int CrEnvelopeIntegrals::piece(double r) const
+{
+  int k = 0;
+  while (k < m_pieces && !(r <= m_share[k])){ k++; }
+  if (!m_line && k == m_pieces){ k = m_pieces-1; }
+  return k;
+}
+
+void CrEnvelopeIntegrals::setRange(double lowE, double highE)
+{
+  m_lowE = lowE;
+  m_highE = highE;
+}
+
+bool CrEnvelopeIntegrals::sameRange(double lowE, double highE) const
+{
+  return lowE == m_lowE && highE == m_highE;
+}
@@ -0,0 +1,64 @@
+/**
+ * CrEnvelopeIntegrals:
+ *  Integrals of the pieces of a piecewise envelope function, kept so
+ *  that sampling a particle needs none of them.
+ */
+
+//$Header$
+
+#ifndef CrEnvelopeIntegrals_H
+#define CrEnvelopeIntegrals_H
+
+/** @class CrEnvelopeIntegrals
+ *  @brief integrals and shares of the pieces of an envelope function
+ *
+ * A spectrum made of n pieces, each with an integral and its inverse
+ * in closed form, is sampled by choosing a piece in proportion to its
+ * area and inverting the integral of that piece.  The integrals at the
+ * ends of the pieces depend on the parameters of the spectrum only,
+ * so they are set once per parameters instead of once per particle.
+ * An emission line may follow the pieces.  The shares are computed
+ * with the expressions the components used, so the same particles
+ * come out.
+ */
+class CrEnvelopeIntegrals
+{
+public:
+  enum { maxPieces = 4 };
+
+  CrEnvelopeIntegrals();
+
+  /// Set the integrals low[k] and high[k] at the ends of n pieces and
+  /// the area of a line after them (0 for none)
+  void set(int n, const double* low, const double* high, double line=0);
+
+  /// true once set() was called
+  bool valid() const { return m_pieces > 0; }
+
+  /// Gives back the piece for a flat random number r: the first k with
+  /// r <= share of the pieces 0..k, or pieces() for the line
+  int piece(double r) const;
+
+  int pieces() const { return m_pieces; }
+  double low(int k) const { return m_low[k]; }
+  double high(int k) const { return m_high[k]; }
+  /// Gives back the area of piece k
+  double area(int k) const { return m_high[k]-m_low[k]; }
+  /// Gives back the area of all the pieces and the line
+  double area() const { return m_area; }
+
+  /// Energy range [GeV] the integrals belong to, for the owner to
+  /// know when to set them again
+  void setRange(double lowE, double highE);
+  bool sameRange(double lowE, double highE) const;
+
+private:
+  double m_lowE, m_highE;
+  int m_pieces;
+  double m_low[maxPieces], m_high[maxPieces];
+  double m_share[maxPieces];
+  bool m_line;
+  double m_area;
+};
+
+#endif // CrEnvelopeIntegrals_H
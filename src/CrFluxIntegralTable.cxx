@@ -0,0 +1,242 @@
+/****************************************************************************
+ * CrFluxIntegralTable.cxx:
+ ****************************************************************************
+ * The spectra of the primaries fall by the geomagnetic cutoff below
+ * the lower limit and as a power law above, so they are smooth in
+ * log(E): Simpson's rule with 512 intervals in log(E) gives the
+ * integrals within 1e-9 of a 200000 interval one.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "CrFluxIntegralTable.hh"
+#include "CrDiagnostics.hh"
+
+std::vector<double> CrFluxIntegralTable::s_corNodes;
+std::vector<double> CrFluxIntegralTable::s_phiNodes;
+std::string CrFluxIntegralTable::s_cacheDirectory;
+
+namespace {
+  // identification of the cache files
+  const char fileTag[8] = {'C','R','F','L','U','X','0','1'};
+
+  // intervals of Simpson's rule in log(E); even
+  const int intervals = 512;
+
+  // MeV per GeV: the spectra are per MeV, the energies in GeV
+  const double MeVperGeV = 1e3;
+
+  // nodes of the former tables
+  const double defaultCor[] = {0.5, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  const double defaultPhi[] = {500, 600, 700, 800, 900, 1000, 1100};
+
+  // FNV-1a hash of bytes, continued from h
+  unsigned long long fnv(unsigned long long h, const void* data, std::size_t size)
+  {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++){
+      h ^= p[i];
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+  unsigned long long fnv(unsigned long long h, const std::vector<double>& v)
+  {
+    unsigned int n = v.size();
+    h = fnv(h, &n, sizeof(n));
+    return v.empty() ? h : fnv(h, &v[0], v.size()*sizeof(double));
+  }
+
+  // index of the cell of x, nodes[i] <= x <= nodes[i+1]
+  int cell(const std::vector<double>& nodes, double x)
+  {
+    int i = std::upper_bound(nodes.begin(), nodes.end(), x) - nodes.begin() - 1;
+    if (i < 0){ i = 0; }
+    if (i > int(nodes.size())-2){ i = nodes.size()-2; }
+    return i;
+  }
+}
+
+CrFluxIntegralTable::CrFluxIntegralTable(const std::string& name, Spectrum spectrum,
+                                         LowerLimit lowE, double highE,
+                                         const std::vector<double>& parameters)
+  : m_name(name), m_spectrum(spectrum), m_lowE(lowE), m_highE(highE),
+    m_cor(corNodes()), m_phi(phiNodes())
+{
+  m_hash = fnv(14695981039346656037ULL, name.c_str(), name.size());
+  m_hash = fnv(m_hash, parameters);
+  m_hash = fnv(m_hash, &m_highE, sizeof(m_highE));
+  m_hash = fnv(m_hash, m_cor);
+  m_hash = fnv(m_hash, m_phi);
+  int n = intervals;
+  m_hash = fnv(m_hash, &n, sizeof(n));
+
+  std::string fileName = cacheFile();
+  if (fileName.empty() || !load(fileName)){
+    build();
+    if (!fileName.empty() && !save(fileName)){
+      std::cout << "CrFluxIntegralTable: cannot write " << fileName << std::endl;
+    }
+  }
+}
+
+CrFluxIntegralTable::Current::Current(const std::string& name, Spectrum spectrum,
+                                      LowerLimit lowE, double highE,
+                                      const std::vector<double>& parameters)
+  : m_name(name), m_spectrum(spectrum), m_lowE(lowE), m_highE(highE),
+    m_parameters(parameters), m_table(0)
+{
+  ;
+}
+
+CrFluxIntegralTable::Current::~Current()
+{
+  std::map<Nodes, CrFluxIntegralTable*>::iterator it;
+  for (it = m_tables.begin(); it != m_tables.end(); ++it){ delete it->second; }
+}
+
+// The settings are compared as they are, which costs no allocation;
+// the tables are kept under the nodes they use, so empty settings and
+// the default nodes share one table
+const CrFluxIntegralTable& CrFluxIntegralTable::Current::table()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_table && m_settings.first == s_corNodes && m_settings.second == s_phiNodes){
+    return *m_table;
+  }
+  if (m_table){
+    static CrDiagnostics::Message& message =
+      CrDiagnostics::message("CrFluxIntegralTable: nodes changed");
+    if (CrDiagnostics::report(message)){
+      CrDiagnostics::print(message, "CrFluxIntegralTable: the nodes of the flux tables"
+                           " have changed; the table of " + m_name + " is made again");
+    }
+  }
+  m_settings = Nodes(s_corNodes, s_phiNodes);
+  CrFluxIntegralTable*& table = m_tables[Nodes(corNodes(), phiNodes())];
+  if (!table){
+    table = new CrFluxIntegralTable(m_name, m_spectrum, m_lowE, m_highE, m_parameters);
+  }
+  m_table = table;
+  return *m_table;
+}
+
+// Integral by Simpson's rule in log(E) between the lower limit and highE
+double CrFluxIntegralTable::integral(double cor, double phi) const
+{
+  // the lower limit vanishes with cor, which is then not restricted
+  double a = log(std::max(m_lowE(cor), 1e-12*m_highE)), b = log(m_highE);
+  if (!(b > a)){ return 0; }
+  double h = (b-a)/intervals;
+  double sum = 0;
+  for (int i = 0; i <= intervals; i++){
+    double E = exp(a + i*h);
+    double w = (i == 0 || i == intervals) ? 1 : (i%2 ? 4 : 2);
+    sum += w * E * m_spectrum(E, cor, phi);
+  }
+  return sum * h/3 * MeVperGeV;
+}
+
+void CrFluxIntegralTable::build()
+{
+  m_table.resize(m_cor.size()*m_phi.size());
+  for (unsigned int i = 0; i < m_cor.size(); i++){
+    for (unsigned int j = 0; j < m_phi.size(); j++){
+      m_table[i*m_phi.size()+j] = integral(m_cor[i], m_phi[j]);
+    }
+  }
+}
+
+bool CrFluxIntegralTable::inside(double cor, double phi) const
+{
+  return cor >= m_cor.front() && cor <= m_cor.back()
+    && phi >= m_phi.front() && phi <= m_phi.back();
+}
+
+// Bilinear interpolation inside the grid
+double CrFluxIntegralTable::flux(double cor, double phi) const
+{
+  if (!inside(cor, phi)){ return integral(cor, phi); }
+  int i = cell(m_cor, cor), j = cell(m_phi, phi);
+  int n = m_phi.size();
+  double u = (cor - m_cor[i])/(m_cor[i+1] - m_cor[i]);
+  double v = (phi - m_phi[j])/(m_phi[j+1] - m_phi[j]);
+  double tmp1 = m_table[i*n+j] + u * (m_table[(i+1)*n+j] - m_table[i*n+j]);
+  double tmp2 = m_table[i*n+j+1] + u * (m_table[(i+1)*n+j+1] - m_table[i*n+j+1]);
+  return tmp1 + (tmp2-tmp1)*v;
+}
+
+std::string CrFluxIntegralTable::cacheFile() const
+{
+  if (s_cacheDirectory.empty()){ return ""; }
+  std::ostringstream name;
+  name << s_cacheDirectory << "/" << m_name << "_"
+       << std::hex << std::setw(16) << std::setfill('0') << m_hash << ".bin";
+  return name.str();
+}
+
+std::vector<double> CrFluxIntegralTable::corNodes()
+{
+  if (s_corNodes.size() >= 2){ return s_corNodes; }
+  return std::vector<double>(defaultCor, defaultCor + sizeof(defaultCor)/sizeof(double));
+}
+
+std::vector<double> CrFluxIntegralTable::phiNodes()
+{
+  if (s_phiNodes.size() >= 2){ return s_phiNodes; }
+  return std::vector<double>(defaultPhi, defaultPhi + sizeof(defaultPhi)/sizeof(double));
+}
+
+// Read the table from a file written by save(); the hash and the
+// nodes must be those of this table
+bool CrFluxIntegralTable::load(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  if (!file){ return false; }
+
+  char tag[8];
+  unsigned long long hash;
+  int size[2];
+  file.read(tag, sizeof(tag));
+  file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+  file.read(reinterpret_cast<char*>(size), sizeof(size));
+  if (!file || memcmp(tag, fileTag, sizeof(tag)) != 0 || hash != m_hash
+      || size[0] != int(m_cor.size()) || size[1] != int(m_phi.size())){
+    return false;
+  }
+
+  std::vector<double> cor(m_cor.size()), phi(m_phi.size());
+  std::vector<double> table(m_cor.size()*m_phi.size());
+  file.read(reinterpret_cast<char*>(&cor[0]), cor.size()*sizeof(double));
+  file.read(reinterpret_cast<char*>(&phi[0]), phi.size()*sizeof(double));
+  file.read(reinterpret_cast<char*>(&table[0]), table.size()*sizeof(double));
+  if (!file || cor != m_cor || phi != m_phi){ return false; }
+  m_table.swap(table);
+  return true;
+}
+
+// Write the table to a file
+bool CrFluxIntegralTable::save(const std::string& fileName) const
+{
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  if (!file){ return false; }
+
+  int size[2] = {int(m_cor.size()), int(m_phi.size())};
+  file.write(fileTag, sizeof(fileTag));
+  file.write(reinterpret_cast<const char*>(&m_hash), sizeof(m_hash));
+  file.write(reinterpret_cast<const char*>(size), sizeof(size));
+  file.write(reinterpret_cast<const char*>(&m_cor[0]), m_cor.size()*sizeof(double));
+  file.write(reinterpret_cast<const char*>(&m_phi[0]), m_phi.size()*sizeof(double));
+  file.write(reinterpret_cast<const char*>(&m_table[0]), m_table.size()*sizeof(double));
+  return bool(file);
+}
@@ -0,0 +1,126 @@
+/**
+ * CrFluxIntegralTable:
+ *  The energy integral of a primary spectrum, tabulated in cutoff
+ *  rigidity and solar potential by numerical quadrature.
+ */
+
+//$Header$
+
+#ifndef CrFluxIntegralTable_H
+#define CrFluxIntegralTable_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** @class CrFluxIntegralTable
+ *  @brief computed table of the vertically downward flux of a primary
+ *
+ * flux() of the primaries is the spectrum integrated between the
+ * lower energy limit, which follows the cutoff rigidity, and the upper
+ * one.  The integral is computed by Simpson's rule in log(E) at the
+ * nodes of a grid in cutoff rigidity and solar potential and
+ * interpolated bilinearly in between; outside the grid it is computed
+ * directly.  The nodes are those of s_corNodes and s_phiNodes when the
+ * table is made (by default 0.5, 1, 2, ..., 15 GV and 500, 600, ...,
+ * 1100 MV, the nodes of the former hand-typed tables).  The components
+ * take their table from a CrFluxIntegralTable::Current, which makes a
+ * new one when the nodes have changed.
+ *
+ * With s_cacheDirectory set, a table is written there once and read
+ * back by the next runs.  The file is named after the component and a
+ * hash of the parameters of the spectrum, the nodes and the
+ * quadrature, so a change of any of them makes a new file instead of
+ * reading a stale one.
+ */
+class CrFluxIntegralTable
+{
+public:
+  /// spectrum [c/s/m^2/sr/MeV] at the kinetic energy E [GeV], the
+  /// cutoff rigidity cor [GV] and the solar potential phi [MV]
+  typedef double (*Spectrum)(double E, double cor, double phi);
+  /// lower limit of the integral [GeV] at the cutoff rigidity cor [GV]
+  typedef double (*LowerLimit)(double cor);
+
+  /// name of the component; the parameters are those of the spectrum
+  /// that enter the hash (normalization, index, ...)
+  CrFluxIntegralTable(const std::string& name, Spectrum spectrum,
+                      LowerLimit lowE, double highE,
+                      const std::vector<double>& parameters);
+
+  /// Gives back the integral [c/s/m^2/sr] at cor [GV] and phi [MV]
+  double flux(double cor, double phi) const;
+
+  /// Gives back the integral computed by quadrature
+  double integral(double cor, double phi) const;
+
+  /// true if cor and phi are within the grid
+  bool inside(double cor, double phi) const;
+
+  /// hash of the parameters, nodes and quadrature
+  unsigned long long hash() const { return m_hash; }
+
+  /// name of the cache file, empty without s_cacheDirectory
+  std::string cacheFile() const;
+
+  /// Gives back the nodes given to new tables: s_corNodes and
+  /// s_phiNodes, or the defaults if they are empty
+  static std::vector<double> corNodes();
+  static std::vector<double> phiNodes();
+
+  /// nodes of the tables made afterwards [GV], [MV]; increasing
+  static std::vector<double> s_corNodes;
+  static std::vector<double> s_phiNodes;
+  /// directory of the cache files; none if empty
+  static std::string s_cacheDirectory;
+
+  /// The table of a spectrum for the nodes of the time: table() makes
+  /// it at the first call and again, with a warning of CrDiagnostics,
+  /// whenever s_corNodes or s_phiNodes have changed since the last
+  /// call.  All the tables made are kept, one per set of nodes, so
+  /// that a table given back stays valid; table() may be called by
+  /// several threads.
+  class Current {
+  public:
+    Current(const std::string& name, Spectrum spectrum, LowerLimit lowE,
+            double highE, const std::vector<double>& parameters);
+    ~Current();
+
+    /// Gives back the table for the current nodes
+    const CrFluxIntegralTable& table();
+
+  private:
+    typedef std::pair<std::vector<double>, std::vector<double> > Nodes;
+
+    std::string m_name;
+    Spectrum m_spectrum;
+    LowerLimit m_lowE;
+    double m_highE;
+    std::vector<double> m_parameters;
+
+    std::mutex m_mutex;
+    Nodes m_settings; ///< s_corNodes and s_phiNodes of m_table
+    const CrFluxIntegralTable* m_table;
+    std::map<Nodes, CrFluxIntegralTable*> m_tables;
+
+    Current(const Current&);
+    Current& operator=(const Current&);
+  };
+
+private:
+  void build();
+  bool load(const std::string& fileName);
+  bool save(const std::string& fileName) const;
+
+  std::string m_name;
+  Spectrum m_spectrum;
+  LowerLimit m_lowE;
+  double m_highE; ///< [GeV]
+  std::vector<double> m_cor, m_phi; ///< nodes [GV], [MV]
+  std::vector<double> m_table; ///< [cor][phi] integrals [c/s/m^2/sr]
+  unsigned long long m_hash;
+};
+
+#endif // CrFluxIntegralTable_H
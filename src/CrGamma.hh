@@ -15,6 +15,7 @@
 
 // Activate the next line when in CRflux package
 #include "flux/Spectrum.h"
+#include "CrComponentMix.hh"
 // Activate the next line when in end-to-end simulation framework
 // of Tune's group
 //#include "ISpectrum.h"
@@ -35,12 +36,22 @@ public:
   // Gives back component in the ratio of the flux
   CrSpectrum* selectComponent();
 
+  // Set the random engine of the source, by default the global CLHEP
+  // engine (that of FluxSvc), e.g. a stream of a CrPhiloxEngine
+  void setEngine(CLHEP::HepRandomEngine* engine);
+
   // Gives back energy
   virtual double energy(double time);
 
   // Gives back paticle direction in cos(theta) and phi[rad]
   virtual std::pair<double,double> dir(double energy);
 
+  // Fill n particles: kinetic energy [GeV], cos(theta) and phi[rad].
+  // The components are selected as in selectComponent();
+  // source[i], if given, is the component of particle i.
+  void sampleBlock(int n, double* energy, double* cosTheta, double* phi,
+                   const CrSpectrum** source=0);
+
   // Gives back the total flux (summation of each component's flux)
   virtual double flux(double time) const;  // calculate the flux [c/s/m^2/sr]
 
@@ -64,6 +75,7 @@ public:
 
 private:
   std::vector<CrSpectrum*>  m_subComponents;
+  CrComponentMix            m_mix;
   CrSpectrum*               m_component;
   CLHEP::HepRandomEngine* m_engine;
 };
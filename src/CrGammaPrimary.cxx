@@ -37,6 +37,7 @@
 // $Header$
 
 #include <cmath>
+#include <vector>
 
 // CLHEP
 //#include <CLHEP/config/CLHEP.h>
@@ -45,6 +46,7 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrGammaPrimary.hh"
+#include "CrBatchMath.hh"
 
 typedef double G4double;
 
@@ -58,14 +60,6 @@ namespace {
   const G4double lowE_break  = 50.0e-6; // 50 keV
   const G4double highE_break = 1.0e-3; // 1 MeV
  
-  // The constant defined below ("ENERGY_INTEGRAL_primary") is the straight 
-  // downward (theta=0) flux integrated between 
-  // m_gammaLowEnergy and m_gammaHighEnergy.
-  // It will be computed in units of [c/s/m^2/sr] in flux() method
-  // from parameters given below 
-  // (i.e., A*_primary and a*_primary).
-  G4double ENERGY_INTEGRAL_primary;
-
 
   //============================================================
   /**
@@ -239,52 +233,99 @@ std::pair<G4double,G4double> CrGammaPrimary::dir(G4double /* energy */,
 // Gives back particle energy
 G4double CrGammaPrimary::energySrc(CLHEP::HepRandomEngine* engine) const
 {
+  const CrEnvelopeIntegrals& envelope = envelopeIntegrals();
 
-  G4double rand_min_1 = 
-    primaryCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_primary)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_1 = 
-    primaryCRenvelope1_integral(max(lowE_primary, min(m_gammaHighEnergy, lowE_break)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_2 =
-    primaryCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_2 =
-    primaryCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_3 =
-    primaryCRenvelope3_integral(min(highE_primary, max(m_gammaLowEnergy, highE_break)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_3 =
-    primaryCRenvelope3_integral(max(highE_break, min(m_gammaHighEnergy, highE_primary)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  
-  G4double envelope1_area = rand_max_1 - rand_min_1;
-  G4double envelope2_area = rand_max_2 - rand_min_2;
-  G4double envelope3_area = rand_max_3 - rand_min_3;
-  G4double envelope_area = envelope1_area + envelope2_area + envelope3_area;
-  
-  G4double Ernd,r;
-  G4double E; // E means energy in GeV
-  
-  while(1){
-    Ernd = engine->flat();
-    if (Ernd <= envelope1_area/envelope_area){
-      // use the envelope function in the lower energy range
-      r = engine->flat() * (rand_max_1 - rand_min_1) + rand_min_1;
-      E = primaryCRenvelope1_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else if (Ernd <= (envelope1_area + envelope2_area)/envelope_area){
-      // use envelope function in middle energy range
-      r = engine->flat() * (rand_max_2 - rand_min_2) + rand_min_2;
-      E = primaryCRenvelope2_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else {
-      // use envelope function in the higher energy range
-      r = engine->flat() * (rand_max_3 - rand_min_3) + rand_min_3;
-      E = primaryCRenvelope3_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    }
+  G4double r;
+  G4double E = 0; // E means energy in GeV
+
+  switch (envelope.piece(engine->flat())){
+  case 0:
+    // use the envelope function in the lower energy range
+    r = engine->flat() * (envelope.high(0) - envelope.low(0)) + envelope.low(0);
+    E = primaryCRenvelope1_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 1:
+    // use envelope function in middle energy range
+    r = engine->flat() * (envelope.high(1) - envelope.low(1)) + envelope.low(1);
+    E = primaryCRenvelope2_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 2:
+    // use envelope function in the higher energy range
+    r = engine->flat() * (envelope.high(2) - envelope.low(2)) + envelope.low(2);
+    E = primaryCRenvelope3_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
     break;
   }
-    return E;
+  return E;
+}
+
+
+// Integrals of the envelope functions between m_gammaLowEnergy and
+// m_gammaHighEnergy; they are computed again only when the range changes
+const CrEnvelopeIntegrals& CrGammaPrimary::envelopeIntegrals() const
+{
+  if (m_envelope.valid() && m_envelope.sameRange(m_gammaLowEnergy, m_gammaHighEnergy)){
+    return m_envelope;
+  }
+
+  G4double low[3], high[3];
+  low[0] = primaryCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_primary)),
+                                       m_cutOffRigidity, m_solarWindPotential);
+  high[0] = primaryCRenvelope1_integral(max(lowE_primary, min(m_gammaHighEnergy, lowE_break)),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  low[1] = primaryCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)),
+                                       m_cutOffRigidity, m_solarWindPotential);
+  high[1] = primaryCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  low[2] = primaryCRenvelope3_integral(min(highE_primary, max(m_gammaLowEnergy, highE_break)),
+                                       m_cutOffRigidity, m_solarWindPotential);
+  high[2] = primaryCRenvelope3_integral(max(highE_break, min(m_gammaHighEnergy, highE_primary)),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  m_envelope.set(3, low, high);
+  m_envelope.setRange(m_gammaLowEnergy, m_gammaHighEnergy);
+  return m_envelope;
+}
+
+
+// Fill n particles at once.
+// The envelope integrals are those kept for the energy range, so the
+// block needs only the random numbers.
+void CrGammaPrimary::sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                                 G4double* energy, G4double* cosTheta,
+                                 G4double* phi) const
+{
+  if (n<=0){ return; }
+
+  const CrEnvelopeIntegrals& envelope = envelopeIntegrals();
+
+  // two random numbers for the energy and two for the direction
+  std::vector<G4double> rnd(4*n);
+  engine->flatArray(4*n, &rnd[0]);
+
+  // The inverse of the integral of piece k is
+  // pow(coeff[k]*r, exponent[k]) [MeV]; the bases go to the front of
+  // rnd (base i is written after rnd[2*i] and rnd[2*i+1] are read) and
+  // the exponents to energy, and all are raised by CrBatchMath::pow().
+  const G4double coeff[3] = {(-a1_primary+1)/A1_primary,
+                             (-a2_primary+1)/A2_primary,
+                             (-a3_primary+1)/A3_primary};
+  const G4double exponent[3] = {1./(-a1_primary+1), 1./(-a2_primary+1),
+                                1./(-a3_primary+1)};
+  for (int i = 0; i < n; i++){
+    G4double Ernd = rnd[2*i];
+    int k = envelope.piece(Ernd);
+    G4double r = rnd[2*i+1] * envelope.area(k) + envelope.low(k);
+    rnd[i] = coeff[k] * r;
+    energy[i] = exponent[k];
+  }
+  CrBatchMath::pow(n, &rnd[0], energy, energy);
+  for (int i = 0; i < n; i++){ energy[i] *= MeVtoGeV; }
+
+  // Cos(theta) ranges from 1 to -0.4, as in dir()
+  const G4double* drnd = &rnd[2*n];
+  for (int i = 0; i < n; i++){
+    cosTheta[i] = 1.4*drnd[2*i]-0.4;
+    phi[i]      = drnd[2*i+1] * 2 * M_PI;
+  }
 }
 
 
@@ -295,40 +336,10 @@ G4double CrGammaPrimary::energySrc(CLHEP::HepRandomEngine* engine) const
 // "primary", "reentrant" and "splash".
 G4double CrGammaPrimary::flux() const
 {
-
-  G4double rand_min_1 = 
-    primaryCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_primary)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_1 = 
-    primaryCRenvelope1_integral(max(lowE_primary, min(m_gammaHighEnergy, lowE_break)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_2 =
-    primaryCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_2 =
-    primaryCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_3 =
-    primaryCRenvelope3_integral(min(highE_primary, max(m_gammaLowEnergy, highE_break)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_3 =
-    primaryCRenvelope3_integral(max(highE_break, min(m_gammaHighEnergy, highE_primary)), 
-				m_cutOffRigidity, m_solarWindPotential);
-  
-  G4double envelope1_area = rand_max_1 - rand_min_1;
-  G4double envelope2_area = rand_max_2 - rand_min_2;
-  G4double envelope3_area = rand_max_3 - rand_min_3;
-  G4double envelope_area = envelope1_area + envelope2_area + envelope3_area;
-  ENERGY_INTEGRAL_primary = envelope_area;
-
-  /***
-  cout << "m_gammaLowEnergy: " << m_gammaLowEnergy << endl;
-  cout << "m_gammaHighEnergy: " << m_gammaHighEnergy << endl;
-  cout << "envelope1_area: " << envelope1_area << endl;
-  cout << "envelope2_area: " << envelope2_area << endl;
-  cout << "envelope3_area: " << envelope3_area << endl;
-  cout << "envelope_area: " << ENERGY_INTEGRAL_primary << endl;
-  ***/
+  // The straight downward (theta=0) flux integrated between 
+  // m_gammaLowEnergy and m_gammaHighEnergy in units of [c/s/m^2/sr].
+  // It is local so that flux() of two instances never interfere.
+  G4double ENERGY_INTEGRAL_primary = envelopeIntegrals().area();
 
   // We assume that the flux is uniform above the earth horizon.
   // Then the average flux is equal to the vertically downward one.
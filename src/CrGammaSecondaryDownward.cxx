@@ -66,6 +66,7 @@
 
 
 #include <cmath>
+#include <vector>
 
 // CLHEP
 //#include <CLHEP/config/CLHEP.h>
@@ -74,6 +75,8 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrGammaSecondaryDownward.hh"
+#include "CrBatchMath.hh"
+#include "CrSamplingCounters.hh"
 
 typedef double G4double;
 
@@ -317,12 +320,15 @@ std::pair<G4double,G4double> CrGammaSecondaryDownward::dir(G4double /* energy */
   // 31.088 (theta=2.007--2.443[rad])
   // 8.831  (theta=2.443--pi[rad])
 
+  CRFLUX_COUNTER(innerCounter, "CrGammaSecondaryDownward dir 0-60 deg");
+  CRFLUX_COUNTER(outerCounter, "CrGammaSecondaryDownward dir 60-90 deg");
   G4double rand = engine->flat();
   G4double theta;
   if (rand*(4.355+9.980)<=4.355){ // from 0 to pi/3 radian
     while(1){
       theta = acos( cos(M_PI/3)+(engine->flat())*(cos(0.0)-cos(M_PI/3)) );
-      if ( 2*engine->flat()< (1/cos(theta)) ){break;}
+      CRFLUX_COUNT_ATTEMPT(innerCounter, 2);
+      if ( 2*engine->flat()< (1/cos(theta)) ){ CRFLUX_COUNT_ACCEPT(innerCounter); break;}
     }
   } else { 
     // pi/3 to pi/2 [rad], where the flux [/sr] depends on theta as
@@ -336,7 +342,8 @@ std::pair<G4double,G4double> CrGammaSecondaryDownward::dir(G4double /* energy */
       G4double min = a/b*exp(b*M_PI/3);
       G4double r = engine->flat() * (max-min) + min;
       theta = 1/b*log(b*r/a);
-      if (engine->flat()<sin (theta)){break;}
+      CRFLUX_COUNT_ATTEMPT(outerCounter, 2);
+      if (engine->flat()<sin (theta)){ CRFLUX_COUNT_ACCEPT(outerCounter); break;}
     }
   }
   
@@ -349,132 +356,133 @@ std::pair<G4double,G4double> CrGammaSecondaryDownward::dir(G4double /* energy */
 // Gives back particle energy
 G4double CrGammaSecondaryDownward::energySrc(CLHEP::HepRandomEngine* engine) const
 {
+  const CrEnvelopeIntegrals& envelope = envelopeIntegrals();
 
-  G4double rand_min_1 = 
-    downwardCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_downward)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_1 = 
-    downwardCRenvelope1_integral(max(lowE_downward, min(m_gammaHighEnergy, lowE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_2 =
-    downwardCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_2 =
-    downwardCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_3 =
-    downwardCRenvelope3_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_3 =
-    downwardCRenvelope3_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_4 =
-    downwardCRenvelope4_integral(min(highE_downward, max(m_gammaLowEnergy, highE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_4 =
-    downwardCRenvelope4_integral(max(highE_break, min(m_gammaHighEnergy, highE_downward)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-
-  G4double envelope1_area = rand_max_1 - rand_min_1;
-  G4double envelope2_area = rand_max_2 - rand_min_2;
-  G4double envelope3_area = rand_max_3 - rand_min_3;
-  G4double envelope4_area = rand_max_4 - rand_min_4;
-  G4double envelope_511keV;
-  if (m_gammaHighEnergy>=511.0e-6 && m_gammaLowEnergy<=511.0e-6){
-    envelope_511keV = A_511keV;
-  } else {
-    envelope_511keV = 0.0;
+  G4double r;
+  G4double E = 0; // E means energy in GeV
+
+  switch (envelope.piece(engine->flat())){
+  case 0:
+    // envelope in higher energy
+    r = engine->flat() * (envelope.high(0) - envelope.low(0)) + envelope.low(0);
+    E = downwardCRenvelope1_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 1:
+    // envelope in higher energy
+    r = engine->flat() * (envelope.high(1) - envelope.low(1)) + envelope.low(1);
+    E = downwardCRenvelope2_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 2:
+    // envelope in highest energy
+    r = engine->flat() * (envelope.high(2) - envelope.low(2)) + envelope.low(2);
+    E = downwardCRenvelope3_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 3:
+    r = engine->flat() * (envelope.high(3) - envelope.low(3)) + envelope.low(3);
+    E = downwardCRenvelope4_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  default:
+    E = 511.0e-6;
   }
+  return E;
+}
 
-  G4double envelope_area = envelope1_area + envelope2_area 
-    + envelope3_area + envelope4_area + envelope_511keV;
-  
-  G4double Ernd,r; 
-  G4double E; // E means energy in GeV
-
-  while(1){
-    Ernd = engine->flat();
-    if (Ernd <= (envelope1_area)/envelope_area){
-      // envelope in higher energy
-      r = engine->flat() * (rand_max_1 - rand_min_1) + rand_min_1;
-      E = downwardCRenvelope1_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else if (Ernd <= (envelope1_area+envelope2_area)/envelope_area){
-      // envelope in higher energy
-      r = engine->flat() * (rand_max_2 - rand_min_2) + rand_min_2;
-      E = downwardCRenvelope2_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else if (Ernd <= (envelope1_area+envelope2_area+envelope3_area)/envelope_area){
-      // envelope in highest energy
-      r = engine->flat() * (rand_max_3 - rand_min_3) + rand_min_3;
-      E = downwardCRenvelope3_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else if (Ernd <= (envelope1_area+envelope2_area+envelope3_area+envelope4_area)/envelope_area){
-      r = engine->flat() * (rand_max_4 - rand_min_4) + rand_min_4;
-      E = downwardCRenvelope4_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+// Gives back n particles; the bases and the exponents of the inverses
+// of the integrals, scale*pow(base, exponent), are collected and
+// raised together by CrBatchMath::pow()
+void CrGammaSecondaryDownward::sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                                           G4double* energy, G4double* cosTheta,
+                                           G4double* phi) const
+{
+  if (n<=0){ return; }
+
+  const CrEnvelopeIntegrals& envelope = envelopeIntegrals();
+  // piece 2, the power law with the exponential cutoff, has the base
+  // -log(coeff*r) and the scale Cutoff
+  const G4double coeff[4] = {(-a1_downward+1)/A1_downward,
+                             (-a2_downward+1)/A2_downward,
+                             (a3_downward-1)/(A3_downward * pow(Cutoff, -a3_downward+1)),
+                             (-a4_downward+1)/A4_downward};
+  const G4double exponent[4] = {1./(-a1_downward+1), 1./(-a2_downward+1),
+                                1./(-a3_downward+1), 1./(-a4_downward+1)};
+  const G4double scale[4] = {MeVtoGeV, MeVtoGeV, Cutoff*MeVtoGeV, MeVtoGeV};
+
+  // two random numbers for the energy; pieces() is the 511 keV line,
+  // raised as pow(1, 0) and replaced
+  std::vector<G4double> rnd(2*n), base(n);
+  std::vector<int> piece(n);
+  engine->flatArray(2*n, &rnd[0]);
+  for (int i = 0; i < n; i++){
+    int k = envelope.piece(rnd[2*i]);
+    piece[i] = k;
+    if (k < envelope.pieces()){
+      base[i] = coeff[k] * (rnd[2*i+1] * envelope.area(k) + envelope.low(k));
+      if (k == 2){ base[i] = -log(base[i]); }
+      energy[i] = exponent[k];
     } else {
-      E = 511.0e-6;
+      base[i] = 1;
+      energy[i] = 0;
     }
-    break;
+  }
+  CrBatchMath::pow(n, &base[0], energy, energy);
+  for (int i = 0; i < n; i++){
+    int k = piece[i];
+    energy[i] = k < envelope.pieces() ? energy[i] * scale[k] : 511.0e-6;
   }
 
-  return E;
+  for (int i = 0; i < n; i++){
+    std::pair<G4double,G4double> d = dir(energy[i], engine);
+    cosTheta[i] = d.first;
+    phi[i] = d.second;
+  }
 }
 
 
-// flux() returns the energy integrated flux averaged over
-// the region from which particle is coming from 
-// and the unit is [c/s/m^2/sr].
-// flux()*solidAngle() is used as relative normalization among
-// "primary", "reentrant" and "splash".
-G4double CrGammaSecondaryDownward::flux() const
+// Integrals of the envelope functions between m_gammaLowEnergy and
+// m_gammaHighEnergy; they are computed again only when the range changes
+const CrEnvelopeIntegrals& CrGammaSecondaryDownward::envelopeIntegrals() const
 {
-  G4double rand_min_1 = 
-    downwardCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_downward)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_1 = 
-    downwardCRenvelope1_integral(max(lowE_downward, min(m_gammaHighEnergy, lowE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_2 =
-    downwardCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_2 =
-    downwardCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_3 =
-    downwardCRenvelope3_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_3 =
-    downwardCRenvelope3_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_4 =
-    downwardCRenvelope4_integral(min(highE_downward, max(m_gammaLowEnergy, highE_break)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_4 =
-    downwardCRenvelope4_integral(max(highE_break, min(m_gammaHighEnergy, highE_downward)), 
-				 m_cutOffRigidity, m_solarWindPotential);
-
-  G4double envelope1_area = rand_max_1 - rand_min_1;
-  G4double envelope2_area = rand_max_2 - rand_min_2;
-  G4double envelope3_area = rand_max_3 - rand_min_3;
-  G4double envelope4_area = rand_max_4 - rand_min_4;
+  if (m_envelope.valid() && m_envelope.sameRange(m_gammaLowEnergy, m_gammaHighEnergy)){
+    return m_envelope;
+  }
+
+  G4double low[4], high[4];
+  low[0] = downwardCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_downward)),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  high[0] = downwardCRenvelope1_integral(max(lowE_downward, min(m_gammaHighEnergy, lowE_break)),
+                                         m_cutOffRigidity, m_solarWindPotential);
+  low[1] = downwardCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  high[1] = downwardCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)),
+                                         m_cutOffRigidity, m_solarWindPotential);
+  low[2] = downwardCRenvelope3_integral(min(highE_break, max(m_gammaLowEnergy, lowE_break)),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  high[2] = downwardCRenvelope3_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)),
+                                         m_cutOffRigidity, m_solarWindPotential);
+  low[3] = downwardCRenvelope4_integral(min(highE_downward, max(m_gammaLowEnergy, highE_break)),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  high[3] = downwardCRenvelope4_integral(max(highE_break, min(m_gammaHighEnergy, highE_downward)),
+                                         m_cutOffRigidity, m_solarWindPotential);
   G4double envelope_511keV;
   if (m_gammaHighEnergy>=511.0e-6 && m_gammaLowEnergy<=511.0e-6){
     envelope_511keV = A_511keV;
   } else {
     envelope_511keV = 0.0;
   }
-  G4double envelope_area = envelope1_area + envelope2_area 
-    + envelope3_area + envelope4_area + envelope_511keV;
-  ENERGY_INTEGRAL_downward = envelope_area;
-
-  /***
-  cout << "m_gammaLowEnergy: " << m_gammaLowEnergy << endl;
-  cout << "m_gammaHighEnergy: " << m_gammaHighEnergy << endl;
-  cout << "envelope1_area: " << envelope1_area << endl;
-  cout << "envelope2_area: " << envelope2_area << endl;
-  cout << "envelope3_area: " << envelope3_area << endl;
-  cout << "envelope4_area: " << envelope4_area << endl;
-  cout << "envelope_511keV: " << envelope_511keV << endl;
-  cout << "envelope_area: " << ENERGY_INTEGRAL_downward << endl;
-  ***/
+  m_envelope.set(4, low, high, envelope_511keV);
+  m_envelope.setRange(m_gammaLowEnergy, m_gammaHighEnergy);
+  return m_envelope;
+}
+
+
+// flux() returns the energy integrated flux averaged over
+// the region from which particle is coming from 
+// and the unit is [c/s/m^2/sr].
+// flux()*solidAngle() is used as relative normalization among
+// "primary", "reentrant" and "splash".
+G4double CrGammaSecondaryDownward::flux() const
+{
+  ENERGY_INTEGRAL_downward = envelopeIntegrals().area();
 
   // "ENERGY_INTEGRAL_downward" is the energy integrated flux 
   // (between gammaLowEnergy and gammaHighEnergy) at theta=0 
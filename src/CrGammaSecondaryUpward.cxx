@@ -69,6 +69,7 @@
 // $Header$
 
 #include <cmath>
+#include <vector>
 
 // CLHEP
 //#include <CLHEP/config/CLHEP.h>
@@ -77,6 +78,7 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrGammaSecondaryUpward.hh"
+#include "CrBatchMath.hh"
 
 
 typedef double G4double;
@@ -325,63 +327,108 @@ std::pair<G4double,G4double> CrGammaSecondaryUpward::dir(G4double /* energy */,
 // Gives back particle energy
 G4double CrGammaSecondaryUpward::energySrc(CLHEP::HepRandomEngine* engine) const
 {
+  const CrEnvelopeIntegrals& envelope = envelopeIntegrals();
 
-  G4double rand_min_1 = 
-    upwardCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_upward)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_1 = 
-    upwardCRenvelope1_integral(max(lowE_upward, min(m_gammaHighEnergy, lowE_break)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_2 =
-    upwardCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy,lowE_break)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_2 =
-    upwardCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_3 =
-    upwardCRenvelope3_integral(min(highE_upward, max(m_gammaLowEnergy, highE_break)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_3 =
-    upwardCRenvelope3_integral(max(highE_break, min(m_gammaHighEnergy, highE_upward)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  
-  G4double envelope1_area = rand_max_1 - rand_min_1;
-  G4double envelope2_area = rand_max_2 - rand_min_2;
-  G4double envelope3_area = rand_max_3 - rand_min_3;
+  G4double r;
+  G4double E = 0; // E means energy in GeV
+
+  switch (envelope.piece(engine->flat())){
+  case 0:
+    // envelop in lower energy
+    r = engine->flat() * (envelope.high(0) - envelope.low(0)) + envelope.low(0);
+    E = upwardCRenvelope1_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 1:
+    // envelop in higher energy
+    r = engine->flat() * (envelope.high(1) - envelope.low(1)) + envelope.low(1);
+    E = upwardCRenvelope2_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 2:
+    // envelope in highest energy
+    r = engine->flat() * (envelope.high(2) - envelope.low(2)) + envelope.low(2);
+    E = upwardCRenvelope3_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  default:
+    E = 511.0e-6;
+  }
+  return E;
+}
+
+// Gives back n particles; the bases and the exponents of the inverses
+// of the integrals, pow(coeff*r, exponent) [MeV], are collected and
+// raised together by CrBatchMath::pow()
+void CrGammaSecondaryUpward::sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                                         G4double* energy, G4double* cosTheta,
+                                         G4double* phi) const
+{
+  if (n<=0){ return; }
+
+  const CrEnvelopeIntegrals& envelope = envelopeIntegrals();
+  const G4double coeff[3] = {(-a1_upward+1)/A1_upward,
+                             (-a2_upward+1)/A2_upward,
+                             (-a3_upward+1)/A3_upward};
+  const G4double exponent[3] = {1./(-a1_upward+1), 1./(-a2_upward+1),
+                                1./(-a3_upward+1)};
+
+  // two random numbers for the energy; pieces() is the 511 keV line,
+  // raised as pow(1, 0) and replaced
+  std::vector<G4double> rnd(2*n), base(n);
+  std::vector<int> piece(n);
+  engine->flatArray(2*n, &rnd[0]);
+  for (int i = 0; i < n; i++){
+    int k = envelope.piece(rnd[2*i]);
+    piece[i] = k;
+    if (k < envelope.pieces()){
+      base[i] = coeff[k] * (rnd[2*i+1] * envelope.area(k) + envelope.low(k));
+      energy[i] = exponent[k];
+    } else {
+      base[i] = 1;
+      energy[i] = 0;
+    }
+  }
+  CrBatchMath::pow(n, &base[0], energy, energy);
+  for (int i = 0; i < n; i++){
+    energy[i] = piece[i] < envelope.pieces() ? energy[i] * MeVtoGeV : 511.0e-6;
+  }
+
+  for (int i = 0; i < n; i++){
+    std::pair<G4double,G4double> d = dir(energy[i], engine);
+    cosTheta[i] = d.first;
+    phi[i] = d.second;
+  }
+}
+
+
+// Integrals of the envelope functions between m_gammaLowEnergy and
+// m_gammaHighEnergy; they are computed again only when the range changes
+const CrEnvelopeIntegrals& CrGammaSecondaryUpward::envelopeIntegrals() const
+{
+  if (m_envelope.valid() && m_envelope.sameRange(m_gammaLowEnergy, m_gammaHighEnergy)){
+    return m_envelope;
+  }
+
+  G4double low[3], high[3];
+  low[0] = upwardCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_upward)),
+                                      m_cutOffRigidity, m_solarWindPotential);
+  high[0] = upwardCRenvelope1_integral(max(lowE_upward, min(m_gammaHighEnergy, lowE_break)),
+                                       m_cutOffRigidity, m_solarWindPotential);
+  low[1] = upwardCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy,lowE_break)),
+                                      m_cutOffRigidity, m_solarWindPotential);
+  high[1] = upwardCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)),
+                                       m_cutOffRigidity, m_solarWindPotential);
+  low[2] = upwardCRenvelope3_integral(min(highE_upward, max(m_gammaLowEnergy, highE_break)),
+                                      m_cutOffRigidity, m_solarWindPotential);
+  high[2] = upwardCRenvelope3_integral(max(highE_break, min(m_gammaHighEnergy, highE_upward)),
+                                       m_cutOffRigidity, m_solarWindPotential);
   G4double envelope_511keV;
   if (m_gammaHighEnergy>=511.0e-6 && m_gammaLowEnergy<=511.0e-6){
     envelope_511keV = A_511keV;
   } else {
     envelope_511keV = 0.0;
   }
-  
-  G4double envelope_area = envelope1_area + envelope2_area 
-    + envelope3_area + envelope_511keV;
-  
-  G4double Ernd,r;
-  G4double E; // E means energy in GeV
-
-  while(1){
-    Ernd = engine->flat();
-    if (Ernd <= (envelope1_area)/envelope_area){
-      // envelop in lower energy
-      r = engine->flat() * (rand_max_1 - rand_min_1) + rand_min_1;
-      E = upwardCRenvelope1_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else if (Ernd <= (envelope1_area+envelope2_area)/envelope_area){
-      // envelop in higher energy
-      r = engine->flat() * (rand_max_2 - rand_min_2) + rand_min_2;
-      E = upwardCRenvelope2_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else if (Ernd <= (envelope1_area+envelope2_area+envelope3_area)/envelope_area){
-      // envelope in highest energy
-      r = engine->flat() * (rand_max_3 - rand_min_3) + rand_min_3;
-      E = upwardCRenvelope3_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else {
-      E = 511.0e-6;
-    }
-    break;
-  }
-  
-  return E;
+  m_envelope.set(3, low, high, envelope_511keV);
+  m_envelope.setRange(m_gammaLowEnergy, m_gammaHighEnergy);
+  return m_envelope;
 }
 
 
@@ -393,48 +440,7 @@ G4double CrGammaSecondaryUpward::energySrc(CLHEP::HepRandomEngine* engine) const
 // "primary", "reentrant" and "splash".
 G4double CrGammaSecondaryUpward::flux() const
 {
-  G4double rand_min_1 = 
-    upwardCRenvelope1_integral(min(lowE_break, max(m_gammaLowEnergy, lowE_upward)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_1 = 
-    upwardCRenvelope1_integral(max(lowE_upward, min(m_gammaHighEnergy, lowE_break)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_2 =
-    upwardCRenvelope2_integral(min(highE_break, max(m_gammaLowEnergy,lowE_break)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_2 =
-    upwardCRenvelope2_integral(max(lowE_break, min(m_gammaHighEnergy, highE_break)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_3 =
-    upwardCRenvelope3_integral(min(highE_upward, max(m_gammaLowEnergy, highE_break)), 
-			       m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_3 =
-    upwardCRenvelope3_integral(max(highE_break, min(m_gammaHighEnergy, highE_upward)),
-                               m_cutOffRigidity, m_solarWindPotential);
-  
-  G4double envelope1_area = rand_max_1 - rand_min_1;
-  G4double envelope2_area = rand_max_2 - rand_min_2;
-  G4double envelope3_area = rand_max_3 - rand_min_3;
-  G4double envelope_511keV;
-  if (m_gammaHighEnergy>=511.0e-6 && m_gammaLowEnergy<=511.0e-6){
-    envelope_511keV = A_511keV;
-  } else {
-    envelope_511keV = 0.0;
-  }
-  
-  G4double envelope_area = envelope1_area + envelope2_area 
-    + envelope3_area + envelope_511keV;
-  ENERGY_INTEGRAL_upward = envelope_area;
-
-  /***
-  cout << "m_gammaLowEnergy: " << m_gammaLowEnergy << endl;
-  cout << "m_gammaHighEnergy: " << m_gammaHighEnergy << endl;
-  cout << "envelope1_area: " << envelope1_area << endl;
-  cout << "envelope2_area: " << envelope2_area << endl;
-  cout << "envelope3_area: " << envelope3_area << endl;
-  cout << "envelope_511keV: " << envelope_511keV << endl;
-  cout << "envelope_area: " << ENERGY_INTEGRAL_upward << endl;
-  ***/
+  ENERGY_INTEGRAL_upward = envelopeIntegrals().area();
 
   // "ENERGY_INTEGRAL_upward" is the energy integrated flux 
   // (between gammaLowEnergy and gammaHighEnergy) at theta=pi 
@@ -11,6 +11,7 @@
 #include <utility>
 #include <string>
 #include "CrSpectrum.hh"
+#include "CrEnvelopeIntegrals.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
@@ -27,6 +28,11 @@ public:
   // Gives back particle energy
   double energySrc(CLHEP::HepRandomEngine* engine) const;
 
+  // Fill n particles at once: the energies are computed together with
+  // CrBatchMath, the directions with dir()
+  void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                   double* energy, double* cosTheta, double* phi) const;
+
   // flux() returns the value averaged over the region from which
   // the particle is coming from and the unit is [c/s/m^2/sr]
   double flux() const;
@@ -39,6 +45,11 @@ public:
 
   // Gives back the name of the component
   std::string title() const;
+
+private:
+  // Integrals of the envelope functions for the present energy range
+  const CrEnvelopeIntegrals& envelopeIntegrals() const;
+  mutable CrEnvelopeIntegrals m_envelope;
 };
 #endif // CrGammaSecondaryUpward_H
 
@@ -0,0 +1,237 @@
+/****************************************************************************
+ * CrGeomagneticGrid.cxx:
+ ****************************************************************************
+ * Tabulation of the IGRF field model on a regular grid in geographic
+ * latitude, longitude and altitude, with trilinear interpolation.
+ * The default grid covers the latitudes reached from a low inclination
+ * orbit (|lat| <= 30 deg) with 1 deg x 2 deg cells between 450 and
+ * 650 km, about 55k nodes.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "CrGeomagneticGrid.hh"
+
+#include "astro/IGRField.h"
+
+namespace {
+  // identification of the grid files
+  const char fileTag[8] = {'C','R','G','R','I','D','0','1'};
+
+  // number of cells needed to cover [min, max] with the step
+  int cells(double min, double max, double step)
+  {
+    if (!(step>0) || !(max>min)){ return 0; }
+    return int(ceil((max-min)/step - 1e-9));
+  }
+}
+
+CrGeomagneticGrid::CrGeomagneticGrid()
+  : m_year(0)
+{
+  setLatitudeRange(-30.0, 30.0, 1.0);
+  setLongitudeStep(2.0);
+  setAltitudeRange(450.0, 650.0, 50.0);
+}
+
+CrGeomagneticGrid::~CrGeomagneticGrid()
+{
+  ;
+}
+
+void CrGeomagneticGrid::setLatitudeRange(double min, double max, double step)
+{
+  m_latMin = min;
+  m_latStep = step;
+  m_nLat = cells(min, max, step) + 1;
+  m_year = 0;
+  m_values.clear();
+}
+
+void CrGeomagneticGrid::setLongitudeStep(double step)
+{
+  m_nLon = cells(0.0, 360.0, step);
+  m_lonStep = m_nLon>0 ? 360.0/m_nLon : 360.0;
+  m_year = 0;
+  m_values.clear();
+}
+
+void CrGeomagneticGrid::setAltitudeRange(double min, double max, double step)
+{
+  m_altMin = min;
+  m_altStep = step;
+  m_nAlt = cells(min, max, step) + 1;
+  m_year = 0;
+  m_values.clear();
+}
+
+bool CrGeomagneticGrid::valid() const
+{
+  return m_year != 0;
+}
+
+int CrGeomagneticGrid::year() const
+{
+  return m_year;
+}
+
+unsigned int CrGeomagneticGrid::index(int ilat, int ilon, int ialt) const
+{
+  return ((ialt*m_nLat + ilat)*m_nLon + ilon)*nValue;
+}
+
+// Evaluate the model at one position
+void CrGeomagneticGrid::evaluate(double latitude, double longitude,
+                                 double altitude, double year, double* values)
+{
+  astro::IGRField::Model().compute(latitude, longitude, altitude, year);
+  values[lambda] = astro::IGRField::Model().lambda();
+  values[R] = astro::IGRField::Model().R();
+  values[L] = astro::IGRField::Model().L();
+  values[B] = astro::IGRField::Model().B();
+  values[cutOffRigidity] = astro::IGRField::Model().verticalRigidityCutoff();
+}
+
+// Evaluate the model at all the nodes, at the middle of the year
+void CrGeomagneticGrid::build(int year)
+{
+  m_values.resize(m_nLat*m_nLon*m_nAlt*nValue);
+  for (int ialt = 0; ialt < m_nAlt; ialt++){
+    for (int ilat = 0; ilat < m_nLat; ilat++){
+      for (int ilon = 0; ilon < m_nLon; ilon++){
+        evaluate(m_latMin+ilat*m_latStep, ilon*m_lonStep, m_altMin+ialt*m_altStep,
+                 year+0.5, &m_values[index(ilat, ilon, ialt)]);
+      }
+    }
+  }
+  m_year = year;
+}
+
+// Read the grid of the year from a file
+bool CrGeomagneticGrid::load(const std::string& fileName, int year)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  if (!file){ return false; }
+
+  char tag[8];
+  int header[4];
+  double extent[5];
+  file.read(tag, sizeof(tag));
+  file.read(reinterpret_cast<char*>(header), sizeof(header));
+  file.read(reinterpret_cast<char*>(extent), sizeof(extent));
+  if (!file || memcmp(tag, fileTag, sizeof(tag)) != 0){ return false; }
+  if (header[0] != year || header[1] != m_nLat || header[2] != m_nLon
+      || header[3] != m_nAlt || extent[0] != m_latMin || extent[1] != m_latStep
+      || extent[2] != m_lonStep || extent[3] != m_altMin || extent[4] != m_altStep){
+    return false;
+  }
+
+  std::vector<double> values(m_nLat*m_nLon*m_nAlt*nValue);
+  file.read(reinterpret_cast<char*>(&values[0]), values.size()*sizeof(double));
+  if (!file){ return false; }
+  m_values.swap(values);
+  m_year = year;
+  return true;
+}
+
+// Write the grid to a file
+bool CrGeomagneticGrid::save(const std::string& fileName) const
+{
+  if (!valid()){ return false; }
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  if (!file){ return false; }
+
+  int header[4] = {m_year, m_nLat, m_nLon, m_nAlt};
+  double extent[5] = {m_latMin, m_latStep, m_lonStep, m_altMin, m_altStep};
+  file.write(fileTag, sizeof(fileTag));
+  file.write(reinterpret_cast<const char*>(header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(extent), sizeof(extent));
+  file.write(reinterpret_cast<const char*>(&m_values[0]), m_values.size()*sizeof(double));
+  return bool(file);
+}
+
+// Trilinear interpolation in latitude, longitude and altitude
+bool CrGeomagneticGrid::interpolate(double latitude, double longitude,
+                                    double altitude, double* values) const
+{
+  if (!valid()){ return false; }
+
+  double x = (latitude-m_latMin)/m_latStep;
+  double z = m_nAlt>1 ? (altitude-m_altMin)/m_altStep : 0;
+  if (!(x >= 0 && x <= m_nLat-1)){ return false; }
+  if (!(z >= 0 && z <= m_nAlt-1)){ return false; }
+
+  // the longitude wraps around
+  double y = fmod(longitude, 360.0);
+  if (y < 0){ y += 360.0; }
+  y /= m_lonStep;
+
+  int ilat = int(x);
+  int ilon = int(y);
+  int ialt = int(z);
+  if (ilat >= m_nLat-1){ ilat = m_nLat>1 ? m_nLat-2 : 0; }
+  if (ialt >= m_nAlt-1){ ialt = m_nAlt>1 ? m_nAlt-2 : 0; }
+  if (ilon >= m_nLon){ ilon = m_nLon-1; }
+  double fx = m_nLat>1 ? x-ilat : 0;
+  double fy = y-ilon;
+  double fz = m_nAlt>1 ? z-ialt : 0;
+  int jlat = m_nLat>1 ? ilat+1 : ilat;
+  int jlon = (ilon+1) % m_nLon;
+  int jalt = m_nAlt>1 ? ialt+1 : ialt;
+
+  const double* c000 = &m_values[index(ilat, ilon, ialt)];
+  const double* c100 = &m_values[index(jlat, ilon, ialt)];
+  const double* c010 = &m_values[index(ilat, jlon, ialt)];
+  const double* c110 = &m_values[index(jlat, jlon, ialt)];
+  const double* c001 = &m_values[index(ilat, ilon, jalt)];
+  const double* c101 = &m_values[index(jlat, ilon, jalt)];
+  const double* c011 = &m_values[index(ilat, jlon, jalt)];
+  const double* c111 = &m_values[index(jlat, jlon, jalt)];
+  for (int k = 0; k < nValue; k++){
+    double v00 = c000[k] + fx*(c100[k]-c000[k]);
+    double v10 = c010[k] + fx*(c110[k]-c010[k]);
+    double v01 = c001[k] + fx*(c101[k]-c001[k]);
+    double v11 = c011[k] + fx*(c111[k]-c011[k]);
+    double v0 = v00 + fy*(v10-v00);
+    double v1 = v01 + fy*(v11-v01);
+    values[k] = v0 + fz*(v1-v0);
+  }
+  return true;
+}
+
+// Largest relative deviation from the direct evaluation
+double CrGeomagneticGrid::validate(int nSample) const
+{
+  if (!valid()){ return 0; }
+  int nlatCell = m_nLat>1 ? m_nLat-1 : 1;
+  int naltCell = m_nAlt>1 ? m_nAlt-1 : 1;
+  int ncell = nlatCell*m_nLon*naltCell;
+  if (nSample > ncell){ nSample = ncell; }
+
+  double worst = 0;
+  double grid[nValue], direct[nValue];
+  for (int i = 0; i < nSample; i++){
+    // spread the samples over the cells with a stride prime to ncell
+    int cell = int((i*7919LL) % ncell);
+    int ilon = cell % m_nLon;
+    int ilat = (cell/m_nLon) % nlatCell;
+    int ialt = cell/(m_nLon*nlatCell);
+    double lat = m_latMin + (ilat + (m_nLat>1 ? 0.5 : 0))*m_latStep;
+    double lon = (ilon+0.5)*m_lonStep;
+    double alt = m_altMin + (ialt + (m_nAlt>1 ? 0.5 : 0))*m_altStep;
+    interpolate(lat, lon, alt, grid);
+    evaluate(lat, lon, alt, m_year, direct);
+    for (int k = 0; k < nValue; k++){
+      double scale = (k == lambda) ? M_PI/2 : fabs(direct[k]);
+      if (!(scale > 0)){ continue; }
+      double deviation = fabs(grid[k]-direct[k])/scale;
+      if (deviation > worst){ worst = deviation; }
+    }
+  }
+  return worst;
+}
@@ -0,0 +1,81 @@
+/**
+ * CrGeomagneticGrid:
+ *  The IGRF quantities used by the components tabulated on a
+ *  (latitude, longitude, altitude) grid for one model year.
+ */
+
+//$Header$
+
+#ifndef CrGeomagneticGrid_H
+#define CrGeomagneticGrid_H
+
+#include <string>
+#include <vector>
+
+/** @class CrGeomagneticGrid
+ *  @brief tabulated geomagnetic field for fast lookups along an orbit
+ *
+ * lambda, R, L, B and the vertical cutoff rigidity from
+ * astro::IGRField are computed at the nodes of a regular grid in
+ * geographic latitude, longitude and altitude, at the middle of a
+ * model year, and interpolated trilinearly in between.  The grid can
+ * be written to and read back from a binary file so that the model is
+ * evaluated on the grid once per model year and not at every start.
+ * Positions outside the grid are left to the direct evaluation.
+ * The caller must hold the lock of the IGRField model (see
+ * CrGeomagneticState) while the grid is built or validated.
+ */
+class CrGeomagneticGrid
+{
+public:
+  /// Quantities stored at each node
+  enum Value { lambda, R, L, B, cutOffRigidity, nValue };
+
+  CrGeomagneticGrid();
+  ~CrGeomagneticGrid();
+
+  /// Set the extent of the grid: latitude [deg], altitude [km].
+  /// The longitude always covers 360 deg.  The table is cleared.
+  void setLatitudeRange(double min, double max, double step);
+  void setLongitudeStep(double step);
+  void setAltitudeRange(double min, double max, double step);
+
+  /// Evaluate the model at all the nodes for the year
+  void build(int year);
+
+  /// Read the grid of the year from a file written by save(); false if
+  /// the file does not exist or was made for another year or extent.
+  bool load(const std::string& fileName, int year);
+  bool save(const std::string& fileName) const;
+
+  /// true if the table holds a model year
+  bool valid() const;
+  int year() const;
+
+  /// Interpolate the quantities at a position; false if it is
+  /// outside the grid.
+  bool interpolate(double latitude, double longitude, double altitude,
+                   double* values) const;
+
+  /// Gives back the largest relative deviation of the interpolation
+  /// from the direct evaluation, at the centres of nSample cells and at
+  /// the start of the model year (lambda relative to pi/2).
+  double validate(int nSample) const;
+
+private:
+  // Evaluate the model at one position
+  static void evaluate(double latitude, double longitude, double altitude,
+                       double year, double* values);
+
+  unsigned int index(int ilat, int ilon, int ialt) const;
+
+  double m_latMin, m_latStep;
+  double m_lonStep;
+  double m_altMin, m_altStep;
+  int m_nLat, m_nLon, m_nAlt;
+
+  int m_year; ///< model year of the table, 0 if empty
+  std::vector<double> m_values; ///< nValue numbers per node
+};
+
+#endif // CrGeomagneticGrid_H
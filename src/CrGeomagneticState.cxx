@@ -0,0 +1,168 @@
+/****************************************************************************
+ * CrGeomagneticState.cxx:
+ ****************************************************************************
+ * The IGRF field model and the geomagnetic coordinates are evaluated
+ * once per satellite position and shared by all the components which
+ * are notified of the position by GPS.  With useGrid() the model is
+ * interpolated in a grid prepared once per model year.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+#include "CrGeomagneticState.hh"
+#include "CrCoordinateTransfer.hh"
+
+#include "astro/IGRField.h"
+
+namespace {
+  // Gives back the cache file of the grid of the year: the year is put
+  // before the extension of the name given, "grid.dat" -> "grid_2008.dat"
+  std::string yearFile(const std::string& fileName, int year)
+  {
+    std::string::size_type dot = fileName.rfind('.');
+    std::string::size_type slash = fileName.rfind('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)){
+      dot = fileName.size();
+    }
+    std::ostringstream name;
+    name << fileName.substr(0, dot) << "_" << year << fileName.substr(dot);
+    return name.str();
+  }
+}
+
+// Singleton; the local static is constructed once even with threads
+CrGeomagneticState* CrGeomagneticState::instance()
+{
+  static CrGeomagneticState s_instance;
+  return &s_instance;
+}
+
+CrGeomagneticState::CrGeomagneticState()
+  : m_generation(1), m_hits(0), m_misses(0),
+    m_useGrid(false), m_gridTolerance(0.01), m_gridYear(0), m_gridAccepted(false)
+{
+  ;
+}
+
+// Gives back the field at the position
+CrGeomagneticState::Field CrGeomagneticState::field
+(double latitude, double longitude, double time, double altitude)
+{
+  // the last position of this thread
+  static thread_local unsigned long s_generation = 0;
+  static thread_local Field s_field;
+
+  if (s_generation == m_generation && latitude == s_field.latitude
+      && longitude == s_field.longitude
+      && time == s_field.time && altitude == s_field.altitude){
+    m_hits++;
+    return s_field;
+  }
+  m_misses++;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  s_field.latitude = latitude;
+  s_field.longitude = longitude;
+  s_field.time = time;
+  s_field.altitude = altitude;
+
+  CrCoordinateTransfer transfer;
+  s_field.geomagneticLatitude = transfer.geomagneticLatitude(latitude, longitude);
+  s_field.geomagneticLongitude = transfer.geomagneticLongitude(latitude, longitude);
+
+  // year based on time in s after 11-01-2001
+  float year = (time+304.*86400.)/(365.*86400.)+2001. ;
+
+  double values[CrGeomagneticGrid::nValue];
+  bool fromGrid = false;
+  if (m_useGrid){
+    int modelYear = int(floor(year));
+    if (modelYear != m_gridYear){ prepareGrid(modelYear); }
+    fromGrid = m_gridAccepted && m_grid.interpolate(latitude, longitude, altitude, values);
+  }
+  if (fromGrid){
+    s_field.lambda = values[CrGeomagneticGrid::lambda];
+    s_field.R = values[CrGeomagneticGrid::R];
+    s_field.cutOffRigidity = values[CrGeomagneticGrid::cutOffRigidity];
+    s_field.L = values[CrGeomagneticGrid::L];
+    s_field.B = values[CrGeomagneticGrid::B];
+  } else {
+    astro::IGRField::Model().compute(latitude,longitude,altitude,year);
+
+    // the relation between r and lambda and the McIlwain L is
+    // cos(lambda)^2 = R/L
+    s_field.lambda = astro::IGRField::Model().lambda();
+    s_field.R = astro::IGRField::Model().R();
+    s_field.cutOffRigidity = astro::IGRField::Model().verticalRigidityCutoff();
+    s_field.L = astro::IGRField::Model().L();
+    s_field.B = astro::IGRField::Model().B();
+  }
+
+  s_generation = m_generation;
+  return s_field;
+}
+
+void CrGeomagneticState::useGrid(bool on, const std::string& cacheFile,
+                                 double tolerance)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_useGrid = on;
+  m_gridFile = cacheFile;
+  m_gridTolerance = tolerance;
+  m_gridYear = 0;
+  m_gridAccepted = false;
+  m_generation++;
+}
+
+bool CrGeomagneticState::gridActive() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_useGrid && m_gridAccepted;
+}
+
+// Get the grid of the model year ready and check its accuracy
+void CrGeomagneticState::prepareGrid(int year)
+{
+  using std::cout;
+  using std::endl;
+
+  m_gridYear = year;
+  // one file per year, so that a run across years keeps them all
+  std::string fileName = m_gridFile.empty() ? m_gridFile : yearFile(m_gridFile, year);
+  if (fileName.empty() || !m_grid.load(fileName, year)){
+    cout << "CrGeomagneticState: computing the geomagnetic grid for " << year << endl;
+    m_grid.build(year);
+    if (!fileName.empty() && !m_grid.save(fileName)){
+      cout << "CrGeomagneticState: cannot write " << fileName << endl;
+    }
+  }
+
+  double deviation = m_grid.validate(500);
+  m_gridAccepted = deviation <= m_gridTolerance;
+  if (!m_gridAccepted){
+    cout << "CrGeomagneticState: the grid deviates by " << deviation
+         << " from the field model (tolerance " << m_gridTolerance
+         << "); the model is evaluated directly" << endl;
+  }
+}
+
+unsigned long CrGeomagneticState::hits() const
+{
+  return m_hits;
+}
+
+unsigned long CrGeomagneticState::misses() const
+{
+  return m_misses;
+}
+
+void CrGeomagneticState::resetCounters()
+{
+  m_hits = 0;
+  m_misses = 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * CrGeomagneticState:
+ *  The geomagnetic quantities at the current satellite position,
+ *  shared by all the CrSpectrum components.
+ */
+
+//$Header$
+
+#ifndef CrGeomagneticState_H
+#define CrGeomagneticState_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "CrGeomagneticGrid.hh"
+
+/** @class CrGeomagneticState
+ *  @brief per-position cache of the geomagnetic field model
+ *
+ * Every component follows the GPS position and needs the same
+ * quantities from astro::IGRField and CrCoordinateTransfer.  The
+ * first component notified of a new position computes them; the
+ * others get the stored values.  The cache holds one position per
+ * thread, which is what a GPS update produces; the components of
+ * several threads (CrParallelGenerator) each keep their own.
+ * Optionally the model is interpolated in a CrGeomagneticGrid
+ * computed once per model year.
+ * astro::IGRField::Model() is one instance shared by the process,
+ * so it is only used under the lock of this class.
+ */
+class CrGeomagneticState
+{
+public:
+  /// Geomagnetic quantities at one position
+  struct Field {
+    double latitude;             ///< geographic [deg]
+    double longitude;            ///< geographic [deg]
+    double time;                 ///< [s]
+    double altitude;             ///< [km]
+    double geomagneticLatitude;  ///< from CrCoordinateTransfer [deg]
+    double geomagneticLongitude; ///< from CrCoordinateTransfer [deg]
+    double lambda;               ///< [rad]
+    double R;                    ///< [R_earth]
+    double L;                    ///< McIlwain L [R_earth]
+    double B;                    ///< field strength as given by astro::IGRField
+    double cutOffRigidity;       ///< vertical cutoff, not restricted [GV]
+  };
+
+  static CrGeomagneticState* instance();
+
+  /// Gives back the field at the position; the model is evaluated
+  /// only if the position differs from the one of the previous call.
+  Field field(double latitude, double longitude, double time, double altitude);
+
+  /// Interpolate the field in a grid for the positions it covers.
+  /// The grid of a model year is read from its file if it is there,
+  /// otherwise computed and written to it: cacheFile (if not empty)
+  /// with the year before the extension, e.g. grid_2008.dat.
+  /// It is used only if its largest deviation from the direct
+  /// evaluation, relative to the value, is below tolerance.
+  void useGrid(bool on, const std::string& cacheFile="", double tolerance=0.01);
+
+  /// true if the field of the current model year comes from the grid
+  bool gridActive() const;
+
+  /// Number of calls answered from the cache and computed
+  unsigned long hits() const;
+  unsigned long misses() const;
+  void resetCounters();
+
+private:
+  CrGeomagneticState();
+
+  // Get the grid of the model year ready and check its accuracy
+  void prepareGrid(int year);
+
+  mutable std::mutex m_mutex;
+  std::atomic<unsigned long> m_generation; ///< changed by useGrid()
+  std::atomic<unsigned long> m_hits;
+  std::atomic<unsigned long> m_misses;
+
+  bool m_useGrid;
+  std::string m_gridFile;
+  double m_gridTolerance;
+  int m_gridYear;       ///< model year prepared, 0 if none
+  bool m_gridAccepted;  ///< the grid of m_gridYear passed the validation
+  CrGeomagneticGrid m_grid;
+};
+
+#endif // CrGeomagneticState_H
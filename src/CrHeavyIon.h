@@ -12,6 +12,7 @@
 #include <utility>
 #include <string>
 #include "flux/Spectrum.h"
+#include "CrComponentMix.hh"
 
 class CrSpectrum;
 class CLHEP::HepRandomEngine;
@@ -29,9 +30,21 @@ public:
 
    // Gives back component in the ratio of the flux
   CrSpectrum* selectComponent();
+
+  // Set the random engine of the source and of its components, by
+  // default the global CLHEP engine (that of FluxSvc)
+  void setEngine(CLHEP::HepRandomEngine* engine);
    
   //virtual double energy();
     std::pair<double,double> dir(double energy);
+
+    // Fill n particles: kinetic energy [GeV], cos(theta) and phi[rad].
+    // The ion of every particle is drawn in the ratio of the abundances
+    // (or is the one Z of the source), so a block mixes the species;
+    // ion[i], if given, is set to the index of the ion of particle i
+    // in CrIonSpecies, whose name is that of the particle.
+    void sampleBlock(int n, double* energy, double* cosTheta, double* phi,
+                     const CrSpectrum** source=0, unsigned int* ion=0);
     
     //! calculate the flux, particles/m^2/sr.
     virtual double    flux (double time ) const;
@@ -46,6 +59,7 @@ public:
     void dump();
 private:
  std::vector<CrSpectrum*>  m_subComponents;
+ CrComponentMix            m_mix;
   CrSpectrum*               m_component;
   CLHEP::HepRandomEngine* m_engine;    
 };
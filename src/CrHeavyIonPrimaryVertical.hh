@@ -10,8 +10,10 @@
 
 #include <utility>
 #include <string>
+#include <vector>
 
 #include "CrSpectrum.hh"
+#include "CrPrimarySpectrum.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
@@ -22,17 +24,9 @@ public:
   CrHeavyIonPrimaryVertical();
   ~CrHeavyIonPrimaryVertical();
 
-  // Set satellite position, altitude and observation time and
-  // calculate energies related to COR.
-  // These energies will be used to generate particles.
-  void setPosition(double latitude, double longitude);
-  void setPosition(double latitude, double longitude, double time);
-  void setPosition(double latitude, double longitude, double time, 
-		   double altitude);
-  
-  // Set geomagnetic cutoff rigidity and calculate the energies related.
-  // These energies are used to generate the particle. 
-  void setCutOffRigidity(double cor);
+  // Set the random engine used to select the ion in solidAngle().
+  // It is the engine of CLHEP::HepRandom by default.
+  void setEngine(CLHEP::HepRandomEngine* engine);
 
   // Gives back particle direction in (cos(theta), phi)
   std::pair<double,double> dir(double energy, CLHEP::HepRandomEngine* engine) const;
@@ -40,11 +34,24 @@ public:
   // Gives back particle energy
   double energySrc(CLHEP::HepRandomEngine* engine) const;
 
+  // Fill n particles, each of an ion drawn in the ratio of the
+  // abundances (see CrIonSpecies); ion[i], if given, is set to the
+  // index in CrIonSpecies of the ion of particle i.  particleName()
+  // gives back afterwards the name of the last particle.
+  void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                   double* energy, double* cosTheta, double* phi,
+                   unsigned int* ion) const;
+  // The same without the ions: the block still mixes the species,
+  // which this form does not give back
+  void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                   double* energy, double* cosTheta, double* phi) const;
+
   // flux() returns the value averaged over the region from which
   // the particle is coming from and the unit is [c/s/m^2/sr]
   double flux() const;
 
-  // Gives back solid angle from which particle comes
+  // Gives back solid angle from which particle comes; selects the ion
+  // of the next particles (see CrIonSpecies)
   double solidAngle() const;
 
   // Gives back particle name
@@ -52,6 +59,16 @@ public:
   // Gives back the name of the component
   std::string title() const;
 
+private:
+  // Gives back the energy sampler of the ion of index ion, made at
+  // its first particle in the bin of (cor, phi)
+  const CrPrimarySampler& sampler(unsigned int ion) const;
+
+  // Index of the ion in CrIonSpecies; solidAngle() selects it, hence
+  // mutable, as are the samplers made on demand.
+  mutable unsigned int m_ion;
+  mutable std::vector<CrPrimarySampler> m_samplers; ///< per ion
+  CLHEP::HepRandomEngine* m_engine;
 };
   
 #endif // CrHeavyIonPrimaryVertical_H
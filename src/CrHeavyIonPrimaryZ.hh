@@ -12,6 +12,7 @@
 #include <string>
 
 #include "CrSpectrum.hh"
+#include "CrPrimarySpectrum.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
@@ -19,27 +20,24 @@ class CLHEP::HepRandomEngine;
 class CrHeavyIonPrimaryZ : public CrSpectrum
 {
 public:  
+  // z is the atomic number of the ion, one of CrIonSpecies
   CrHeavyIonPrimaryZ(int z);
   ~CrHeavyIonPrimaryZ();
 
-  // Set satellite position, altitude and observation time and
-  // calculate energies related to COR.
-  // These energies will be used to generate particles.
-  void setPosition(double latitude, double longitude);
-  void setPosition(double latitude, double longitude, double time);
-  void setPosition(double latitude, double longitude, double time, 
-		   double altitude);
-  
-  // Set geomagnetic cutoff rigidity and calculate the energies related.
-  // These energies are used to generate the particle. 
-  void setCutOffRigidity(double cor);
-
   // Gives back particle direction in (cos(theta), phi)
   std::pair<double,double> dir(double energy, CLHEP::HepRandomEngine* engine) const;
 
   // Gives back particle energy
   double energySrc(CLHEP::HepRandomEngine* engine) const;
 
+  // Fill n particles at once
+  void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                   double* energy, double* cosTheta, double* phi) const;
+  // The same, with ion[i] set to the index of the ion in CrIonSpecies
+  void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                   double* energy, double* cosTheta, double* phi,
+                   unsigned int* ion) const;
+
   // flux() returns the value averaged over the region from which
   // the particle is coming from and the unit is [c/s/m^2/sr]
   double flux() const;
@@ -52,6 +50,14 @@ public:
   // Gives back the name of the component
   std::string title() const;
 
+private:
+  // Gives back the energy sampler of the ion, made at its first
+  // particle in the bin of (cor, phi)
+  const CrPrimarySampler& sampler() const;
+
+  unsigned int m_ion; ///< index of the ion in CrIonSpecies
+  mutable CrPrimarySampler m_sampler; ///< of the current bin of (cor, phi)
+  CLHEP::HepRandomEngine* m_engine;
 };
   
 #endif // CrHeavyIonPrimaryZ_H
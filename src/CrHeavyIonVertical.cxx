@@ -25,7 +25,6 @@
 
 #include <cstdlib>
 #include <cmath>
-#include <map>
 #include <vector>
 
 // CLHEP
@@ -59,6 +58,8 @@ CrHeavyIonVertical::CrHeavyIonVertical(const std::string& paramstring)
     m_subComponents.push_back(new CrHeavyIonPrimVertZ(params[0]));
     int z = params[0];
   
+    m_mix.setComponents(m_subComponents, false);
+
 // Not sure how to replace the following with CLHEP 1.9.2.2
     m_engine = CLHEP::HepRandom::getTheEngine(); //new HepJamesRandom;
 }
@@ -74,27 +75,23 @@ CrHeavyIonVertical::CrHeavyIonVertical(const std::string& paramstring)
 }
 
 
-// Gives back component in the ratio of the flux
-CrSpectrum* CrHeavyIonVertical::selectComponent()
+// Set the random engine of the source; the mixed-ion component
+// selects its species with it
+void CrHeavyIonVertical::setEngine(CLHEP::HepRandomEngine* engine)
 {
-  std::map<CrSpectrum*,G4double> integ_flux;
-  double total_flux = 0;
+  m_engine = engine;
   std::vector<CrSpectrum*>::iterator i;
-
-  // calculate the total flux 
   for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-    total_flux += (*i)->flux();
-    integ_flux[*i] = total_flux;
-  }
-  // select component based on the flux
-  G4double rnum = m_engine->flat() * total_flux;
-  for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-    if (integ_flux[*i] >= rnum) { break; }
+    (*i)->setEngine(engine);
   }
+}
 
-  m_component = *i;
 
-  return *i;
+// Gives back component in the ratio of the flux
+CrSpectrum* CrHeavyIonVertical::selectComponent()
+{
+  m_component = m_mix.select(m_engine);
+  return m_component;
 }
 
 // Gives back kinetic energy 
@@ -113,13 +110,21 @@ std::pair<G4double,G4double> CrHeavyIonVertical::dir(G4double energy)
   return m_component->dir(energy, m_engine);
 }
 
+// Fill n particles at once
+void CrHeavyIonVertical::sampleBlock(int n, G4double* energy, G4double* cosTheta,
+                                    G4double* phi, const CrSpectrum** source,
+                                    unsigned int* ion)
+{
+  m_mix.sampleBlock(m_engine, n, energy, cosTheta, phi, source, ion);
+}
+
 // Gives back the total flux (summation of each component's flux)
 G4double CrHeavyIonVertical::flux(G4double /* time */ ) const
 {
   G4double total_flux = 0;
   std::vector<CrSpectrum*>::const_iterator i;
   for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-    total_flux += (*i)->flux();
+    total_flux += (*i)->cachedFlux();
     //    std::cout << "flux of this component = " << (*i)->flux() << std::endl;
   }
   return total_flux;
@@ -144,7 +149,7 @@ void CrHeavyIonVertical::dump()
   std::vector<CrSpectrum*>::const_iterator i;
   for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
     std::cout << "title: " << (*i)->title() << std::endl;
-    std::cout << " flux(c/s/m^2/sr)= " << (*i)->flux() << std::endl;
+    std::cout << " flux(c/s/m^2/sr)= " << (*i)->cachedFlux() << std::endl;
     std::cout << " geographic latitude/longitude(deg)= " 
          << (*i)->latitude() << " " << (*i)->longitude() << std::endl;
     std::cout << " geomagnetic latitude/longitude(deg)= " 
@@ -0,0 +1,104 @@
+/****************************************************************************
+ * CrInverseCDF.cxx:
+ ****************************************************************************
+ * A tabulated cumulative distribution. The spectrum generators use it
+ * to replace accept/reject loops by a single inversion of a table
+ * which is rebuilt only when the parameters of the spectrum change.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <algorithm>
+
+#include "CrInverseCDF.hh"
+
+CrInverseCDF::CrInverseCDF()
+  : m_total(0)
+{
+  ;
+}
+
+CrInverseCDF::~CrInverseCDF()
+{
+  ;
+}
+
+// Fill the table from the cumulative integral
+void CrInverseCDF::setCumulative(const std::vector<double>& x,
+                                 const std::vector<double>& cumulative)
+{
+  m_x = x;
+  m_cdf.resize(cumulative.size());
+  m_total = cumulative.empty() ? 0 : cumulative.back()-cumulative.front();
+  for (unsigned int i = 0; i < cumulative.size(); i++){
+    m_cdf[i] = m_total>0 ? (cumulative[i]-cumulative.front())/m_total : 0;
+  }
+  if (m_total>0){ m_cdf.back() = 1.0; }
+
+  // guide table: upper end of the interval of k/nGuide
+  m_guide.clear();
+  unsigned int n = m_cdf.size();
+  if (n < 2){ return; }
+  unsigned int nGuide = n-1;
+  m_guide.resize(nGuide+1);
+  unsigned int i = 1;
+  for (unsigned int k = 0; k <= nGuide; k++){
+    double r = double(k)/nGuide;
+    while (i < n-1 && m_cdf[i] <= r){ i++; }
+    m_guide[k] = i;
+  }
+}
+
+// Fill the table from the density using the trapezoidal rule
+void CrInverseCDF::setDensity(const std::vector<double>& x,
+                              const std::vector<double>& density)
+{
+  std::vector<double> cumulative(x.size(), 0.0);
+  for (unsigned int i = 1; i < x.size(); i++){
+    cumulative[i] = cumulative[i-1]
+      + 0.5*(density[i-1]+density[i])*(x[i]-x[i-1]);
+  }
+  setCumulative(x, cumulative);
+}
+
+void CrInverseCDF::clear()
+{
+  m_x.clear();
+  m_cdf.clear();
+  m_guide.clear();
+  m_total = 0;
+}
+
+bool CrInverseCDF::empty() const
+{
+  return m_x.size()<2 || !(m_total>0);
+}
+
+double CrInverseCDF::total() const
+{
+  return m_total;
+}
+
+// Gives back x for a uniform random number r
+double CrInverseCDF::sample(double r) const
+{
+  // first node with cdf > r; the interval is [i-1, i]
+  unsigned int i;
+  unsigned int n = m_cdf.size();
+  // a table of less than two nodes has no interval to search
+  if (n < 2){ return n ? m_x.front() : 0; }
+  if (r >= 0 && r <= 1 && !m_guide.empty()){
+    i = m_guide[(unsigned int)(r*(m_guide.size()-1))];
+    // the guide node may be off where r*nGuide was rounded
+    while (i > 1 && m_cdf[i-1] > r){ i--; }
+    while (i < n-1 && m_cdf[i] <= r){ i++; }
+  } else {
+    std::vector<double>::const_iterator it =
+      std::upper_bound(m_cdf.begin()+1, m_cdf.end()-1, r);
+    i = it - m_cdf.begin();
+  }
+  double dc = m_cdf[i]-m_cdf[i-1];
+  if (dc<=0){ return m_x[i-1]; }
+  return m_x[i-1] + (r-m_cdf[i-1])/dc * (m_x[i]-m_x[i-1]);
+}
@@ -0,0 +1,62 @@
+/**
+ * CrInverseCDF:
+ *  A tabulated cumulative distribution which is sampled by inversion.
+ */
+
+//$Header$
+
+#ifndef CrInverseCDF_H
+#define CrInverseCDF_H
+
+#include <vector>
+
+/** @class CrInverseCDF
+ *  @brief tabulated cumulative distribution sampled by inversion
+ *
+ * The distribution is given on an increasing grid of abscissae x[i]
+ * together with either its density or its cumulative integral.
+ * A uniform random number r is converted into x by a search for the
+ * interval c[i] <= r < c[i+1] of the normalised cumulative
+ * distribution and a linear interpolation within that interval.
+ * The search starts from a guide table, one entry per interval, which
+ * points next to the interval of k/(number of intervals).
+ * Building the table is the expensive part; a sample costs one
+ * random number, a short search and one interpolation.
+ */
+class CrInverseCDF
+{
+public:
+  CrInverseCDF();
+  ~CrInverseCDF();
+
+  /// Fill the table from the cumulative integral c[i] at x[i].
+  /// x must be increasing and c non-decreasing.
+  void setCumulative(const std::vector<double>& x,
+                     const std::vector<double>& cumulative);
+
+  /// Fill the table from the density f[i] at x[i].
+  /// The density is integrated with the trapezoidal rule.
+  void setDensity(const std::vector<double>& x,
+                  const std::vector<double>& density);
+
+  /// Remove the table
+  void clear();
+
+  /// true if the table has not been filled or has a zero integral
+  bool empty() const;
+
+  /// Gives back the integral of the density over the whole table
+  double total() const;
+
+  /// Gives back x for a uniform random number r in [0,1]; the only
+  /// abscissa of a table of one node, 0 for a table not filled
+  double sample(double r) const;
+
+private:
+  std::vector<double> m_x;   ///< abscissae
+  std::vector<double> m_cdf; ///< cumulative distribution normalised to 1
+  double m_total;            ///< integral before normalisation
+  std::vector<unsigned int> m_guide; ///< interval of k/(m_guide.size()-1)
+};
+
+#endif // CrInverseCDF_H
@@ -0,0 +1,69 @@
+/****************************************************************************
+ * CrIonSpecies.cxx:
+ ****************************************************************************
+ * The abundances were kept as the cumulative distribution of
+ * get_z_ion() in the heavy ion components, which scanned it for every
+ * ion drawn; the alias table gives the same distribution in one step.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include "CrIonSpecies.hh"
+
+// private function definitions.
+namespace {
+  // atomic number, mass number, name and abundance (C = O = 100)
+  struct Entry {
+    int z;
+    double A;
+    const char* name;
+    double abundance;
+  };
+
+  const Entry entries[] = {
+    { 3,  7., "Li",  10.0}, { 4,  9., "Be",  10.0}, { 5, 11., "B",   25.0},
+    { 6, 12., "C",  100.0}, { 7, 14., "N",   25.0}, { 8, 16., "O",  100.0},
+    { 9, 19., "F",    2.0}, {10, 20., "Ne",  15.0}, {11, 23., "Na",   3.0},
+    {12, 24., "Mg",  20.0}, {13, 27., "Al",   3.0}, {14, 28., "Si",  16.0},
+    {15, 31., "P",    0.6}, {16, 32., "S",    3.0}, {17, 35., "Cl",   0.6},
+    {18, 40., "Ar",   1.0}, {19, 39., "K",    0.8}, {20, 40., "Ca",   2.0},
+    {21, 45., "Sc",   0.3}, {22, 48., "Ti",   1.0}, {23, 51., "V",    0.6},
+    {24, 52., "Cr",   1.0}, {25, 55., "Mn",   1.0}, {26, 56., "Fe",  11.0}
+  };
+
+  // rest energy per nucleon [GeV]
+  const double nucleonRestE = 0.931;
+}
+
+CrIonSpecies::CrIonSpecies()
+{
+  std::vector<double> weights;
+  for (unsigned int i = 0; i < sizeof(entries)/sizeof(entries[0]); i++){
+    Ion ion;
+    ion.z = entries[i].z;
+    ion.A = entries[i].A;
+    ion.restE = nucleonRestE*entries[i].A;
+    ion.name = entries[i].name;
+    ion.abundance = entries[i].abundance;
+    m_ions.push_back(ion);
+    weights.push_back(ion.abundance);
+  }
+  m_table.build(weights);
+}
+
+// Gives back the registry, made at the first call
+const CrIonSpecies& CrIonSpecies::instance()
+{
+  static const CrIonSpecies species;
+  return species;
+}
+
+// Gives back the index of the ion of atomic number z, or -1
+int CrIonSpecies::find(int z) const
+{
+  for (unsigned int i = 0; i < m_ions.size(); i++){
+    if (m_ions[i].z == z){ return i; }
+  }
+  return -1;
+}
@@ -0,0 +1,58 @@
+/**
+ * CrIonSpecies:
+ *  The species of the primary heavy ions (Li to Fe) with their
+ *  relative abundances.
+ */
+
+//$Header$
+
+#ifndef CrIonSpecies_H
+#define CrIonSpecies_H
+
+#include <vector>
+#include "CrAliasTable.hh"
+
+/** @class CrIonSpecies
+ *  @brief registry of the heavy ions and their choice by abundance
+ *
+ * The ions are those of CrHeavyIonPrimary, Z = 3 (Li) to 26 (Fe),
+ * with the abundances of J.J. Engelmann et al., A&A 233, 96 (1990),
+ * relative to C = O = 100; the mass number is that of the most
+ * abundant isotope.  select() draws an ion in the ratio of the
+ * abundances from an alias table, in constant time.
+ */
+class CrIonSpecies
+{
+public:
+  struct Ion {
+    int z;            ///< atomic number
+    double A;         ///< mass number
+    double restE;     ///< 0.931*A [GeV]
+    const char* name;
+    double abundance; ///< relative to C = O = 100
+  };
+
+  /// Gives back the registry
+  static const CrIonSpecies& instance();
+
+  /// Gives back the number of ions
+  unsigned int size() const { return m_ions.size(); }
+
+  /// Gives back ion i, in the order of Z
+  const Ion& operator[](unsigned int i) const { return m_ions[i]; }
+
+  /// Gives back the index of the ion of atomic number z, or -1
+  int find(int z) const;
+
+  /// Gives back the index of an ion drawn in the ratio of the
+  /// abundances, for a uniform random number r in [0, 1)
+  unsigned int select(double r) const { return m_table.index(r); }
+
+private:
+  CrIonSpecies();
+
+  std::vector<Ion> m_ions;
+  CrAliasTable m_table;
+};
+
+#endif // CrIonSpecies_H
@@ -0,0 +1,478 @@
+/****************************************************************************
+ * CrLatitudeBinnedModel.cxx:
+ ****************************************************************************
+ * Parameter tables of the secondary components sorted in geomagnetic
+ * latitude.  The spectral functions and their integrals are the ones of
+ * the former per-bin classes (CrProtonSubSplash.cxx and
+ * CrProtonSubReentrant.cxx), so that the same numbers come out.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// CLHEP
+#include <CLHEP/Random/RandomEngine.h>
+
+#include "CrLatitudeBinnedModel.hh"
+
+typedef double G4double;
+
+// private function definitions.
+namespace {
+  //------------------------------------------------------------
+  // cutoff power-law function: A*E^-a*exp(-(E/cut)^(-a+1)))
+
+  // integral of the cutoff power-law
+  inline G4double cutOffPowSpec2_integral
+  (G4double norm, G4double index, G4double cutOff, G4double E /* GeV */){
+    return norm * pow(cutOff, -index+1)/(index-1) *
+      exp(-pow(E/cutOff, -index+1));
+  }
+
+  // inverse function of the integral
+  inline G4double cutOffPowSpec2_integral_inv
+  (G4double norm, G4double index, G4double cutOff, G4double value){
+    return cutOff * pow(-log( (index-1)*value/(norm*pow(cutOff, -index+1)) ),
+			1./(-index+1));
+  }
+  //------------------------------------------------------------
+
+  //------------------------------------------------------------
+  // power-law
+
+  // integral of the power-law
+  inline G4double powSpec_integral
+  (G4double norm, G4double index, G4double E /* GeV */){
+    if (index==1){
+      return norm * log(E);
+    } else {
+      return norm * pow(E, -index+1) / (-index+1);
+    }
+  }
+
+  // inverse function of the integral of the power-law
+  inline G4double powSpec_integral_inv
+  (G4double norm, G4double index, G4double value){
+    if (index==1){
+      return exp(value/norm);
+    } else {
+      return pow( (-index+1)*value/norm, -1./(index-1));
+    }
+  }
+  //------------------------------------------------------------
+
+  inline G4double segmentIntegral
+  (const CrLatitudeBinnedModel::Segment& s, G4double E /* GeV */){
+    if (s.shape == CrLatitudeBinnedModel::cutOffPowerLaw){
+      return cutOffPowSpec2_integral(s.norm, s.index, s.cutOff, E);
+    }
+    return powSpec_integral(s.norm, s.index, E);
+  }
+
+  inline G4double segmentIntegral_inv
+  (const CrLatitudeBinnedModel::Segment& s, G4double value){
+    if (s.shape == CrLatitudeBinnedModel::cutOffPowerLaw){
+      return cutOffPowSpec2_integral_inv(s.norm, s.index, s.cutOff, value);
+    }
+    return powSpec_integral_inv(s.norm, s.index, value);
+  }
+}
+// end of namespace
+
+bool CrLatitudeBinnedModel::s_defaultCompatible = true;
+bool CrLatitudeBinnedModel::s_defaultBlended = false;
+
+CrLatitudeBinnedModel::Segment CrLatitudeBinnedModel::powerLawSegment
+(double norm, double index, double eMax)
+{
+  Segment s = {powerLaw, norm, index, 0, eMax};
+  return s;
+}
+
+CrLatitudeBinnedModel::Segment CrLatitudeBinnedModel::cutOffSegment
+(double norm, double index, double cutOff, double eMax)
+{
+  Segment s = {cutOffPowerLaw, norm, index, cutOff, eMax};
+  return s;
+}
+
+CrLatitudeBinnedModel::CrLatitudeBinnedModel()
+  : m_step(0), m_compatible(s_defaultCompatible), m_blended(s_defaultBlended)
+{
+  m_blend.node = -1;
+  m_blend.thetaM = 0;
+  m_blend.step = 0;
+}
+
+CrLatitudeBinnedModel::~CrLatitudeBinnedModel()
+{
+  ;
+}
+
+void CrLatitudeBinnedModel::addBin(const Bin& bin)
+{
+  m_bins.push_back(bin);
+  m_integrals.push_back(integrate(bin));
+  unsigned int n = m_bins.size();
+  m_step = n>1 ? (m_bins.back().latitude-m_bins.front().latitude)/(n-1) : 0;
+  m_blend.node = -1;
+}
+
+void CrLatitudeBinnedModel::clear()
+{
+  m_bins.clear();
+  m_integrals.clear();
+  m_step = 0;
+  m_blend.node = -1;
+}
+
+unsigned int CrLatitudeBinnedModel::size() const
+{
+  return m_bins.size();
+}
+
+const CrLatitudeBinnedModel::Bin& CrLatitudeBinnedModel::bin(unsigned int i) const
+{
+  return m_bins[i];
+}
+
+void CrLatitudeBinnedModel::setCompatible(bool compatible)
+{
+  m_compatible = compatible;
+}
+
+bool CrLatitudeBinnedModel::compatible() const
+{
+  return m_compatible;
+}
+
+void CrLatitudeBinnedModel::setBlended(bool blended)
+{
+  m_blended = blended;
+}
+
+bool CrLatitudeBinnedModel::blended() const
+{
+  return m_blended;
+}
+
+// Integrate the segments of a node, in the order the former classes did
+CrLatitudeBinnedModel::Integrals CrLatitudeBinnedModel::integrate(const Bin& bin) const
+{
+  Integrals in;
+  unsigned int n = bin.segments.size();
+  in.low.resize(n);
+  in.high.resize(n);
+  in.fraction.resize(n);
+  in.area = 0;
+  for (unsigned int k = 0; k < n; k++){
+    G4double lowE = k==0 ? bin.eMin : bin.segments[k-1].eMax;
+    in.low[k] = segmentIntegral(bin.segments[k], lowE);
+    in.high[k] = segmentIntegral(bin.segments[k], bin.segments[k].eMax);
+    in.area += in.high[k] - in.low[k];
+    in.fraction[k] = in.area;
+  }
+  for (unsigned int k = 0; k < n; k++){
+    in.fraction[k] = in.fraction[k] / in.area;
+  }
+
+  // Original model function is given in "/MeV" and the energy in "GeV".
+  // This is why 1000.* is required below.
+  // 1+2./3.*ang is to take the angular distribution into account
+  in.flux = 1000.*in.area*(1+2./3.*bin.ang);
+  return in;
+}
+
+// node i with latitude[i] <= thetaM < latitude[i+1]
+unsigned int CrLatitudeBinnedModel::lower(double thetaM) const
+{
+  unsigned int last = m_bins.size()-2;
+  unsigned int i = 0;
+  if (m_step > 0){
+    double x = (thetaM-m_bins.front().latitude)/m_step;
+    i = x < 0 ? 0 : (x > last ? last : (unsigned int)(x));
+  }
+  // the guess may be one node off where the nodes are not evenly spaced
+  while (i > 0 && thetaM < m_bins[i].latitude){ i--; }
+  while (i < last && thetaM >= m_bins[i+1].latitude){ i++; }
+  return i;
+}
+
+// Gives back the node to use at theta_M
+unsigned int CrLatitudeBinnedModel::select(double thetaM, CLHEP::HepRandomEngine* engine) const
+{
+  unsigned int n = m_bins.size();
+  if (n < 2 || thetaM < m_bins.front().latitude){ return 0; }
+  if (!(thetaM < m_bins.back().latitude)){ return n-1; }
+
+  unsigned int i = lower(thetaM);
+  double r1 = thetaM-m_bins[i].latitude;
+  double r2 = m_bins[i+1].latitude-thetaM;
+  if (engine->flat()*(r1+r2)<r2){
+    return i;
+  } else {
+    return i+1;
+  }
+}
+
+// Gives back the kinetic energy [GeV] of a particle of node i
+double CrLatitudeBinnedModel::energy(unsigned int i, CLHEP::HepRandomEngine* engine) const
+{
+  const Bin& bin = m_bins[i];
+  const Integrals& in = m_integrals[i];
+  unsigned int n = bin.segments.size();
+
+  G4double rnd = engine->flat();
+  unsigned int k = 0;
+  while (k+1 < n && !(rnd <= in.fraction[k])){ k++; }
+
+  G4double r;
+  if (m_compatible){
+    r = engine->flat() * (in.high[k] - in.low[k]) + in.low[k];
+  } else {
+    // the position of rnd within the share of segment k is uniform
+    G4double below = k==0 ? 0 : in.fraction[k-1];
+    G4double above = k+1==n ? 1 : in.fraction[k];
+    G4double u = above>below ? (rnd-below)/(above-below) : 0.5;
+    r = u * (in.high[k] - in.low[k]) + in.low[k];
+  }
+  return segmentIntegral_inv(bin.segments[k], r);
+}
+
+// Gives back the zenith angle of a particle of node i
+double CrLatitudeBinnedModel::theta(unsigned int i, CLHEP::HepRandomEngine* engine) const
+{
+  G4double ang = m_bins[i].ang;
+  G4double theta;
+  while(1){
+    theta = acos(engine->flat());
+    if ((engine->flat())*(1+fabs(ang))<=1+ang*sin(theta)*sin(theta)){break;}
+  }
+  return theta;
+}
+
+// Gives back the kinetic energy [GeV] of a particle at theta_M
+double CrLatitudeBinnedModel::sampleEnergy(double thetaM, CLHEP::HepRandomEngine* engine) const
+{
+  if (!m_blended){ return energy(select(thetaM, engine), engine); }
+  blend(thetaM);
+  return exp(m_blend.energy.sample(engine->flat()));
+}
+
+// Gives back the zenith angle of a particle at theta_M
+double CrLatitudeBinnedModel::sampleTheta(double thetaM, CLHEP::HepRandomEngine* engine) const
+{
+  if (!m_blended){ return theta(select(thetaM, engine), engine); }
+  blend(thetaM);
+  return acos(m_blend.theta.sample(engine->flat()));
+}
+
+// share of the flux of node i below E
+double CrLatitudeBinnedModel::cumulative(unsigned int i, double E) const
+{
+  const Bin& bin = m_bins[i];
+  const Integrals& in = m_integrals[i];
+  if (!(E > bin.eMin)){ return 0; }
+  G4double sum = 0;
+  for (unsigned int k = 0; k < bin.segments.size(); k++){
+    if (E < bin.segments[k].eMax){
+      sum += segmentIntegral(bin.segments[k], E) - in.low[k];
+      break;
+    }
+    sum += in.high[k] - in.low[k];
+  }
+  return sum / in.area;
+}
+
+// share of the particles of node i with cos(theta) below u; the density
+// in u=cos(theta) is 1+ang*(1-u^2)
+double CrLatitudeBinnedModel::cumulativeCosTheta(unsigned int i, double u) const
+{
+  G4double ang = m_bins[i].ang;
+  return (u + ang*(u - u*u*u/3.))/(1+2./3.*ang);
+}
+
+// Make the tables of the blended mode up to date for theta_M
+void CrLatitudeBinnedModel::blend(double thetaM) const
+{
+  unsigned int n = m_bins.size();
+  if (n == 0 || (m_blend.node >= 0 && thetaM == m_blend.thetaM)){ return; }
+
+  // the pair of nodes and the weight of the upper one
+  unsigned int i = 0;
+  double w = 0;
+  if (n > 1){
+    if (!(thetaM >= m_bins.front().latitude)){
+      i = 0;
+      w = 0;
+    } else if (!(thetaM < m_bins.back().latitude)){
+      i = n-2;
+      w = 1;
+    } else {
+      i = lower(thetaM);
+      double r1 = thetaM-m_bins[i].latitude;
+      double r2 = m_bins[i+1].latitude-thetaM;
+      w = r1/(r1+r2);
+    }
+  }
+  unsigned int j = n>1 ? i+1 : i;
+  int step = int(w*blendSteps + 0.5);
+  m_blend.thetaM = thetaM;
+  if (m_blend.node == int(i) && m_blend.step == step){ return; }
+
+  if (m_blend.node != int(i)){
+    // grid in log(E) over both nodes, with the ends of all the segments
+    G4double eMin = std::min(m_bins[i].eMin, m_bins[j].eMin);
+    G4double eMax = std::max(m_bins[i].segments.back().eMax, m_bins[j].segments.back().eMax);
+    int nodes = int(ceil(log10(eMax/eMin)*nodesPerDecade));
+    std::vector<double>& logE = m_blend.logE;
+    logE.clear();
+    for (int k = 0; k < nodes; k++){
+      logE.push_back(log(eMin) + k*(log(eMax)-log(eMin))/nodes);
+    }
+    logE.push_back(log(eMax));
+    for (unsigned int k = 0; k < m_bins[i].segments.size(); k++){
+      logE.push_back(log(m_bins[i].segments[k].eMax));
+    }
+    for (unsigned int k = 0; k < m_bins[j].segments.size(); k++){
+      logE.push_back(log(m_bins[j].segments[k].eMax));
+    }
+    logE.push_back(log(m_bins[i].eMin));
+    logE.push_back(log(m_bins[j].eMin));
+    std::sort(logE.begin(), logE.end());
+    logE.erase(std::unique(logE.begin(), logE.end()), logE.end());
+
+    m_blend.energyLow.resize(logE.size());
+    m_blend.energyHigh.resize(logE.size());
+    for (unsigned int k = 0; k < logE.size(); k++){
+      m_blend.energyLow[k] = cumulative(i, exp(logE[k]));
+      m_blend.energyHigh[k] = cumulative(j, exp(logE[k]));
+    }
+
+    m_blend.cosTheta.resize(nodesCosTheta);
+    m_blend.thetaLow.resize(nodesCosTheta);
+    m_blend.thetaHigh.resize(nodesCosTheta);
+    for (int k = 0; k < nodesCosTheta; k++){
+      double u = double(k)/(nodesCosTheta-1);
+      m_blend.cosTheta[k] = u;
+      m_blend.thetaLow[k] = cumulativeCosTheta(i, u);
+      m_blend.thetaHigh[k] = cumulativeCosTheta(j, u);
+    }
+    m_blend.node = i;
+  }
+
+  // mix the two nodes
+  double wq = double(step)/blendSteps;
+  std::vector<double> c(m_blend.logE.size());
+  for (unsigned int k = 0; k < c.size(); k++){
+    c[k] = (1-wq)*m_blend.energyLow[k] + wq*m_blend.energyHigh[k];
+  }
+  m_blend.energy.setCumulative(m_blend.logE, c);
+  c.resize(m_blend.cosTheta.size());
+  for (unsigned int k = 0; k < c.size(); k++){
+    c[k] = (1-wq)*m_blend.thetaLow[k] + wq*m_blend.thetaHigh[k];
+  }
+  m_blend.theta.setCumulative(m_blend.cosTheta, c);
+  m_blend.step = step;
+}
+
+// Gives back the energy integrated flux at theta_M
+double CrLatitudeBinnedModel::flux(double thetaM) const
+{
+  unsigned int n = m_bins.size();
+  if (n == 0){ return 0; }
+  if (n < 2 || thetaM < m_bins.front().latitude){ return m_integrals.front().flux; }
+  if (!(thetaM < m_bins.back().latitude)){ return m_integrals.back().flux; }
+
+  unsigned int i = lower(thetaM);
+  double r1 = thetaM-m_bins[i].latitude;
+  double r2 = m_bins[i+1].latitude-thetaM;
+  return ( r2*m_integrals[i].flux + r1*m_integrals[i+1].flux )/(r1+r2);
+}
+
+// Read the table from a text file
+bool CrLatitudeBinnedModel::read(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str());
+  if (!file){
+    std::cerr << "CrLatitudeBinnedModel: cannot open " << fileName << std::endl;
+    return false;
+  }
+
+  std::vector<Bin> bins;
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line)){
+    lineNumber++;
+    std::string::size_type comment = line.find('#');
+    if (comment != std::string::npos){ line.erase(comment); }
+    std::istringstream in(line);
+    Bin bin;
+    if (!(in >> bin.latitude)){ continue; } // empty line
+
+    bool ok = bool(in >> bin.ang >> bin.eMin);
+    std::string shape;
+    while (ok && in >> shape){
+      Segment s = {powerLaw, 0, 0, 0, 0};
+      if (shape == "pow"){
+        ok = bool(in >> s.norm >> s.index >> s.eMax);
+      } else if (shape == "cut"){
+        s.shape = cutOffPowerLaw;
+        ok = bool(in >> s.norm >> s.index >> s.cutOff >> s.eMax);
+      } else {
+        ok = false;
+      }
+      G4double lowE = bin.segments.empty() ? bin.eMin : bin.segments.back().eMax;
+      if (ok && !(s.eMax > lowE)){ ok = false; }
+      if (ok){ bin.segments.push_back(s); }
+    }
+    if (ok && bin.segments.empty()){ ok = false; }
+    if (ok && !bins.empty() && !(bin.latitude > bins.back().latitude)){ ok = false; }
+    if (!ok){
+      std::cerr << "CrLatitudeBinnedModel: error in line " << lineNumber
+                << " of " << fileName << std::endl;
+      return false;
+    }
+    bins.push_back(bin);
+  }
+  if (bins.empty()){
+    std::cerr << "CrLatitudeBinnedModel: no table in " << fileName << std::endl;
+    return false;
+  }
+
+  clear();
+  for (unsigned int i = 0; i < bins.size(); i++){ addBin(bins[i]); }
+  return true;
+}
+
+// Write the table to a text file
+bool CrLatitudeBinnedModel::write(const std::string& fileName) const
+{
+  std::ofstream file(fileName.c_str());
+  if (!file){ return false; }
+
+  file << "# theta_M[rad] ang eMin[GeV] segments: pow norm index eMax[GeV]"
+       << " | cut norm index cutOff[GeV] eMax[GeV]" << std::endl;
+  file << std::setprecision(17);
+  for (unsigned int i = 0; i < m_bins.size(); i++){
+    const Bin& bin = m_bins[i];
+    file << bin.latitude << " " << bin.ang << " " << bin.eMin;
+    for (unsigned int k = 0; k < bin.segments.size(); k++){
+      const Segment& s = bin.segments[k];
+      if (s.shape == cutOffPowerLaw){
+        file << "  cut " << s.norm << " " << s.index << " " << s.cutOff << " " << s.eMax;
+      } else {
+        file << "  pow " << s.norm << " " << s.index << " " << s.eMax;
+      }
+    }
+    file << std::endl;
+  }
+  return bool(file);
+}
@@ -0,0 +1,163 @@
+/**
+ * CrLatitudeBinnedModel:
+ *  Spectra and angular distributions of a secondary component given
+ *  at nodes of the geomagnetic latitude theta_M.
+ */
+
+//$Header$
+
+#ifndef CrLatitudeBinnedModel_H
+#define CrLatitudeBinnedModel_H
+
+#include <string>
+#include <vector>
+
+#include "CrInverseCDF.hh"
+
+namespace CLHEP {class HepRandomEngine;}
+
+/** @class CrLatitudeBinnedModel
+ *  @brief parameter table of a secondary component sorted in theta_M
+ *
+ * At each node the energy spectrum is a sequence of segments joined
+ * at break energies; a segment is a power law A*E^-a or a cut-off
+ * power law A*E^-a*exp(-(E/cut)^(-a+1)).  The zenith angle follows
+ * 1+ang*sin(theta)^2.  Between two nodes a particle is taken from
+ * one of them, chosen in the ratio of the distances in theta_M, and
+ * the flux is interpolated linearly.
+ *
+ * The tables are built in the code of the components or read from a
+ * text file (see read()), so a new fit needs no new class.  The
+ * integrals of the segments are computed once when a node is added.
+ *
+ * In the compatibility mode the random numbers are used as by the
+ * former classes with one class per latitude bin (CrProtonSplash_0002,
+ * ...), which gives the same particles.  Otherwise the random number
+ * that chooses the segment also places the energy within it.
+ *
+ * In the blended mode the mixture of the two nodes around theta_M is
+ * tabulated as inverse CDFs of log(E) and cos(theta), so a particle
+ * takes one random number per variable and no node is chosen.  The
+ * cumulative distributions of the two nodes are computed when theta_M
+ * moves to another pair of nodes; within a pair a new theta_M only
+ * mixes them again with the weight rounded to 1/blendSteps.
+ */
+class CrLatitudeBinnedModel
+{
+public:
+  enum Shape { powerLaw, cutOffPowerLaw };
+
+  /// One piece of the spectrum, energies in GeV, j(E) in [c/s/m^2/sr/MeV]
+  struct Segment {
+    Shape shape;
+    double norm;
+    double index;
+    double cutOff;  ///< only for cutOffPowerLaw
+    double eMax;    ///< upper end; the lower one is eMin or the end of the previous segment
+  };
+
+  /// The model at one value of theta_M
+  struct Bin {
+    double latitude;  ///< theta_M [rad]
+    double ang;       ///< angular distribution 1+ang*sin(theta)^2
+    double eMin;      ///< lower end of the spectrum [GeV]
+    std::vector<Segment> segments;
+  };
+
+  /// Segments for the tables built in the code
+  static Segment powerLawSegment(double norm, double index, double eMax);
+  static Segment cutOffSegment(double norm, double index, double cutOff, double eMax);
+
+  CrLatitudeBinnedModel();
+  ~CrLatitudeBinnedModel();
+
+  /// Add a node; the nodes must be added in increasing theta_M
+  void addBin(const Bin& bin);
+  void clear();
+  unsigned int size() const;
+  const Bin& bin(unsigned int i) const;
+
+  /// Replace the table by the one of a text file; one line per node:
+  ///   theta_M ang eMin segment segment ...
+  /// where a segment is "pow norm index eMax" or
+  /// "cut norm index cutOff eMax"; '#' starts a comment.
+  /// Gives back false, and keeps the table, if the file cannot be used.
+  bool read(const std::string& fileName);
+  /// Write the table in the format of read(), to full precision
+  bool write(const std::string& fileName) const;
+
+  /// Use the random numbers as the former per-bin classes did
+  void setCompatible(bool compatible);
+  bool compatible() const;
+  /// Mode of the models made from now on
+  static bool s_defaultCompatible;
+
+  /// Sample from the tables of the mixture at theta_M instead of
+  /// choosing a node per particle
+  void setBlended(bool blended);
+  bool blended() const;
+  /// Mode of the models made from now on
+  static bool s_defaultBlended;
+
+  /// Gives back the kinetic energy [GeV] of a particle at theta_M [rad]
+  double sampleEnergy(double thetaM, CLHEP::HepRandomEngine* engine) const;
+
+  /// Gives back the zenith angle [rad], 0 to pi/2, of a particle at theta_M
+  double sampleTheta(double thetaM, CLHEP::HepRandomEngine* engine) const;
+
+  /// Gives back the node to use at theta_M [rad]; between two nodes
+  /// one random number chooses one of them
+  unsigned int select(double thetaM, CLHEP::HepRandomEngine* engine) const;
+
+  /// Gives back the kinetic energy [GeV] of a particle of node i
+  double energy(unsigned int i, CLHEP::HepRandomEngine* engine) const;
+
+  /// Gives back the zenith angle [rad], 0 to pi/2, of a particle of node i
+  double theta(unsigned int i, CLHEP::HepRandomEngine* engine) const;
+
+  /// Gives back the energy integrated flux [c/s/m^2/sr] at theta_M,
+  /// including the angular distribution
+  double flux(double thetaM) const;
+
+private:
+  // integrals of the segments of a node
+  struct Integrals {
+    std::vector<double> low, high; ///< integral at the ends of each segment
+    std::vector<double> fraction;  ///< share of the segments up to and including each
+    double area;
+    double flux;
+  };
+
+  Integrals integrate(const Bin& bin) const;
+
+  // tables of the blended mode for the last theta_M
+  struct Blend {
+    int node;   ///< lower node of the pair, -1 if there are no tables
+    double thetaM;  ///< theta_M of the tables
+    int step;   ///< weight of the upper node in units of 1/blendSteps
+    std::vector<double> logE, energyLow, energyHigh; ///< CDF of both nodes in log(E)
+    std::vector<double> cosTheta, thetaLow, thetaHigh; ///< and in cos(theta)
+    CrInverseCDF energy, theta;
+  };
+  enum { blendSteps = 1024, nodesPerDecade = 100, nodesCosTheta = 129 };
+
+  // share of the flux of node i below E [GeV]
+  double cumulative(unsigned int i, double E) const;
+  // share of the particles of node i with cos(zenith angle) below u
+  double cumulativeCosTheta(unsigned int i, double u) const;
+  // make the tables of the blended mode up to date for theta_M
+  void blend(double thetaM) const;
+
+  // node i with latitude[i] <= thetaM < latitude[i+1]; thetaM must be
+  // within the nodes
+  unsigned int lower(double thetaM) const;
+
+  std::vector<Bin> m_bins;
+  std::vector<Integrals> m_integrals;
+  double m_step;       ///< mean distance of the nodes, for the first guess in lower()
+  bool m_compatible;
+  bool m_blended;
+  mutable Blend m_blend;
+};
+
+#endif // CrLatitudeBinnedModel_H
@@ -0,0 +1,113 @@
+/****************************************************************************
+ * CrLeptonSecondaryModel.cxx:
+ ****************************************************************************
+ * The secondary e- and e+ spectra of the former per-bin classes
+ * (CrElectronSubSplash.cxx, CrElectronSubReentrant.cxx and the positron
+ * ones), as nodes of CrLatitudeBinnedModel.
+ * Reference: LAT measurement of 2ndary e- + e+ (2010-10, T. Mizuno,
+ * analysis by Melissa).
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <cmath>
+
+#include "CrLatitudeBinnedModel.hh"
+#include "CrLeptonSecondaryModel.hh"
+
+typedef double G4double;
+
+// private function definitions.
+namespace {
+  // lower and higher energy limit of secondary e- and e+ in units of GeV
+  const G4double lowE  = 0.01;
+  const G4double highE = 10.0;
+
+  const G4double PosToEle_0001 = 4.8; // e+/e- of secondary in 0.0<theta_M<0.1
+  const G4double PosToEle_0102 = 4.2; // e+/e- of secondary in 0.1<theta_M<0.2
+  const G4double PosToEle_0203 = 3.8; // e+/e- of secondary in 0.2<theta_M<0.3
+  const G4double PosToEle_0304 = 2.6; // e+/e- of secondary in 0.3<theta_M<0.4
+  const G4double PosToEle_0405 = 1.8; // e+/e- of secondary in 0.4<theta_M<0.5
+  const G4double PosToEle_0506 = 1.0; // e+/e- of secondary in 0.5<theta_M<0.6
+  const G4double PosToEle_0611 = 1.0; // e+/e- of secondary in 0.6<theta_M<1.1
+
+  // gives back the e- or e+ part of the e- + e+ normalization
+  inline G4double share(G4double norm, G4double posToEle, bool positron){
+    return positron ? norm*posToEle/(1+posToEle) : norm/(1+posToEle);
+  }
+}
+// end of namespace
+
+// j(E) is in [c/s/m^2/sr/MeV] of e- + e+ (E/100MeV, ... for the segments);
+// the node of the bin a<theta_M<b is at a+0.05 and the angular
+// distribution is uniform.
+void crLeptonSecondaryModel(CrLatitudeBinnedModel& model, bool positron)
+{
+  typedef CrLatitudeBinnedModel M;
+  M::Bin bin;
+  bin.ang = 0.0;
+  bin.eMin = lowE;
+
+  // 0.0<theta_M<0.1: indices -2.0, -1.5, -2.5, -3.6, breaks at 100 MeV, 400 MeV and 3 GeV
+  bin.latitude = 0.05;
+  bin.segments.clear();
+  bin.segments.push_back(M::powerLawSegment(share(0.45*pow(1000./100., -2.0), PosToEle_0001, positron), 2.0, 0.1));
+  bin.segments.push_back(M::powerLawSegment(share(0.45*pow(1000./100., -1.5), PosToEle_0001, positron), 1.5, 0.4));
+  bin.segments.push_back(M::powerLawSegment(share(0.056*pow(1000./400., -2.5), PosToEle_0001, positron), 2.5, 3.0));
+  bin.segments.push_back(M::powerLawSegment(share(3.65e-4*pow(1000./3000.0, -3.6), PosToEle_0001, positron), 3.6, highE));
+  model.addBin(bin);
+
+  // 0.1<theta_M<0.2: indices -2.0, -1.5, -2.5, -2.9, breaks at 100 MeV, 400 MeV and 1 GeV
+  bin.latitude = 0.15;
+  bin.segments.clear();
+  bin.segments.push_back(M::powerLawSegment(share(0.45*pow(1000./100., -2.0), PosToEle_0102, positron), 2.0, 0.1));
+  bin.segments.push_back(M::powerLawSegment(share(0.45*pow(1000./100., -1.5), PosToEle_0102, positron), 1.5, 0.4));
+  bin.segments.push_back(M::powerLawSegment(share(0.056*pow(1000./400., -2.5), PosToEle_0102, positron), 2.5, 1.0));
+  bin.segments.push_back(M::powerLawSegment(share(0.0056*pow(1000./1000.0, -2.9), PosToEle_0102, positron), 2.9, highE));
+  model.addBin(bin);
+
+  // 0.2<theta_M<0.3: indices -2.0, -1.5, -1.8, -2.8, breaks at 100 MeV, 300 MeV and 400 MeV
+  bin.latitude = 0.25;
+  bin.segments.clear();
+  bin.segments.push_back(M::powerLawSegment(share(0.45*pow(1000./100., -2.0), PosToEle_0203, positron), 2.0, 0.1));
+  bin.segments.push_back(M::powerLawSegment(share(0.45*pow(1000./100., -1.5), PosToEle_0203, positron), 1.5, 0.3));
+  bin.segments.push_back(M::powerLawSegment(share(0.086*pow(1000./300., -1.8), PosToEle_0203, positron), 1.8, 0.4));
+  bin.segments.push_back(M::powerLawSegment(share(0.051*pow(1000./400.0, -2.8), PosToEle_0203, positron), 2.8, highE));
+  model.addBin(bin);
+
+  // 0.3<theta_M<0.4: indices -2.0, -1.6, -2.5, -2.8, breaks at 100 MeV, 300 MeV and 600 MeV
+  bin.latitude = 0.35;
+  bin.segments.clear();
+  bin.segments.push_back(M::powerLawSegment(share(0.45*pow(1000./100., -2.0), PosToEle_0304, positron), 2.0, 0.1));
+  bin.segments.push_back(M::powerLawSegment(share(0.45*pow(1000./100., -1.6), PosToEle_0304, positron), 1.6, 0.3));
+  bin.segments.push_back(M::powerLawSegment(share(0.078*pow(1000./300., -2.5), PosToEle_0304, positron), 2.5, 0.6));
+  bin.segments.push_back(M::powerLawSegment(share(0.0137*pow(1000./600.0, -2.8), PosToEle_0304, positron), 2.8, highE));
+  model.addBin(bin);
+
+  // 0.4<theta_M<0.5: indices -2.0, -1.7, -2.8, breaks at 100 MeV and 300 MeV
+  bin.latitude = 0.45;
+  bin.segments.clear();
+  bin.segments.push_back(M::powerLawSegment(share(0.5*pow(1000./100., -2.0), PosToEle_0405, positron), 2.0, 0.1));
+  bin.segments.push_back(M::powerLawSegment(share(0.5*pow(1000./100., -1.7), PosToEle_0405, positron), 1.7, 0.3));
+  bin.segments.push_back(M::powerLawSegment(share(0.077*pow(1000./300., -2.8), PosToEle_0405, positron), 2.8, highE));
+  model.addBin(bin);
+
+  // 0.5<theta_M<0.6: indices -2.0, -1.9, -3.0, -2.3, breaks at 100 MeV, 300 MeV and 1.5 GeV
+  bin.latitude = 0.55;
+  bin.segments.clear();
+  bin.segments.push_back(M::powerLawSegment(share(0.6*pow(1000./100., -2.0), PosToEle_0506, positron), 2.0, 0.1));
+  bin.segments.push_back(M::powerLawSegment(share(0.6*pow(1000./100., -1.9), PosToEle_0506, positron), 1.9, 0.3));
+  bin.segments.push_back(M::powerLawSegment(share(0.074*pow(1000./300., -3.0), PosToEle_0506, positron), 3.0, 1.5));
+  bin.segments.push_back(M::powerLawSegment(share(0.00059*pow(1000./1500.0, -2.3), PosToEle_0506, positron), 2.3, highE));
+  model.addBin(bin);
+
+  // 0.6<theta_M<1.1: indices -2.0, -1.9, -3.2, -1.8, breaks at 100 MeV, 300 MeV and 1.2 GeV
+  bin.latitude = 0.65;
+  bin.segments.clear();
+  bin.segments.push_back(M::powerLawSegment(share(0.65*pow(1000./100., -2.0), PosToEle_0611, positron), 2.0, 0.1));
+  bin.segments.push_back(M::powerLawSegment(share(0.65*pow(1000./100., -1.9), PosToEle_0611, positron), 1.9, 0.3));
+  bin.segments.push_back(M::powerLawSegment(share(0.08*pow(1000./300., -3.2), PosToEle_0611, positron), 3.2, 1.2));
+  bin.segments.push_back(M::powerLawSegment(share(9e-4*pow(1000./1200.0, -1.8), PosToEle_0611, positron), 1.8, highE));
+  model.addBin(bin);
+}
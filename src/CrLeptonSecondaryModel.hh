@@ -0,0 +1,18 @@
+/**
+ * CrLeptonSecondaryModel:
+ *  Built-in tables of the splash and reentrant e- and e+ spectra.
+ */
+
+//$Header$
+
+#ifndef CrLeptonSecondaryModel_H
+#define CrLeptonSecondaryModel_H
+
+class CrLatitudeBinnedModel;
+
+/// Fill model with the secondary e- (positron=false) or e+ spectra sorted
+/// in theta_M.  The fits are of e- + e+, split in each bin by the e+/e-
+/// ratio; the splash and reentrant components have the same spectra.
+void crLeptonSecondaryModel(CrLatitudeBinnedModel& model, bool positron);
+
+#endif // CrLeptonSecondaryModel_H
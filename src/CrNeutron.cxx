@@ -10,7 +10,6 @@
 //$Header$
 
 #include <cmath>
-#include <map>
 #include <vector>
 
 // CLHEP
@@ -33,6 +32,8 @@ CrNeutron::CrNeutron(const std::string& /* paramstring */)
   // including each component (splash alphas)...
   m_subComponents.push_back(new CrNeutronSplash);
   
+  m_mix.setComponents(m_subComponents, false);
+
   m_engine = CLHEP::HepRandom::getTheEngine(); //new HepJamesRandom;
 }
 
@@ -47,27 +48,18 @@ CrNeutron::~CrNeutron()
 }
 
 
-// Gives back component in the ratio of the flux
-CrSpectrum* CrNeutron::selectComponent()
+// Set the random engine of the source
+void CrNeutron::setEngine(CLHEP::HepRandomEngine* engine)
 {
-  std::map<CrSpectrum*,G4double> integ_flux;
-  double total_flux = 0;
-  std::vector<CrSpectrum*>::iterator i;
-
-  // calculate the total flux 
-  for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-    total_flux += (*i)->flux();
-    integ_flux[*i] = total_flux;
-  }
-  // select component based on the flux
-  G4double rnum = m_engine->flat() * total_flux;
-  for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-    if (integ_flux[*i] >= rnum) { break; }
-  }
+  m_engine = engine;
+}
 
-  m_component = *i;
 
-  return *i;
+// Gives back component in the ratio of the flux
+CrSpectrum* CrNeutron::selectComponent()
+{
+  m_component = m_mix.select(m_engine);
+  return m_component;
 }
 
 // Gives back kinetic energy 
@@ -86,13 +78,20 @@ std::pair<G4double,G4double> CrNeutron::dir(G4double energy)
   return m_component->dir(energy, m_engine);
 }
 
+// Fill n particles at once
+void CrNeutron::sampleBlock(int n, G4double* energy, G4double* cosTheta,
+                           G4double* phi, const CrSpectrum** source)
+{
+  m_mix.sampleBlock(m_engine, n, energy, cosTheta, phi, source);
+}
+
 // Gives back the total flux (summation of each component's flux)
 G4double CrNeutron::flux(G4double /* time */ ) const
 {
   G4double total_flux = 0;
   std::vector<CrSpectrum*>::const_iterator i;
   for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
-    total_flux += (*i)->flux();
+    total_flux += (*i)->cachedFlux();
     //    cout << "flux of this component = " << (*i)->flux() << endl;
   }
   return total_flux;
@@ -117,7 +116,7 @@ void CrNeutron::dump()
   std::vector<CrSpectrum*>::const_iterator i;
   for (i = m_subComponents.begin(); i != m_subComponents.end(); i++){
     std::cout << "title: " << (*i)->title() << std::endl;
-    std::cout << " flux(c/s/m^2/sr)= " << (*i)->flux() << std::endl;
+    std::cout << " flux(c/s/m^2/sr)= " << (*i)->cachedFlux() << std::endl;
     std::cout << " geographic latitude/longitude(deg)= " 
          << (*i)->latitude() << " " << (*i)->longitude() << std::endl;
     std::cout << " geomagnetic latitude/longitude(deg)= " 
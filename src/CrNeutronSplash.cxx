@@ -10,6 +10,7 @@
 // $Header$
 
 #include <cmath>
+#include <vector>
 
 // CLHEP
 //#include <CLHEP/config/CLHEP.h>
@@ -18,6 +19,7 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrNeutronSplash.hh"
+#include "CrBatchMath.hh"
 
 typedef double G4double;
 
@@ -181,7 +183,7 @@ namespace {
 
 CrNeutronSplash::CrNeutronSplash()
 {
-  ;
+  envelopeIntegrals();
 }
 
 
@@ -216,54 +218,92 @@ std::pair<G4double,G4double> CrNeutronSplash::dir(G4double /* energy */,
 // Gives back particle energy
 G4double CrNeutronSplash::energySrc(CLHEP::HepRandomEngine* engine) const
 {
+  const CrEnvelopeIntegrals& envelope = envelopeIntegrals();
 
-  G4double rand_min_0 = 
-    primaryCRenvelope0_integral(min(lowE_break, lowE_neutron), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_0 = 
-    primaryCRenvelope0_integral(max(lowE_break, lowE_neutron), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_1 = 
-    primaryCRenvelope1_integral(min(highE_break, lowE_break), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_1 = 
-    primaryCRenvelope1_integral(max(highE_break, lowE_break), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_2 = 
-    primaryCRenvelope2_integral(min(highE_neutron, highE_break), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_2 = 
-    primaryCRenvelope2_integral(max(highE_neutron, highE_break), 
-				m_cutOffRigidity, m_solarWindPotential);
-  
-  G4double envelope0_area = rand_max_0 - rand_min_0;
-  G4double envelope1_area = rand_max_1 - rand_min_1;
-  G4double envelope2_area = rand_max_2 - rand_min_2;
-  G4double envelope_area = envelope0_area + envelope1_area + envelope2_area;
-  
-  G4double Ernd,r;
-  G4double E; // E means energy in GeV
-  
-  while(1){
-    Ernd = engine->flat();
-    if (Ernd <= envelope0_area/envelope_area){
-      // use the envelope function in the lowest energy range
-      r = engine->flat() * (rand_max_0 - rand_min_0) + rand_min_0;
-      E = primaryCRenvelope0_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else if (Ernd <= (envelope0_area+envelope1_area)/envelope_area){
-      // use the envelope function in the middle energy range
-      r = engine->flat() * (rand_max_1 - rand_min_1) + rand_min_1;
-      E = primaryCRenvelope1_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    } else{
-      // use the envelope function in the highest energy range
-      r = engine->flat() * (rand_max_2 - rand_min_2) + rand_min_2;
-      E = primaryCRenvelope2_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
-    }
+  G4double r;
+  G4double E = 0; // E means energy in GeV
+
+  switch (envelope.piece(engine->flat())){
+  case 0:
+    // use the envelope function in the lowest energy range
+    r = engine->flat() * (envelope.high(0) - envelope.low(0)) + envelope.low(0);
+    E = primaryCRenvelope0_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 1:
+    // use the envelope function in the middle energy range
+    r = engine->flat() * (envelope.high(1) - envelope.low(1)) + envelope.low(1);
+    E = primaryCRenvelope1_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
+    break;
+  case 2:
+    // use the envelope function in the highest energy range
+    r = engine->flat() * (envelope.high(2) - envelope.low(2)) + envelope.low(2);
+    E = primaryCRenvelope2_integral_inv(r, m_cutOffRigidity, m_solarWindPotential);
     break;
   }
   return E;
 }
 
+// Gives back n particles; the bases and the exponents of the inverses
+// of the integrals, pow(coeff*r, exponent) [MeV], are collected and
+// raised together by CrBatchMath::pow()
+void CrNeutronSplash::sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                                  G4double* energy, G4double* cosTheta,
+                                  G4double* phi) const
+{
+  if (n<=0){ return; }
+
+  const CrEnvelopeIntegrals& envelope = envelopeIntegrals();
+  const G4double coeff[3] = {(-a0_neutron+1)/A0_neutron,
+                             (-a1_neutron+1)/A1_neutron,
+                             (-a2_neutron+1)/A2_neutron};
+  const G4double exponent[3] = {1./(-a0_neutron+1), 1./(-a1_neutron+1),
+                                1./(-a2_neutron+1)};
+
+  // two random numbers for the energy and two for the direction; the
+  // bases go to the front of rnd, after rnd[2*i] and rnd[2*i+1] are read
+  std::vector<G4double> rnd(4*n);
+  engine->flatArray(4*n, &rnd[0]);
+  for (int i = 0; i < n; i++){
+    int k = envelope.piece(rnd[2*i]);
+    G4double r = rnd[2*i+1] * envelope.area(k) + envelope.low(k);
+    rnd[i] = coeff[k] * r;
+    energy[i] = exponent[k];
+  }
+  CrBatchMath::pow(n, &rnd[0], energy, energy);
+  for (int i = 0; i < n; i++){ energy[i] *= MeVtoGeV; }
+
+  // Cos(theta) ranges from -1 to -0.4, as in dir()
+  const G4double* drnd = &rnd[2*n];
+  for (int i = 0; i < n; i++){
+    cosTheta[i] = 0.6*drnd[2*i]-1;
+    phi[i]      = drnd[2*i+1] * 2 * M_PI;
+  }
+}
+
+
+// Integrals of the envelope functions; they depend on constants only
+// and are computed once
+const CrEnvelopeIntegrals& CrNeutronSplash::envelopeIntegrals() const
+{
+  if (m_envelope.valid()){ return m_envelope; }
+
+  G4double low[3], high[3];
+  low[0] = primaryCRenvelope0_integral(min(lowE_break, lowE_neutron),
+                                       m_cutOffRigidity, m_solarWindPotential);
+  high[0] = primaryCRenvelope0_integral(max(lowE_break, lowE_neutron),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  low[1] = primaryCRenvelope1_integral(min(highE_break, lowE_break),
+                                       m_cutOffRigidity, m_solarWindPotential);
+  high[1] = primaryCRenvelope1_integral(max(highE_break, lowE_break),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  low[2] = primaryCRenvelope2_integral(min(highE_neutron, highE_break),
+                                       m_cutOffRigidity, m_solarWindPotential);
+  high[2] = primaryCRenvelope2_integral(max(highE_neutron, highE_break),
+                                        m_cutOffRigidity, m_solarWindPotential);
+  m_envelope.set(3, low, high);
+  return m_envelope;
+}
+
 
 // flux() returns the energy integrated flux averaged over
 // the region from which particle is coming from 
@@ -272,41 +312,7 @@ G4double CrNeutronSplash::energySrc(CLHEP::HepRandomEngine* engine) const
 // "primary", "reentrant" and "splash".
 G4double CrNeutronSplash::flux() const
 {
-
-  G4double rand_min_0 = 
-    primaryCRenvelope0_integral(min(lowE_break, lowE_neutron), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_0 = 
-    primaryCRenvelope0_integral(max(lowE_break, lowE_neutron), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_1 = 
-    primaryCRenvelope1_integral(min(highE_break, lowE_break), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_1 = 
-    primaryCRenvelope1_integral(max(highE_break, lowE_break), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_min_2 = 
-    primaryCRenvelope2_integral(min(highE_neutron, highE_break), 
-				m_cutOffRigidity, m_solarWindPotential);
-  G4double rand_max_2 = 
-    primaryCRenvelope2_integral(max(highE_neutron, highE_break), 
-				m_cutOffRigidity, m_solarWindPotential);
-  
-  G4double envelope0_area = rand_max_0 - rand_min_0;
-  G4double envelope1_area = rand_max_1 - rand_min_1;
-  G4double envelope2_area = rand_max_2 - rand_min_2;
-  G4double envelope_area = envelope0_area + envelope1_area + envelope2_area;
-  
-  ENERGY_INTEGRAL_neutron = envelope_area;
-
-
-  /***
-  cout << "m_gammaLowEnergy: " << m_gammaLowEnergy << endl;
-  cout << "m_gammaHighEnergy: " << m_gammaHighEnergy << endl;
-  cout << "envelope2_area: " << envelope2_area << endl;
-  cout << "envelope3_area: " << envelope3_area << endl;
-  cout << "envelope_area: " << ENERGY_INTEGRAL_neutron << endl;
-  ***/
+  ENERGY_INTEGRAL_neutron = envelopeIntegrals().area();
 
   // We assume that the flux is uniform in region of cos(theta)>0.4,
   // then the average flux is equal to the vertically downward one.
@@ -0,0 +1,295 @@
+/****************************************************************************
+ * CrParallelGenerator.cxx:
+ ****************************************************************************
+ * The components keep the state of the current position (tables,
+ * mixtures, envelope integrals), so they cannot be shared by threads;
+ * each thread gets its own replica, placed by its own CrFixedPosition.
+ * A replica made before the first slice and moved from slice to slice
+ * holds nothing but functions of the position, so its particles do
+ * not depend on the slices it made before.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <algorithm>
+#include <condition_variable>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "CrParallelGenerator.hh"
+#include "CrComponentMix.hh"
+#include "CrPhiloxEngine.hh"
+#include "CrPositionProvider.hh"
+#include "CrSourceFactory.hh"
+#include "CrSpectrum.hh"
+#include "CrTrajectory.hh"
+
+namespace {
+  // the components of one thread and the position they follow
+  struct Replica {
+    CrFixedPosition position;
+    std::vector<CrSpectrum*> components;
+    CrComponentMix* mix;
+
+    Replica() : mix(0) {}
+    ~Replica()
+    {
+      delete mix;
+      for (unsigned int k = 0; k < components.size(); k++){ delete components[k]; }
+    }
+
+    // Place the replica at the middle of the slice and give the
+    // engine to the components; gives back flux*solidAngle.  The
+    // heavy ion species drawn by solidAngle() here is not used: the
+    // particles ask the solid angle again, each for its own species.
+    double moveTo(const CrTrajectory& trajectory, double time,
+                  CLHEP::HepRandomEngine* engine)
+    {
+      double latitude, longitude, altitude;
+      trajectory.position(time, latitude, longitude, altitude);
+      position.setPosition(latitude, longitude, altitude, time);
+      double rate = 0;
+      for (unsigned int k = 0; k < components.size(); k++){
+        components[k]->setEngine(engine);
+        rate += components[k]->solidAngle()*components[k]->cachedFlux();
+      }
+      return rate;
+    }
+  };
+
+  // Queues of slices, one per thread, with stealing.  One lock serves
+  // all the queues: a slice takes far longer than the lock.
+  class SliceQueues {
+  public:
+    SliceQueues(long nSlice, int nQueue)
+      : m_queues(nQueue), m_limit(nSlice), m_steals(0)
+    {
+      for (long k = 0; k < nSlice; k++){ m_queues[k%nQueue].push_back(k); }
+    }
+
+    // Gives back the next slice of thread w, -1 when all are taken.
+    // Slices from m_limit on wait for setLimit().
+    long next(int w)
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (1){
+        std::deque<long>& own = m_queues[w];
+        if (!own.empty() && own.front() < m_limit){
+          long slice = own.front();
+          own.pop_front();
+          return slice;
+        }
+        // the earliest slice of the other queues
+        int victim = -1;
+        bool left = !own.empty();
+        for (unsigned int v = 0; v < m_queues.size(); v++){
+          if (m_queues[v].empty()){ continue; }
+          left = true;
+          if (m_queues[v].front() < m_limit
+              && (victim < 0 || m_queues[v].front() < m_queues[victim].front())){
+            victim = v;
+          }
+        }
+        if (victim >= 0){
+          long slice = m_queues[victim].front();
+          m_queues[victim].pop_front();
+          m_steals++;
+          return slice;
+        }
+        if (!left){ return -1; }
+        m_moved.wait(lock);
+      }
+    }
+
+    void setLimit(long limit)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_limit = limit;
+      m_moved.notify_all();
+    }
+
+    unsigned long steals() const { return m_steals; }
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_moved;
+    std::vector<std::deque<long> > m_queues;
+    long m_limit;
+    unsigned long m_steals;
+  };
+
+  // the slices made and not yet written
+  class SliceResults {
+  public:
+    void put(long slice, std::vector<CrParallelGenerator::Event>& events)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_slices[slice].swap(events);
+      m_done.notify_all();
+    }
+
+    // Wait for the slice and give back its particles
+    void take(long slice, std::vector<CrParallelGenerator::Event>& events)
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      std::map<long, std::vector<CrParallelGenerator::Event> >::iterator it;
+      while ((it = m_slices.find(slice)) == m_slices.end()){ m_done.wait(lock); }
+      events.swap(it->second);
+      m_slices.erase(it);
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+    std::map<long, std::vector<CrParallelGenerator::Event> > m_slices;
+  };
+
+  bool earlier(const CrParallelGenerator::Event& a, const CrParallelGenerator::Event& b)
+  {
+    return a.time < b.time;
+  }
+}
+
+CrParallelGenerator::Settings::Settings()
+  : startTime(2.4e8), stopTime(2.4e8+86400.), step(30.), events(1000),
+    seed(12345), job(0), threads(1)
+{
+  ;
+}
+
+CrParallelGenerator::CrParallelGenerator(const CrSourceFactory& source,
+                                         const CrTrajectory& trajectory)
+  : m_source(source), m_trajectory(trajectory), m_meanRate(0), m_steals(0)
+{
+  ;
+}
+
+CrParallelGenerator::~CrParallelGenerator()
+{
+  ;
+}
+
+bool CrParallelGenerator::run(const Settings& settings, Output& output)
+{
+  int nThread = settings.threads > 0 ? settings.threads : 1;
+  long nSlice = long(ceil((settings.stopTime-settings.startTime)/settings.step));
+  if (!m_source.valid() || nSlice <= 0 || settings.events < 0){ return false; }
+
+  // the replicas are made one after the other in this thread, each
+  // following its own position
+  CrPositionProvider* previous = CrPositionProvider::current();
+  std::vector<Replica*> replicas(nThread);
+  for (int w = 0; w < nThread; w++){
+    replicas[w] = new Replica;
+    CrPositionProvider::setCurrent(&replicas[w]->position);
+    m_source.make(replicas[w]->components);
+    replicas[w]->mix = new CrComponentMix;
+    replicas[w]->mix->setComponents(replicas[w]->components, m_source.useSolidAngle());
+  }
+  CrPositionProvider::setCurrent(previous);
+
+  m_componentNames.clear();
+  for (unsigned int k = 0; k < replicas[0]->components.size(); k++){
+    m_componentNames.push_back(replicas[0]->components[k]->title());
+  }
+
+  const CrPhiloxEngine base = CrPhiloxEngine(settings.seed).stream(settings.job);
+  const double start = settings.startTime, stop = settings.stopTime, step = settings.step;
+
+  // first pass: the number of particles expected in each slice
+  std::vector<double> rate(nSlice);
+  {
+    SliceQueues queues(nSlice, nThread);
+    std::vector<std::thread> threads;
+    for (int w = 0; w < nThread; w++){
+      threads.push_back(std::thread([&, w](){
+        long k;
+        while ((k = queues.next(w)) >= 0){
+          double t0 = start + k*step;
+          double t1 = std::min(stop, t0+step);
+          CrPhiloxEngine engine = base.stream(k).stream(0);
+          double r = replicas[w]->moveTo(m_trajectory, 0.5*(t0+t1), &engine);
+          rate[k] = r>0 ? r*(t1-t0) : 0;
+        }
+      }));
+    }
+    for (int w = 0; w < nThread; w++){ threads[w].join(); }
+  }
+  double total = 0;
+  for (long k = 0; k < nSlice; k++){ total += rate[k]; }
+  m_meanRate = total/(stop-start);
+  if (!(total > 0)){
+    for (int w = 0; w < nThread; w++){ delete replicas[w]; }
+    return false;
+  }
+
+  // share the particles among the slices in the ratio of the flux
+  std::vector<long> count(nSlice);
+  double sum = 0;
+  long done = 0;
+  for (long k = 0; k < nSlice; k++){
+    sum += rate[k];
+    long upTo = k+1 == nSlice ? settings.events : long(floor(settings.events*sum/total + 0.5));
+    count[k] = upTo > done ? upTo-done : 0;
+    done += count[k];
+  }
+
+  // second pass: the particles, written here in the order of the slices
+  const long window = std::max(8, 4*nThread);
+  SliceQueues queues(nSlice, nThread);
+  queues.setLimit(window);
+  SliceResults results;
+  std::vector<std::thread> threads;
+  for (int w = 0; w < nThread; w++){
+    threads.push_back(std::thread([&, w](){
+      Replica& replica = *replicas[w];
+      std::vector<Event> events;
+      long k;
+      while ((k = queues.next(w)) >= 0){
+        double t0 = start + k*step;
+        double t1 = std::min(stop, t0+step);
+        CrPhiloxEngine engine = base.stream(k).stream(1);
+        replica.moveTo(m_trajectory, 0.5*(t0+t1), &engine);
+        double latitude, longitude, altitude, time;
+        replica.position.position(latitude, longitude, altitude, time);
+
+        events.resize(count[k]);
+        for (long i = 0; i < count[k]; i++){
+          Event& event = events[i];
+          event.time = t0 + engine.flat()*(t1-t0);
+          CrSpectrum* component = replica.mix->select(&engine);
+          event.latitude = latitude;
+          event.longitude = longitude;
+          event.component = std::find(replica.components.begin(), replica.components.end(),
+                                      component) - replica.components.begin();
+          // FluxSvc asks the solid angle before every particle; the
+          // heavy ions draw the species of the particle there
+          component->solidAngle();
+          event.energy = component->energySrc(&engine);
+          event.particle = component->particleName();
+          std::pair<double,double> direction = component->dir(event.energy, &engine);
+          event.cosTheta = direction.first;
+          event.phi = direction.second;
+        }
+        std::stable_sort(events.begin(), events.end(), earlier);
+        results.put(k, events);
+      }
+    }));
+  }
+
+  std::vector<Event> events;
+  for (long k = 0; k < nSlice; k++){
+    results.take(k, events);
+    queues.setLimit(k+1+window);
+    for (unsigned int i = 0; i < events.size(); i++){ output.write(events[i]); }
+  }
+  for (int w = 0; w < nThread; w++){ threads[w].join(); }
+  m_steals = queues.steals();
+
+  for (int w = 0; w < nThread; w++){ delete replicas[w]; }
+  return true;
+}
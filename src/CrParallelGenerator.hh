@@ -0,0 +1,105 @@
+/**
+ * CrParallelGenerator:
+ *  Generates the particles of a source along a trajectory with several
+ *  threads, each with its own copy of the components.
+ */
+
+//$Header$
+
+#ifndef CrParallelGenerator_H
+#define CrParallelGenerator_H
+
+#include <string>
+#include <vector>
+
+class CrSourceFactory;
+class CrTrajectory;
+
+/** @class CrParallelGenerator
+ *  @brief multithreaded generation in time slices, written in time order
+ *
+ * The time range is cut into slices of a given length; the observer
+ * is placed at the middle of a slice for all its particles, as
+ * crflux_generate did.  Every thread has a replica of the source (its
+ * own components, CrComponentMix and CrFixedPosition) made by the
+ * CrSourceFactory.  The particles are shared among the slices in the
+ * ratio of the flux at each slice, computed in a first pass.
+ *
+ * As FluxSvc, the generator asks solidAngle() of the component
+ * before every particle, where CrHeavyIonPrimary draws its species.
+ *
+ * Slice k draws from the stream k of CrPhiloxEngine(seed).stream(job),
+ * and the components of a replica depend on the position only, so the
+ * particles are the same whatever thread makes a slice and however
+ * many threads run.
+ *
+ * The slices are dealt to the threads in turn; a thread takes the
+ * earliest slice of its own queue, and when that is empty or too far
+ * ahead of the output it steals the earliest slice of another queue.
+ * The particles of a slice are sorted in time, and the slices are
+ * written in order by the calling thread as soon as the earlier ones
+ * are done; at most a window of slices waits in memory.
+ *
+ * The components must not share state between replicas other than
+ * through locks (CrGeomagneticState, CrEastWestTable).  The trapped
+ * particles, which share one PSB97 model, are not part of the sources
+ * of CrSourceFactory.
+ */
+class CrParallelGenerator
+{
+public:
+  /// One particle
+  struct Event {
+    double time;      ///< [s]
+    double latitude;  ///< geographic [deg]
+    double longitude; ///< geographic [deg]
+    int component;    ///< index in componentNames()
+    const char* particle; ///< particleName() of the component
+    double energy;    ///< kinetic energy [GeV]
+    double cosTheta;
+    double phi;       ///< [rad]
+  };
+
+  /// Receives the particles in time order, in the calling thread
+  class Output {
+  public:
+    virtual ~Output() {}
+    virtual void write(const Event& event)=0;
+  };
+
+  /// Settings of a run
+  struct Settings {
+    Settings();
+    double startTime, stopTime; ///< [s]
+    double step;                ///< length of a slice [s]
+    long events;                ///< particles in the time range
+    unsigned long long seed;    ///< seed of the CrPhiloxEngine
+    unsigned long long job;     ///< stream of the seed used by this run
+    int threads;
+  };
+
+  CrParallelGenerator(const CrSourceFactory& source, const CrTrajectory& trajectory);
+  ~CrParallelGenerator();
+
+  /// Generate the particles and give them to output; gives back false
+  /// if the source is unknown or has no flux in the time range
+  bool run(const Settings& settings, Output& output);
+
+  /// title() of the components, after run()
+  const std::vector<std::string>& componentNames() const { return m_componentNames; }
+
+  /// mean of flux*solidAngle over the time range [c/s/m^2], after run()
+  double meanRate() const { return m_meanRate; }
+
+  /// Number of slices the threads took from another queue, after run()
+  unsigned long steals() const { return m_steals; }
+
+private:
+  const CrSourceFactory& m_source;
+  const CrTrajectory& m_trajectory;
+  std::vector<std::string> m_componentNames;
+  double m_meanRate;
+  unsigned long m_steals;
+};
+
+#endif // CrParallelGenerator_H
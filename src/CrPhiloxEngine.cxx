@@ -0,0 +1,167 @@
+/****************************************************************************
+ * CrPhiloxEngine.cxx:
+ ****************************************************************************
+ * The composite sources draw from the global CLHEP engine, which
+ * RegisterCRflux sets to the one of FluxSvc: particles made in
+ * parallel would depend on the order in which the threads draw.
+ * A counter-based engine gives each unit of work its own stream,
+ * fixed by the seed and the number of the unit.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <fstream>
+#include <iostream>
+
+#include "CrPhiloxEngine.hh"
+
+namespace {
+  const unsigned int philoxM0 = 0xD2511F53u;
+  const unsigned int philoxM1 = 0xCD9E8D57u;
+  const unsigned int philoxW0 = 0x9E3779B9u;
+  const unsigned int philoxW1 = 0xBB67AE85u;
+
+  // Gives back the high and low 32 bits of a*b
+  inline void mulhilo(unsigned int a, unsigned int b,
+                      unsigned int& hi, unsigned int& lo)
+  {
+    unsigned long long product = (unsigned long long)a*b;
+    hi = (unsigned int)(product >> 32);
+    lo = (unsigned int)product;
+  }
+
+  // Philox4x32 with 10 rounds of the counter c and the key k
+  void philox(unsigned int c[4], unsigned int k0, unsigned int k1)
+  {
+    for (int round = 0; round < 10; round++){
+      unsigned int hi0, lo0, hi1, lo1;
+      mulhilo(philoxM0, c[0], hi0, lo0);
+      mulhilo(philoxM1, c[2], hi1, lo1);
+      unsigned int c0 = hi1^c[1]^k0;
+      unsigned int c2 = hi0^c[3]^k1;
+      c[0] = c0; c[1] = lo1; c[2] = c2; c[3] = lo0;
+      k0 += philoxW0;
+      k1 += philoxW1;
+    }
+  }
+
+  // splitmix64 finaliser, to spread the numbers of the sub-streams;
+  // a bijection of the 64-bit words
+  CrPhiloxEngine::Count mix(CrPhiloxEngine::Count x)
+  {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+  }
+}
+
+CrPhiloxEngine::CrPhiloxEngine(Count seed, Count stream)
+  : m_seed(seed), m_stream(stream), m_block(0), m_next(4)
+{
+  ;
+}
+
+CrPhiloxEngine::~CrPhiloxEngine()
+{
+  ;
+}
+
+// Gives back the engine of the sub-stream index.  The outer mix() is
+// a bijection, so the indices of one stream give distinct streams; the
+// inner one keeps the sub-streams of neighbouring streams apart.
+CrPhiloxEngine CrPhiloxEngine::stream(Count index) const
+{
+  return CrPhiloxEngine(m_seed, mix(mix(m_stream) + index + 0x9E3779B97F4A7C15ull));
+}
+
+CrPhiloxEngine::Count CrPhiloxEngine::position() const
+{
+  return 2*m_block - (4-m_next)/2;
+}
+
+void CrPhiloxEngine::skip(Count n)
+{
+  Count target = position()+n;
+  m_block = target/2;
+  m_next = 4;
+  if (target%2){
+    generate();
+    m_next = 2;
+  }
+}
+
+void CrPhiloxEngine::generate()
+{
+  m_output[0] = (unsigned int)m_block;
+  m_output[1] = (unsigned int)(m_block >> 32);
+  m_output[2] = (unsigned int)m_stream;
+  m_output[3] = (unsigned int)(m_stream >> 32);
+  philox(m_output, (unsigned int)m_seed, (unsigned int)(m_seed >> 32));
+  m_block++;
+  m_next = 0;
+}
+
+// 53 bits of two words, centred in their interval: in (0,1)
+double CrPhiloxEngine::flat()
+{
+  if (m_next > 2){ generate(); }
+  unsigned long long a = m_output[m_next] >> 5;
+  unsigned long long b = m_output[m_next+1] >> 6;
+  m_next += 2;
+  return ((a << 26) + b + 0.5) * (1.0/9007199254740992.0);
+}
+
+void CrPhiloxEngine::flatArray(const int size, double* vect)
+{
+  for (int i = 0; i < size; i++){ vect[i] = flat(); }
+}
+
+void CrPhiloxEngine::setSeed(long seed, int)
+{
+  m_seed = (unsigned long)seed;
+  m_block = 0;
+  m_next = 4;
+}
+
+// seeds[0] is the seed and, if the list (ended by 0) goes on,
+// seeds[1] the stream
+void CrPhiloxEngine::setSeeds(const long* seeds, int)
+{
+  if (seeds == 0){ return; }
+  m_stream = seeds[0] != 0 && seeds[1] != 0 ? (unsigned long)seeds[1] : 0;
+  setSeed(seeds[0], 0);
+}
+
+void CrPhiloxEngine::saveStatus(const char filename[]) const
+{
+  std::ofstream out(filename);
+  out << name() << " " << m_seed << " " << m_stream << " " << position() << std::endl;
+}
+
+void CrPhiloxEngine::restoreStatus(const char filename[])
+{
+  std::ifstream in(filename);
+  std::string engine;
+  Count seed, stream, position;
+  if (!(in >> engine >> seed >> stream >> position) || engine != name()){
+    std::cerr << "CrPhiloxEngine: no status in " << filename << std::endl;
+    return;
+  }
+  m_seed = seed;
+  m_stream = stream;
+  m_block = 0;
+  m_next = 4;
+  skip(position);
+}
+
+void CrPhiloxEngine::showStatus() const
+{
+  std::cout << name() << ": seed " << m_seed << " stream " << m_stream
+            << " position " << position() << std::endl;
+}
+
+std::string CrPhiloxEngine::name() const
+{
+  return "CrPhiloxEngine";
+}
@@ -0,0 +1,84 @@
+/**
+ * CrPhiloxEngine:
+ *  Counter-based random engine (Philox4x32-10) with independent
+ *  streams, usable wherever CRflux takes a CLHEP::HepRandomEngine.
+ */
+
+//$Header$
+
+#ifndef CrPhiloxEngine_H
+#define CrPhiloxEngine_H
+
+#include <string>
+#include <CLHEP/Random/RandomEngine.h>
+
+/** @class CrPhiloxEngine
+ *  @brief Philox4x32-10 random engine split into streams
+ *
+ * The n-th random block of a Philox engine is a keyed function of n
+ * (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3",
+ * SC11), so any block is reached without drawing the ones before it,
+ * and engines with different keys or counters never overlap.
+ * Here the key is the seed and the upper half of the 128-bit counter
+ * is a stream number: stream(i) derives the stream i of this stream,
+ * e.g. a job, then a segment of the orbit or a block of events within
+ * it.  The particles then depend on the work unit only, not on the
+ * thread or the number of threads which produce it.  skip() moves
+ * within a stream.
+ *
+ * The number of a sub-stream is a 64-bit hash of the number of its
+ * stream and its index.  The hash is a bijection of the index, so the
+ * sub-streams of one stream are always distinct; streams of different
+ * branches or depths are distinct only with overwhelming probability,
+ * as two of N streams share a number with a probability of about
+ * N*N/2^65 (3e-8 for a million streams).  Two streams with different
+ * numbers never overlap: each has 2^64 blocks of its own.
+ *
+ * flat() takes 53 bits from two 32-bit outputs and never gives back
+ * 0 or 1.  The engine derives from CLHEP::HepRandomEngine, so the
+ * components use it as any CLHEP engine; the CLHEP engines (e.g. the
+ * one of FluxSvc) are used as before.
+ */
+class CrPhiloxEngine : public CLHEP::HepRandomEngine
+{
+public:
+  typedef unsigned long long Count;
+
+  explicit CrPhiloxEngine(Count seed=12345, Count stream=0);
+  virtual ~CrPhiloxEngine();
+
+  /// Gives back the engine of the sub-stream index of this stream,
+  /// at its start; independent of the other streams with overwhelming
+  /// probability (see above)
+  CrPhiloxEngine stream(Count index) const;
+
+  /// Skip n numbers of flat()
+  void skip(Count n);
+
+  Count seed() const { return m_seed; }
+  Count streamNumber() const { return m_stream; }
+  /// Gives back the number of flat() since the start of the stream
+  Count position() const;
+
+  // CLHEP::HepRandomEngine
+  virtual double flat();
+  virtual void flatArray(const int size, double* vect);
+  virtual void setSeed(long seed, int);
+  virtual void setSeeds(const long* seeds, int);
+  virtual void saveStatus(const char filename[] = "CrPhiloxEngine.conf") const;
+  virtual void restoreStatus(const char filename[] = "CrPhiloxEngine.conf");
+  virtual void showStatus() const;
+  virtual std::string name() const;
+
+private:
+  /// Fill m_output with the block m_block and step to the next one
+  void generate();
+
+  Count m_seed;
+  Count m_stream;
+  Count m_block;          ///< counter of the next block within the stream
+  unsigned int m_output[4];
+  int m_next;             ///< next unused word of m_output, 4 for none
+};
+
+#endif // CrPhiloxEngine_H
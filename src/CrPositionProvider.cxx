@@ -0,0 +1,93 @@
+/****************************************************************************
+ * CrPositionProvider.cxx:
+ ****************************************************************************
+ * The components used to reach the GPS through the FluxSvc stored in
+ * the CrLocation singleton, which tied them to Gaudi.  They ask a
+ * CrPositionProvider instead; CrGPSPosition gives the same position
+ * as before, CrFixedPosition lets a program without the framework
+ * place the observer.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include "CrPositionProvider.hh"
+
+#include "astro/GPS.h"
+#include "astro/EarthCoordinate.h"
+
+CrPositionProvider* CrPositionProvider::s_current = 0;
+
+CrPositionProvider::~CrPositionProvider()
+{
+  ;
+}
+
+CrPositionProvider* CrPositionProvider::current()
+{
+  if (s_current == 0){
+    static CrGPSPosition gps(astro::GPS::instance());
+    s_current = &gps;
+  }
+  return s_current;
+}
+
+void CrPositionProvider::setCurrent(CrPositionProvider* provider)
+{
+  s_current = provider;
+}
+
+
+CrGPSPosition::CrGPSPosition(astro::GPS* gps)
+  : m_gps(gps)
+{
+  ;
+}
+
+void CrGPSPosition::position(double& latitude, double& longitude,
+                             double& altitude, double& time) const
+{
+  astro::EarthCoordinate pos = m_gps->earthpos();
+  latitude = pos.latitude();
+  longitude = pos.longitude();
+  altitude = pos.altitude();
+  time = m_gps->time();
+}
+
+Subject& CrGPSPosition::notification()
+{
+  return m_gps->notification();
+}
+
+
+CrFixedPosition::CrFixedPosition(double latitude, double longitude,
+                                 double altitude, double time)
+  : m_latitude(latitude), m_longitude(longitude),
+    m_altitude(altitude), m_time(time)
+{
+  ;
+}
+
+void CrFixedPosition::setPosition(double latitude, double longitude,
+                                  double altitude, double time)
+{
+  m_latitude = latitude;
+  m_longitude = longitude;
+  m_altitude = altitude;
+  m_time = time;
+  m_notification.notify();
+}
+
+void CrFixedPosition::position(double& latitude, double& longitude,
+                               double& altitude, double& time) const
+{
+  latitude = m_latitude;
+  longitude = m_longitude;
+  altitude = m_altitude;
+  time = m_time;
+}
+
+Subject& CrFixedPosition::notification()
+{
+  return m_notification;
+}
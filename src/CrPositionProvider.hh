@@ -0,0 +1,92 @@
+/**
+ * CrPositionProvider:
+ *  Source of the position and time of the observer for the
+ *  cosmic-ray components.
+ */
+
+//$Header$
+
+#ifndef CrPositionProvider_H
+#define CrPositionProvider_H
+
+#include "facilities/Observer.h"
+
+namespace astro {class GPS;}
+
+/** @class CrPositionProvider
+ *  @brief position and time followed by the components
+ *
+ * A component (CrSpectrum) takes the provider given by current() when
+ * it is made, asks it for the position, and is called back through
+ * notification() whenever the position changes.  Inside Gaudi the
+ * provider is the GPS of FluxSvc (set by RegisterCRflux); a program
+ * without the framework sets its own provider, e.g. a CrFixedPosition,
+ * before it makes the components.  Without a provider set, current()
+ * gives back the astro::GPS singleton.
+ */
+class CrPositionProvider
+{
+public:
+  virtual ~CrPositionProvider();
+
+  /// Gives back the geographic latitude and longitude [deg], the
+  /// altitude [km] and the time [s] of the observer
+  virtual void position(double& latitude, double& longitude,
+                        double& altitude, double& time) const=0;
+
+  /// Subject whose observers are called when the position changes
+  virtual Subject& notification()=0;
+
+  /// The provider of the components made from now on; not owned
+  static CrPositionProvider* current();
+  static void setCurrent(CrPositionProvider* provider);
+
+private:
+  static CrPositionProvider* s_current;
+};
+
+/** @class CrGPSPosition
+ *  @brief the position of an astro::GPS
+ */
+class CrGPSPosition : public CrPositionProvider
+{
+public:
+  explicit CrGPSPosition(astro::GPS* gps);
+
+  void position(double& latitude, double& longitude,
+                double& altitude, double& time) const;
+  Subject& notification();
+
+private:
+  astro::GPS* m_gps;
+};
+
+/** @class CrFixedPosition
+ *  @brief a position set by the program
+ *
+ * The components follow setPosition(); a batch program moves the
+ * observer along its own orbit with it.
+ */
+class CrFixedPosition : public CrPositionProvider
+{
+public:
+  CrFixedPosition(double latitude=0, double longitude=0,
+                  double altitude=500, double time=0);
+
+  /// Move the observer and notify the components
+  void setPosition(double latitude, double longitude,
+                   double altitude, double time);
+
+  void position(double& latitude, double& longitude,
+                double& altitude, double& time) const;
+  Subject& notification();
+
+private:
+  double m_latitude;  ///< [deg]
+  double m_longitude; ///< [deg]
+  double m_altitude;  ///< [km]
+  double m_time;      ///< [s]
+  Subject m_notification;
+};
+
+#endif // CrPositionProvider_H
@@ -58,7 +58,7 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrPositronReentrant.hh"
-#include "CrPositronSubReentrant.hh"
+#include "CrLeptonSecondaryModel.hh"
 
 
 typedef double G4double;
@@ -109,25 +109,13 @@ namespace {
 
 CrPositronReentrant::CrPositronReentrant():CrSpectrum()
 {
-  crPositronReentrant_0001 = new CrPositronReentrant_0001();
-  crPositronReentrant_0102 = new CrPositronReentrant_0102();
-  crPositronReentrant_0203 = new CrPositronReentrant_0203();
-  crPositronReentrant_0304 = new CrPositronReentrant_0304();
-  crPositronReentrant_0405 = new CrPositronReentrant_0405();
-  crPositronReentrant_0506 = new CrPositronReentrant_0506();
-  crPositronReentrant_0611 = new CrPositronReentrant_0611();
+  crLeptonSecondaryModel(m_model, true);
 }
 
 
 CrPositronReentrant::~CrPositronReentrant()
 {
-  delete crPositronReentrant_0001;
-  delete crPositronReentrant_0102;
-  delete crPositronReentrant_0203;
-  delete crPositronReentrant_0304;
-  delete crPositronReentrant_0405;
-  delete crPositronReentrant_0506;
-  delete crPositronReentrant_0611;
+  ;
 }
 
 
@@ -149,61 +137,7 @@ std::pair<G4double,G4double> CrPositronReentrant::dir
 // Gives back particle energy
 G4double CrPositronReentrant::energySrc(CLHEP::HepRandomEngine* engine) const
 {
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.05){
-    return crPositronReentrant_0001->energy(engine);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.05 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.05;
-    r2 = 0.15-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronReentrant_0001->energy(engine);
-    } else {
-      return crPositronReentrant_0102->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronReentrant_0102->energy(engine);
-    } else {
-      return crPositronReentrant_0203->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronReentrant_0203->energy(engine);
-    } else {
-      return crPositronReentrant_0304->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronReentrant_0304->energy(engine);
-    } else {
-      return crPositronReentrant_0405->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronReentrant_0405->energy(engine);
-    } else {
-      return crPositronReentrant_0506->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronReentrant_0506->energy(engine);
-    } else {
-      return crPositronReentrant_0611->energy(engine);
-    }
-  } else{
-      return crPositronReentrant_0611->energy(engine);
-  }
-
+  return m_model.sampleEnergy(fabs(m_geomagneticLatitude)*M_PI/180.0, engine);
 }
 
 
@@ -215,47 +149,16 @@ G4double CrPositronReentrant::energySrc(CLHEP::HepRandomEngine* engine) const
 G4double CrPositronReentrant::flux() const
 {
   // energy integrated vertically downward flux, [c/s/m^2/sr]
-  G4double downwardFlux; 
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.05){
-    downwardFlux = crPositronReentrant_0001->downwardFlux();
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.05 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.05;
-    r2 = 0.15-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronReentrant_0001->downwardFlux()
-             +r1*crPositronReentrant_0102->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronReentrant_0102->downwardFlux()
-             +r1*crPositronReentrant_0203->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronReentrant_0203->downwardFlux()
-             +r1*crPositronReentrant_0304->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronReentrant_0304->downwardFlux()
-             +r1*crPositronReentrant_0405->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronReentrant_0405->downwardFlux()
-             +r1*crPositronReentrant_0506->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronReentrant_0506->downwardFlux()
-             +r1*crPositronReentrant_0611->downwardFlux() )/(r1+r2);
-  } else{
-    downwardFlux = crPositronReentrant_0611->downwardFlux();
-  }
+  G4double downwardFlux = m_model.flux(fabs(m_geomagneticLatitude)*M_PI/180.0);
 
   return m_normalization*downwardFlux; // [c/s/m^2/sr]
+}
 
 
+// Gives back the table of the model
+const CrLatitudeBinnedModel& CrPositronReentrant::model() const
+{
+  return m_model;
 }
 
 
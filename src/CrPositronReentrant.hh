@@ -12,16 +12,10 @@
 #include <string>
 
 #include "CrSpectrum.hh"
+#include "CrLatitudeBinnedModel.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
-class CrPositronReentrant_0001;
-class CrPositronReentrant_0102;
-class CrPositronReentrant_0203;
-class CrPositronReentrant_0304;
-class CrPositronReentrant_0405;
-class CrPositronReentrant_0506;
-class CrPositronReentrant_0611;
 
 class CrPositronReentrant : public CrSpectrum
 {
@@ -48,16 +42,12 @@ public:
   // Gives back the name of the component
   std::string title() const;
 
-  // cr particle generator sorted in theta_M
-private:
-  CrPositronReentrant_0001* crPositronReentrant_0001;
-  CrPositronReentrant_0102* crPositronReentrant_0102;
-  CrPositronReentrant_0203* crPositronReentrant_0203;
-  CrPositronReentrant_0304* crPositronReentrant_0304;
-  CrPositronReentrant_0405* crPositronReentrant_0405;
-  CrPositronReentrant_0506* crPositronReentrant_0506;
-  CrPositronReentrant_0611* crPositronReentrant_0611;
+  // Gives back the table of the model
+  const CrLatitudeBinnedModel& model() const;
 
+  // spectra sorted in theta_M
+private:
+  CrLatitudeBinnedModel m_model;
 
 };
 #endif // CrPositronReentrant_H
@@ -58,7 +58,7 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrPositronSplash.hh"
-#include "CrPositronSubSplash.hh"
+#include "CrLeptonSecondaryModel.hh"
 
 
 typedef double G4double;
@@ -109,25 +109,13 @@ namespace {
 
 CrPositronSplash::CrPositronSplash():CrSpectrum()
 {
-  crPositronSplash_0001 = new CrPositronSplash_0001();
-  crPositronSplash_0102 = new CrPositronSplash_0102();
-  crPositronSplash_0203 = new CrPositronSplash_0203();
-  crPositronSplash_0304 = new CrPositronSplash_0304();
-  crPositronSplash_0405 = new CrPositronSplash_0405();
-  crPositronSplash_0506 = new CrPositronSplash_0506();
-  crPositronSplash_0611 = new CrPositronSplash_0611();
+  crLeptonSecondaryModel(m_model, true);
 }
 
 
 CrPositronSplash::~CrPositronSplash()
 {
-  delete crPositronSplash_0001;
-  delete crPositronSplash_0102;
-  delete crPositronSplash_0203;
-  delete crPositronSplash_0304;
-  delete crPositronSplash_0405;
-  delete crPositronSplash_0506;
-  delete crPositronSplash_0611;
+  ;
 }
 
 
@@ -150,61 +138,7 @@ std::pair<G4double,G4double> CrPositronSplash::dir
 // Gives back particle energy
 G4double CrPositronSplash::energySrc(CLHEP::HepRandomEngine* engine) const
 {
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.05){
-    return crPositronSplash_0001->energy(engine);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.05 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.05;
-    r2 = 0.15-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronSplash_0001->energy(engine);
-    } else {
-      return crPositronSplash_0102->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronSplash_0102->energy(engine);
-    } else {
-      return crPositronSplash_0203->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronSplash_0203->energy(engine);
-    } else {
-      return crPositronSplash_0304->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronSplash_0304->energy(engine);
-    } else {
-      return crPositronSplash_0405->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronSplash_0405->energy(engine);
-    } else {
-      return crPositronSplash_0506->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crPositronSplash_0506->energy(engine);
-    } else {
-      return crPositronSplash_0611->energy(engine);
-    }
-  } else{
-      return crPositronSplash_0611->energy(engine);
-  }
-
+  return m_model.sampleEnergy(fabs(m_geomagneticLatitude)*M_PI/180.0, engine);
 }
 
 
@@ -216,47 +150,16 @@ G4double CrPositronSplash::energySrc(CLHEP::HepRandomEngine* engine) const
 G4double CrPositronSplash::flux() const
 {
   // energy integrated vertically downward flux, [c/s/m^2/sr]
-  G4double downwardFlux; 
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.05){
-    downwardFlux = crPositronSplash_0001->downwardFlux();
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.05 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.05;
-    r2 = 0.15-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronSplash_0001->downwardFlux()
-             +r1*crPositronSplash_0102->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronSplash_0102->downwardFlux()
-             +r1*crPositronSplash_0203->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronSplash_0203->downwardFlux()
-             +r1*crPositronSplash_0304->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronSplash_0304->downwardFlux()
-             +r1*crPositronSplash_0405->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronSplash_0405->downwardFlux()
-             +r1*crPositronSplash_0506->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crPositronSplash_0506->downwardFlux()
-             +r1*crPositronSplash_0611->downwardFlux() )/(r1+r2);
-  } else{
-    downwardFlux = crPositronSplash_0611->downwardFlux();
-  }
+  G4double downwardFlux = m_model.flux(fabs(m_geomagneticLatitude)*M_PI/180.0);
 
   return m_normalization*downwardFlux; // [c/s/m^2/sr]
+}
 
 
+// Gives back the table of the model
+const CrLatitudeBinnedModel& CrPositronSplash::model() const
+{
+  return m_model;
 }
 
 
@@ -12,16 +12,10 @@
 #include <string>
 
 #include "CrSpectrum.hh"
+#include "CrLatitudeBinnedModel.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
-class CrPositronSplash_0001;
-class CrPositronSplash_0102;
-class CrPositronSplash_0203;
-class CrPositronSplash_0304;
-class CrPositronSplash_0405;
-class CrPositronSplash_0506;
-class CrPositronSplash_0611;
 
 class CrPositronSplash : public CrSpectrum
 {
@@ -48,16 +42,12 @@ public:
   // Gives back the name of the component
   std::string title() const;
 
-  // cr particle generator sorted in theta_M
-private:
-  CrPositronSplash_0001* crPositronSplash_0001;
-  CrPositronSplash_0102* crPositronSplash_0102;
-  CrPositronSplash_0203* crPositronSplash_0203;
-  CrPositronSplash_0304* crPositronSplash_0304;
-  CrPositronSplash_0405* crPositronSplash_0405;
-  CrPositronSplash_0506* crPositronSplash_0506;
-  CrPositronSplash_0611* crPositronSplash_0611;
+  // Gives back the table of the model
+  const CrLatitudeBinnedModel& model() const;
 
+  // spectra sorted in theta_M
+private:
+  CrLatitudeBinnedModel m_model;
 
 };
 #endif // CrPositronSplash_H
@@ -0,0 +1,414 @@
+/**
+ * CrPrimarySpectrum:
+ *  The spectrum of the primary cosmic rays (a power law in rigidity,
+ *  modulated by the sun and cut by the geomagnetic field) and its
+ *  sampling, for a species given by a traits class.
+ */
+
+//$Header$
+
+#ifndef CrPrimarySpectrum_H
+#define CrPrimarySpectrum_H
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <CLHEP/Random/RandomEngine.h>
+
+#include "CrSpectrum.hh"
+#include "CrBatchMath.hh"
+#include "CrFluxIntegralTable.hh"
+#include "CrSamplingCounters.hh"
+
+/** @class CrPrimarySampler
+ *  @brief the envelopes of the energy sampler of a primary
+ *
+ * The two envelopes of CrPrimarySpectrum::energySrc() at given energy
+ * limits, cutoff rigidity, solar potential and charge.  They cost four
+ * evaluations of pow(), so a component whose working point stays keeps
+ * them for all its particles.
+ *
+ * A component may keep them as long as the working point stays in the
+ * bin of (cor, phi) where they were made (see covers()): 0.005 in
+ * log(cor/GV) and 10 MV in phi, the bins of the table of
+ * CrProtonPrimary.  The energies then follow the spectrum at the point
+ * where the bin was entered.
+ */
+struct CrPrimarySampler
+{
+  double lowE, cutE, highE; ///< [GeV]
+  double cor; ///< [GV]
+  double phi; ///< [MV]
+  double z;
+  double lowSpec; ///< spectrum at lowE
+  double slope; ///< of the linear envelope below cutE
+  double randMin2, randMax2; ///< integral of the power law at cutE and highE
+  double share1; ///< area of the linear envelope over the total
+  int corBin, phiBin; ///< bins of cor and phi
+
+  // bin widths in log(cor/GV) and in phi [MV]
+  static int corBinOf(double cor){ return int(floor(log(cor)/0.005)); }
+  static int phiBinOf(double phi){ return int(floor(phi/10.0)); }
+
+  // Whether the sampler was made in the bin of (cor, phi); one not
+  // made yet (value-initialised, highE = 0) covers no bin.
+  bool covers(double cor, double phi) const {
+    return highE > 0 && corBin == corBinOf(cor) && phiBin == phiBinOf(phi);
+  }
+};
+
+/** @class CrPrimarySpectrum
+ *  @brief kinematics and two-envelope sampler of a primary species
+ *
+ * The Species traits give, as compile-time constants,
+ * @verbatum
+ *   restE          rest energy [GeV]
+ *   charge         Z
+ *   normalization  A of org_spec(E) = A * rigidity(E)**-a
+ *   index          a
+ *   cutoffIndex    exponent of geomag_cut = 1/(1 + (rigidity/cor)**cutoffIndex)
+ *   relativistic   true for E >> restE (rigidity = E/Z)
+ *   title()        name of the component, used for the counters
+ * @endverbatum
+ * so each instantiation folds the constants into the kinematics.  The
+ * charge is an argument with the traits value as default, for the
+ * heavy ions whose Z is drawn at run time.
+ *
+ *  j(E) = mod_spec(E, phi) * geomag_cut(E, CutOff)
+ *    mod_spec(E, phi) = org_spec(E+Z*phi*1e-3) *
+ *     ((E+restE)**2 - restE**2)/((E+restE+Z*phi*1e-3)**2-restE**2)
+ *  Solar modulation model (mod_spec) is from:
+ *     Gleeson, L. J. and Axford, W. I. 1968, ApJ, 154, 1011-1026 (Eq. 11)
+ *  geomag_cut formula:
+ *    an eyeball fitting function to represent the AMS proton data.
+ */
+template <class Species>
+class CrPrimarySpectrum
+{
+public:
+  // gives back v/c as a function of kinetic Energy
+  static double beta(double E /* GeV */){
+    return Species::relativistic ? 1.0 : sqrt(1 - pow(E/Species::restE+1, -2));
+  }
+
+  // gives back the rigidity (p/Ze where p is the momentum, e means
+  // electron charge magnitude, and Z is the atomic number) in units of [GV],
+  // as a function of kinetic Energy [GeV].
+  static double rigidity(double E /* GeV */, double z = Species::charge){
+    if (Species::relativistic){ return E/z; }
+    return sqrt(pow(E + Species::restE, 2) - pow(Species::restE, 2))/z;
+  }
+
+  // gives back the kinetic energy [GeV] as a function of rigidity [GV]
+  static double energy(double rigidity /* GV */, double z = Species::charge){
+    if (Species::relativistic){ return rigidity*z; }
+    return sqrt(pow(rigidity*z, 2) + pow(Species::restE, 2)) - Species::restE;
+  }
+
+  // Gives back the geomagnetic cutoff factor to the intrinsic
+  // primary cosmic ray spectrum for a kinetic energy E(GeV)
+  // and a cutoff rigidity cor(GV)
+  static double geomag_cut(double E, double cor /* GV */, double z = Species::charge){
+    return 1./(1 + pow(rigidity(E, z)/cor, Species::cutoffIndex));
+  }
+
+  // The unmodulated primary spectrum outside the Solar system
+  static double org_spec(double E /* GeV */, double z = Species::charge){
+    return Species::normalization * pow(rigidity(E, z), -Species::index);
+  }
+
+  // The modulated flux for a "phi" value (force-field approximation);
+  // the potential is multiplied by the charge.
+  static double mod_spec(double E /* GeV */, double phi /* MV */, double z = Species::charge){
+    const double restE = Species::restE;
+    return org_spec(E + z*phi*1e-3, z) * (pow(E+restE, 2) - pow(restE, 2))
+      / (pow(E+restE+z*phi*1e-3, 2) - pow(restE, 2));
+  }
+
+  // The final spectrum of the primary
+  static double spectrum(double E /* GeV */, double cor /* GV */, double phi /* MV */,
+                         double z = Species::charge){
+    return mod_spec(E, phi, z) * geomag_cut(E, cor, z);
+  }
+
+  // The envelopes of energySrc() (see CrPrimarySampler).
+  // Below the cutoff (lowE < E < cutE) the spectrum is enveloped by
+  // a linear function, which is zero at lowE; above it (cutE < E <
+  // highE) by the power law A*(E/Z)**-a, whose integral is inverted.
+  static CrPrimarySampler sampler(double lowE, double cutE, double highE,
+                                  double cor, double phi, double z = Species::charge){
+    const double A = Species::normalization, a = Species::index;
+    CrPrimarySampler s;
+    s.lowE = lowE; s.cutE = cutE; s.highE = highE;
+    s.cor = cor; s.phi = phi; s.z = z;
+    s.corBin = CrPrimarySampler::corBinOf(cor);
+    s.phiBin = CrPrimarySampler::phiBinOf(phi);
+    s.lowSpec = spectrum(lowE, cor, phi, z);
+    s.slope = (spectrum(cutE, cor, phi, z) - s.lowSpec)/(cutE-lowE);
+    const double envelope1_area = 0.5 * s.slope * pow(cutE-lowE, 2) + s.lowSpec * (cutE-lowE);
+    s.randMin2 = A*z/(-a+1) * pow(cutE/z, -a+1);
+    s.randMax2 = A*z/(-a+1) * pow(highE/z, -a+1);
+    const double envelope2_area = s.randMax2 - s.randMin2;
+    s.share1 = envelope1_area/(envelope1_area + envelope2_area);
+    return s;
+  }
+
+  // The random number generator for the primary component.
+  // The excess of the envelopes is removed by comparing with the
+  // true spectrum.
+  static double energySrc(CLHEP::HepRandomEngine* engine,
+                          double lowE, double cutE, double highE,
+                          double cor, double phi, double z = Species::charge){
+    return energySrc(engine, sampler(lowE, cutE, highE, cor, phi, z));
+  }
+
+  // The same with the envelopes made before
+  static double energySrc(CLHEP::HepRandomEngine* engine, const CrPrimarySampler& s){
+    const double A = Species::normalization, a = Species::index;
+    const double lowE = s.lowE, cutE = s.cutE, cor = s.cor, phi = s.phi, z = s.z;
+    const double lowSpec = s.lowSpec, slope = s.slope;
+    const double rand_min_2 = s.randMin2, rand_max_2 = s.randMax2;
+
+    double E; // E means energy in GeV
+    CRFLUX_COUNTER(lowCounter, std::string(Species::title()) + " energy below cutoff");
+    CRFLUX_COUNTER(highCounter, std::string(Species::title()) + " energy above cutoff");
+    while (1){
+      if (engine->flat() <= s.share1){
+        // the larger of two uniform energies follows the linear envelope
+        double E1 = engine->flat() * (cutE-lowE) + lowE;
+        double E2 = engine->flat() * (cutE-lowE) + lowE;
+        E = E1>E2 ? E1 : E2;
+        CRFLUX_COUNT_ATTEMPT(lowCounter, 4);
+        if (engine->flat() <=
+            spectrum(E, cor, phi, z) / (slope * (E-lowE) + lowSpec))
+          { CRFLUX_COUNT_ACCEPT(lowCounter); break; }
+      } else {
+        double r = engine->flat() * (rand_max_2 - rand_min_2) + rand_min_2;
+        E = z*pow((-a+1)/(A*z) * r, 1./(-a+1));
+        CRFLUX_COUNT_ATTEMPT(highCounter, 3);
+        if (engine->flat() <= spectrum(E, cor, phi, z) / (A * pow(E/z, -a)))
+          { CRFLUX_COUNT_ACCEPT(highCounter); break; }
+      }
+    }
+    return E;
+  }
+
+  // The sampler of energySrc() for n energies at once.  The candidates
+  // are made in blocks, four random numbers each drawn with flatArray,
+  // their spectrum and envelope are computed with CrBatchMath, and the
+  // accepted ones are kept in order until n are filled.
+  static void energyBlock(CLHEP::HepRandomEngine* engine, int n, double* energy,
+                          double lowE, double cutE, double highE,
+                          double cor, double phi, double z = Species::charge){
+    energyBlock(engine, n, energy, sampler(lowE, cutE, highE, cor, phi, z));
+  }
+
+  // The same with the envelopes made before
+  static void energyBlock(CLHEP::HepRandomEngine* engine, int n, double* energy,
+                          const CrPrimarySampler& s){
+    const double A = Species::normalization, a = Species::index;
+    const double lowE = s.lowE, cutE = s.cutE, cor = s.cor, z = s.z;
+    const double restE = Species::restE, dE = z*s.phi*1e-3;
+    const double lowSpec = s.lowSpec, slope = s.slope;
+    const double rand_min_2 = s.randMin2, rand_max_2 = s.randMax2;
+    const double share1 = s.share1;
+
+    CRFLUX_COUNTER(lowCounter, std::string(Species::title()) + " energy below cutoff");
+    CRFLUX_COUNTER(highCounter, std::string(Species::title()) + " energy above cutoff");
+    std::vector<double> rnd, E, x, f, g;
+    std::vector<int> low, index;
+    int filled = 0;
+    while (filled < n){
+      // twice the energies missing, to be done in about two blocks
+      int m = 2*(n-filled);
+      if (m < CrBatchMath::lanes){ m = CrBatchMath::lanes; }
+      rnd.resize(4*m); E.resize(m); x.resize(m); f.resize(m); g.resize(m);
+      low.resize(m); index.resize(m);
+      engine->flatArray(4*m, &rnd[0]);
+
+      // below the cutoff the larger of two uniform energies; above it
+      // z*pow((-a+1)/(A*z)*r, 1/(-a+1)), raised for all and selected
+      for (int i = 0; i < m; i++){
+        const double* u = &rnd[4*i];
+        low[i] = u[0] <= share1;
+        double E1 = u[1] * (cutE-lowE) + lowE;
+        double E2 = u[2] * (cutE-lowE) + lowE;
+        E[i] = E1>E2 ? E1 : E2;
+        x[i] = low[i] ? 1.0 :
+          (-a+1)/(A*z) * (u[1] * (rand_max_2 - rand_min_2) + rand_min_2);
+      }
+      CrBatchMath::pow(m, &x[0], 1./(-a+1), &x[0]);
+      for (int i = 0; i < m; i++){
+        if (!low[i]){ E[i] = z*x[i]; }
+        x[i] = E[i]/z;
+      }
+      CrBatchMath::powerLaw(m, &x[0], A, a, &g[0]);
+      for (int i = 0; i < m; i++){
+        if (low[i]){ g[i] = slope * (E[i]-lowE) + lowSpec; }
+      }
+
+      // spectrum(): org_spec at E+dE, the modulation factor and geomag_cut
+      for (int i = 0; i < m; i++){ x[i] = rigidity(E[i] + dE, z); }
+      CrBatchMath::powerLaw(m, &x[0], A, a, &f[0]);
+      for (int i = 0; i < m; i++){
+        f[i] *= (pow(E[i]+restE, 2) - pow(restE, 2)) / (pow(E[i]+restE+dE, 2) - pow(restE, 2));
+        x[i] = rigidity(E[i], z)/cor;
+      }
+      CrBatchMath::pow(m, &x[0], double(Species::cutoffIndex), &x[0]);
+      for (int i = 0; i < m; i++){ f[i] /= 1 + x[i]; }
+
+      // the last random number of each candidate decides
+      for (int i = 0; i < m; i++){ rnd[i] = rnd[4*i+3]; }
+      int accepted = CrBatchMath::accept(m, &rnd[0], &f[0], &g[0], &index[0]);
+      for (int i = 0; i < m; i++){ CRFLUX_COUNT_ATTEMPT(low[i] ? lowCounter : highCounter, 4); }
+      for (int j = 0; j < accepted; j++){
+        CRFLUX_COUNT_ACCEPT(low[index[j]] ? lowCounter : highCounter);
+        if (filled < n){ energy[filled++] = E[index[j]]; }
+      }
+    }
+  }
+
+  // Gives back the constants of the spectrum, for the hash of the
+  // flux table
+  static std::vector<double> parameters(){
+    const double values[] = {Species::restE, Species::charge, Species::normalization,
+                             Species::index, Species::cutoffIndex,
+                             Species::relativistic ? 1.0 : 0.0};
+    return std::vector<double>(values, values + sizeof(values)/sizeof(values[0]));
+  }
+};
+
+
+/** @class CrPrimaryComponent
+ *  @brief CrSpectrum of a primary species with the East-West effect
+ *
+ * Besides the traits of CrPrimarySpectrum, the Species gives
+ * @verbatum
+ *   highE          upper energy limit [GeV]
+ *   eastWestCoeff  coeff and polarity given to CrSpectrum::EW_dir
+ *   polarity
+ *   particle()     name of the particle
+ * @endverbatum
+ * The flux is uniform above the earth horizon, cos(theta) from 1 to
+ * -0.4; its energy integral is tabulated in a CrFluxIntegralTable.
+ * A component is then CrPrimaryComponent<Species> and its
+ * constructor; the energy limits follow the cutoff rigidity through
+ * setEnergyLimits().
+ */
+template <class Species>
+class CrPrimaryComponent : public CrSpectrum
+{
+public:
+  typedef CrPrimarySpectrum<Species> Spectrum;
+
+  CrPrimaryComponent() { CrPrimaryComponent::setEnergyLimits(); }
+
+  // Set satellite position, altitude and observation time and
+  // calculate energies related to COR.
+  // These energies will be used to generate particles.
+  void setPosition(double latitude, double longitude){
+    CrSpectrum::setPosition(latitude, longitude);
+    setEnergyLimits();
+  }
+  void setPosition(double latitude, double longitude, double time){
+    CrSpectrum::setPosition(latitude, longitude, time);
+    setEnergyLimits();
+  }
+  void setPosition(double latitude, double longitude, double time, double altitude){
+    CrSpectrum::setPosition(latitude, longitude, time, altitude);
+    setEnergyLimits();
+  }
+
+  // Set geomagnetic cutoff rigidity and calculate the energies related.
+  void setCutOffRigidity(double cor){
+    CrSpectrum::setCutOffRigidity(cor);
+    setEnergyLimits();
+  }
+
+  // Gives back particle direction in (cos(theta), phi)
+  // return: cos(theta) and phi [rad]
+  // The downward direction has plus sign in cos(theta),
+  // and phi = 0 for the particle comming from east
+  // and phi=pi/2 for that comming from north
+  std::pair<double,double> dir(double energy, CLHEP::HepRandomEngine* engine) const{
+    // CrSpectrum class takes care of direction generation
+    double rig = Spectrum::rigidity(energy*0.001);
+    return CrSpectrum::EW_dir(rig, Species::eastWestCoeff, Species::polarity, engine);
+  }
+
+  // Gives back particle energy
+  double energySrc(CLHEP::HepRandomEngine* engine) const{
+    return Spectrum::energySrc(engine, m_lowE, m_cutE, m_highE,
+                               m_cutOffRigidity, m_solarWindPotential);
+  }
+
+  // Fill n particles at once, with the energies of
+  // CrPrimarySpectrum::energyBlock()
+  void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                   double* energy, double* cosTheta, double* phi) const{
+    if (n<=0){ return; }
+    Spectrum::energyBlock(engine, n, energy, m_lowE, m_cutE, m_highE,
+                          m_cutOffRigidity, m_solarWindPotential);
+    for (int i = 0; i < n; i++){
+      std::pair<double,double> d = dir(energy[i], engine);
+      cosTheta[i] = d.first;
+      phi[i] = d.second;
+    }
+  }
+
+  // flux() returns the energy integrated flux averaged over
+  // the region from which particle is coming from [c/s/m^2/sr].
+  // flux()*solidAngle() is used as relative normalization among
+  // "primary", "reentrant" and "splash".
+  double flux() const{
+    return integralTable().flux(m_cutOffRigidity, m_solarWindPotential);
+  }
+
+  // Gives back the vertically downward flux [c/s/m^2/sr] integrated
+  // between the energy limits, tabulated at the first call and again
+  // when the nodes of the tables change
+  static const CrFluxIntegralTable& integralTable(){
+    static CrFluxIntegralTable::Current current(Species::title(), &spectrumAt, &lowerLimit,
+                                                Species::highE, Spectrum::parameters());
+    return current.table();
+  }
+
+  // Gives back solid angle from which particle comes
+  double solidAngle() const{
+    // * 1.4 since Cos(theta) ranges from 1 to -0.4
+    return 2 * M_PI * 1.4;
+  }
+
+  // Gives back particle name
+  const char* particleName() const { return Species::particle(); }
+
+  // Gives back the name of the component
+  std::string title() const { return Species::title(); }
+
+protected:
+  // Set lower and higher energy limit of the primary (GeV).
+  // At m_lowE, flux of primary can be assumed to be 0, due to
+  // geomagnetic cutoff; m_cutE corresponds to the cutoff rigidity.
+  virtual void setEnergyLimits(){
+    m_lowE = Spectrum::energy(m_cutOffRigidity/2.5);
+    m_highE = Species::highE;
+    m_cutE = Spectrum::energy(m_cutOffRigidity);
+  }
+
+  // The spectrum and m_lowE as functions, for the flux table
+  static double spectrumAt(double E, double cor, double phi){
+    return Spectrum::spectrum(E, cor, phi);
+  }
+  static double lowerLimit(double cor){ return Spectrum::energy(cor/2.5); }
+
+  // The lower and higher (kinetic) energy limits of the primaries
+  // generated and the kinetic energy corresponding to the cutoff
+  // rigidity.
+  double m_lowE; ///< [GeV]
+  double m_highE; ///< [GeV]
+  double m_cutE; ///< [GeV]
+};
+
+#endif // CrPrimarySpectrum_H
@@ -62,7 +62,6 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrProtonReentrant.hh"
-#include "CrProtonSubReentrant.hh"
 
 
 typedef double G4double;
@@ -72,6 +71,9 @@ typedef double G4double;
 namespace {
   // rest energy (rest mass) of proton in units of GeV
   const G4double restE = 0.938;
+  // lower and higher energy limit of secondary proton in units of GeV
+  const G4double lowE_reent  = 0.01;
+  const G4double highE_reent = 20.0;
 
 
   // gives back v/c as a function of kinetic Energy
@@ -91,38 +93,121 @@ namespace {
     return sqrt(pow(rigidity, 2) + pow(restE, 2)) - restE;
   }
 
+  // The downward proton spectra sorted on theta_M (2003-02, T. Mizuno).
+  // Reference: AMS data, Alcaratz et al. 2000, Phys. Let. B 490, 27.
+  // Above 100 MeV, we modeled AMS data with analytic function.
+  // Below 100 MeV, we do not have enouth information and just
+  // extrapolated the spectrum down to 10 MeV.
+  // j(E) is in [c/s/m^2/sr/MeV]; the node of the bin a<theta_M<b is
+  // at b-0.05.
+  void builtinModel(CrLatitudeBinnedModel& model){
+    typedef CrLatitudeBinnedModel M;
+    M::Bin bin;
+    bin.eMin = lowE_reent;
+
+    // 0<theta_M<0.2: j(E) = 0.136*(E/100MeV)^0.4 below 100 MeV,
+    // 0.123*(E/GeV)^-0.155*exp(-(E/0.51GeV)^0.845) above
+    bin.latitude = 0.15;
+    bin.ang = -0.5;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.136*pow(10.0, 0.4), -0.4, 0.1));
+    bin.segments.push_back(M::cutOffSegment(0.123, 0.155, 0.509, highE_reent));
+    model.addBin(bin);
+
+    // 0.2<theta_M<0.3: 0.1*(E/100MeV)^0.4 below 100 MeV,
+    // 0.1*(E/100MeV)^-0.87 in 100-600 MeV, 0.1*pow(6, -0.87)*(E/600MeV)^-2.53 above
+    bin.latitude = 0.25;
+    bin.ang = 0.0;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(10.0, 0.4), -0.4, 0.1));
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(10.0, -0.87), 0.87, 0.6));
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(6.0, -0.87)*pow(1.0/0.6, -2.53), 2.53, highE_reent));
+    model.addBin(bin);
+
+    // 0.3<theta_M<0.4: indices 0.4, -1.09, -2.40, breaks at 100 and 600 MeV
+    bin.latitude = 0.35;
+    bin.ang = 1.0;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(10.0, 0.4), -0.4, 0.1));
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(10.0, -1.09), 1.09, 0.6));
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(6.0, -1.09)*pow(1.0/0.6, -2.40), 2.40, highE_reent));
+    model.addBin(bin);
+
+    // 0.4<theta_M<0.5: indices 0.4, -1.19, -2.54, breaks at 100 and 600 MeV
+    bin.latitude = 0.45;
+    bin.ang = 2.0;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(10.0, 0.4), -0.4, 0.1));
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(10.0, -1.19), 1.19, 0.6));
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(6.0, -1.19)*pow(1.0/0.6, -2.54), 2.54, highE_reent));
+    model.addBin(bin);
+
+    // 0.5<theta_M<0.6: indices 0.0, -1.18, -2.31, breaks at 100 and 400 MeV
+    bin.latitude = 0.55;
+    bin.ang = 4.0;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(10.0, 0.0), 0.0, 0.1));
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(10.0, -1.18), 1.18, 0.4));
+    bin.segments.push_back(M::powerLawSegment(0.1*pow(4.0, -1.18)*pow(1.0/0.4, -2.31), 2.31, highE_reent));
+    model.addBin(bin);
+
+    // 0.6<theta_M<0.7: 0.13*(E/100MeV)^0.0, indices -1.1, -2.25, breaks at 100 and 300 MeV
+    bin.latitude = 0.65;
+    bin.ang = 4.0;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.13*pow(10.0, 0.0), 0.0, 0.1));
+    bin.segments.push_back(M::powerLawSegment(0.13*pow(10.0, -1.1), 1.1, 0.3));
+    bin.segments.push_back(M::powerLawSegment(0.13*pow(3.0, -1.1)*pow(1.0/0.3, -2.25), 2.25, highE_reent));
+    model.addBin(bin);
+
+    // 0.7<theta_M<0.8: 0.2*(E/100MeV)^0.0, indices -1.5, -1.85, breaks at 100 and 400 MeV
+    bin.latitude = 0.75;
+    bin.ang = 4.0;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.2*pow(10.0, 0.0), 0.0, 0.1));
+    bin.segments.push_back(M::powerLawSegment(0.2*pow(10.0, -1.5), 1.5, 0.4));
+    bin.segments.push_back(M::powerLawSegment(0.2*pow(4.0, -1.5)*pow(1.0/0.4, -1.85), 1.85, highE_reent));
+    model.addBin(bin);
+
+    // 0.8<theta_M<0.9: 0.23*(E/100MeV)^0.0 below 100 MeV,
+    // 0.017*(E/GeV)^-1.83*exp(-(E/0.177GeV)^-0.83) above
+    bin.latitude = 0.85;
+    bin.ang = 4.0;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.23*pow(10.0, 0.0), 0.0, 0.1));
+    bin.segments.push_back(M::cutOffSegment(0.017, 1.83, 0.177, highE_reent));
+    model.addBin(bin);
+
+    // 0.9<theta_M<1.0: 0.44*(E/100MeV)^0.0 below 100 MeV,
+    // 0.037*(E/GeV)^-1.98*exp(-(E/0.21GeV)^-0.98) above
+    bin.latitude = 0.95;
+    bin.ang = 4.0;
+    bin.segments.clear();
+    bin.segments.push_back(M::powerLawSegment(0.44*pow(10.0, 0.0), 0.0, 0.1));
+    bin.segments.push_back(M::cutOffSegment(0.037, 1.98, 0.21, highE_reent));
+    model.addBin(bin);
+  }
+
 } // End of noname-namespace: private function definitions.
 
 
+std::string CrProtonReentrant::s_tableFile = "";
+
 //
 //
 //
 
 CrProtonReentrant::CrProtonReentrant():CrSpectrum()
 {
-  crProtonReentrant_0002 = new CrProtonReentrant_0002();
-  crProtonReentrant_0203 = new CrProtonReentrant_0203();
-  crProtonReentrant_0304 = new CrProtonReentrant_0304();
-  crProtonReentrant_0405 = new CrProtonReentrant_0405();
-  crProtonReentrant_0506 = new CrProtonReentrant_0506();
-  crProtonReentrant_0607 = new CrProtonReentrant_0607();
-  crProtonReentrant_0708 = new CrProtonReentrant_0708();
-  crProtonReentrant_0809 = new CrProtonReentrant_0809();
-  crProtonReentrant_0910 = new CrProtonReentrant_0910();
+  if (s_tableFile.empty() || !m_model.read(s_tableFile)){
+    builtinModel(m_model);
+  }
 }
 
 
 CrProtonReentrant::~CrProtonReentrant()
 {
-  delete crProtonReentrant_0002;
-  delete crProtonReentrant_0203;
-  delete crProtonReentrant_0304;
-  delete crProtonReentrant_0405;
-  delete crProtonReentrant_0506;
-  delete crProtonReentrant_0607;
-  delete crProtonReentrant_0708;
-  delete crProtonReentrant_0809;
-  delete crProtonReentrant_0910;
+  ;
 }
 
 
@@ -135,78 +220,11 @@ std::pair<G4double,G4double> CrProtonReentrant::dir(G4double /* energy */,
   // and phi=pi/2 for that comming along y-axis (from y>0 to y=0)
 {
   G4double phi = engine->flat() * 2 * M_PI;
-  G4double theta = acos(engine->flat());
-
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-      theta = crProtonReentrant_0002->theta(engine);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      theta = crProtonReentrant_0002->theta(engine);
-    } else {
-      theta = crProtonReentrant_0203->theta(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      theta = crProtonReentrant_0203->theta(engine);
-    } else {
-      theta = crProtonReentrant_0304->theta(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      theta = crProtonReentrant_0304->theta(engine);
-    } else {
-      theta = crProtonReentrant_0405->theta(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      theta = crProtonReentrant_0405->theta(engine);
-    } else {
-      theta = crProtonReentrant_0506->theta(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      theta = crProtonReentrant_0506->theta(engine);
-    } else {
-      theta = crProtonReentrant_0607->theta(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.65 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.75){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.65;
-    r2 = 0.75-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      theta = crProtonReentrant_0607->theta(engine);
-    } else {
-      theta = crProtonReentrant_0708->theta(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.75 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.85){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.75;
-    r2 = 0.85-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      theta = crProtonReentrant_0708->theta(engine);
-    } else {
-      theta = crProtonReentrant_0809->theta(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.85 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.95){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.85;
-    r2 = 0.95-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      theta = crProtonReentrant_0809->theta(engine);
-    } else {
-      theta = crProtonReentrant_0910->theta(engine);
-    }
-  } else {
-    theta = crProtonReentrant_0910->theta(engine);
-  }
+  G4double thetaM = fabs(m_geomagneticLatitude)*M_PI/180.0;
+  // the former code drew a theta here which was not used
+  if (m_model.compatible() && !m_model.blended()){ engine->flat(); }
+
+  G4double theta = m_model.sampleTheta(thetaM, engine);
 
   return std::pair<G4double,G4double>(cos(theta), phi);
 }
@@ -215,87 +233,8 @@ std::pair<G4double,G4double> CrProtonReentrant::dir(G4double /* energy */,
 // Gives back particle energy
 G4double CrProtonReentrant::energySrc(CLHEP::HepRandomEngine* engine) const
 {
-  //  return crProtonReentrant_0002->energy(engine);
-  //  return crProtonReentrant_0203->energy(engine);
-  //  return crProtonReentrant_0304->energy(engine);
-  //  return crProtonReentrant_0405->energy(engine);
-  //  return crProtonReentrant_0506->energy(engine);
-  //  return crProtonReentrant_0607->energy(engine);
-  //  return crProtonReentrant_0708->energy(engine);
-  //  return crProtonReentrant_0809->energy(engine);
-  //  return crProtonReentrant_0910->energy(engine);
-
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-    return crProtonReentrant_0002->energy(engine);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crProtonReentrant_0002->energy(engine);
-    } else {
-      return crProtonReentrant_0203->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crProtonReentrant_0203->energy(engine);
-    } else {
-      return crProtonReentrant_0304->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crProtonReentrant_0304->energy(engine);
-    } else {
-      return crProtonReentrant_0405->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crProtonReentrant_0405->energy(engine);
-    } else {
-      return crProtonReentrant_0506->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crProtonReentrant_0506->energy(engine);
-    } else {
-      return crProtonReentrant_0607->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.65 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.75){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.65;
-    r2 = 0.75-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crProtonReentrant_0607->energy(engine);
-    } else {
-      return crProtonReentrant_0708->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.75 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.85){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.75;
-    r2 = 0.85-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crProtonReentrant_0708->energy(engine);
-    } else {
-      return crProtonReentrant_0809->energy(engine);
-    }
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.85 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.95){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.85;
-    r2 = 0.95-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    if (engine->flat()*(r1+r2)<r2){
-      return crProtonReentrant_0809->energy(engine);
-    } else {
-      return crProtonReentrant_0910->energy(engine);
-    }
-  } else {
-    return crProtonReentrant_0910->energy(engine);
-  }
-
+  G4double thetaM = fabs(m_geomagneticLatitude)*M_PI/180.0;
+  return m_model.sampleEnergy(thetaM, engine);
 }
 
 
@@ -307,59 +246,20 @@ G4double CrProtonReentrant::energySrc(CLHEP::HepRandomEngine* engine) const
 G4double CrProtonReentrant::flux() const
 {
   // energy integrated vertically downward flux, [c/s/m^2/sr]
-  G4double downwardFlux; 
-  G4double r1, r2;
-  if (fabs(m_geomagneticLatitude)*M_PI/180.0<0.15){
-    downwardFlux = crProtonReentrant_0002->downwardFlux();
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.15 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.25){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.15;
-    r2 = 0.25-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crProtonReentrant_0002->downwardFlux()
-	     +r1*crProtonReentrant_0203->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.25 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.35){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.25;
-    r2 = 0.35-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crProtonReentrant_0203->downwardFlux()
-	     +r1*crProtonReentrant_0304->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.35 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.45){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.35;
-    r2 = 0.45-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crProtonReentrant_0304->downwardFlux()
-	     +r1*crProtonReentrant_0405->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.45 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.55){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.45;
-    r2 = 0.55-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crProtonReentrant_0405->downwardFlux()
-	     +r1*crProtonReentrant_0506->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.55 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.65){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.55;
-    r2 = 0.65-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crProtonReentrant_0506->downwardFlux()
-	     +r1*crProtonReentrant_0607->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.65 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.75){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.65;
-    r2 = 0.75-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crProtonReentrant_0607->downwardFlux()
-	     +r1*crProtonReentrant_0708->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.75 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.85){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.75;
-    r2 = 0.85-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crProtonReentrant_0708->downwardFlux()
-	     +r1*crProtonReentrant_0809->downwardFlux() )/(r1+r2);
-  } else if (fabs(m_geomagneticLatitude)*M_PI/180.0>=0.85 && fabs(m_geomagneticLatitude)*M_PI/180.0<0.95){
-    r1 = fabs(m_geomagneticLatitude)*M_PI/180.0-0.85;
-    r2 = 0.95-fabs(m_geomagneticLatitude)*M_PI/180.0;
-    downwardFlux = ( r2*crProtonReentrant_0809->downwardFlux()
-	     +r1*crProtonReentrant_0910->downwardFlux() )/(r1+r2);
-  } else {
-    downwardFlux = crProtonReentrant_0910->downwardFlux();
-  }
+  G4double downwardFlux = m_model.flux(fabs(m_geomagneticLatitude)*M_PI/180.0);
 
   return m_normalization*downwardFlux; // [c/s/m^2/sr]
 
 }
 
 
+// Gives back the table of the model
+const CrLatitudeBinnedModel& CrProtonReentrant::model() const
+{
+  return m_model;
+}
+
+
 // Gives back solid angle from which particle comes
 G4double CrProtonReentrant::solidAngle() const
 {
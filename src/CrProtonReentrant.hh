@@ -12,18 +12,10 @@
 #include <string>
 
 #include "CrSpectrum.hh"
+#include "CrLatitudeBinnedModel.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
-class CrProtonReentrant_0002;
-class CrProtonReentrant_0203;
-class CrProtonReentrant_0304;
-class CrProtonReentrant_0405;
-class CrProtonReentrant_0506;
-class CrProtonReentrant_0607;
-class CrProtonReentrant_0708;
-class CrProtonReentrant_0809;
-class CrProtonReentrant_0910;
 
 class CrProtonReentrant : public CrSpectrum
 {
@@ -50,17 +42,15 @@ public:
   // Gives back the name of the component
   std::string title() const;
 
-  // cr particle generator sorted in theta_M
+  // Gives back the table of the model
+  const CrLatitudeBinnedModel& model() const;
+
+  /// Table file read instead of the built-in model, if not empty
+  static std::string s_tableFile;
+
+  // downward proton spectra sorted in theta_M
 private:
-  CrProtonReentrant_0002* crProtonReentrant_0002;
-  CrProtonReentrant_0203* crProtonReentrant_0203;
-  CrProtonReentrant_0304* crProtonReentrant_0304;
-  CrProtonReentrant_0405* crProtonReentrant_0405;
-  CrProtonReentrant_0506* crProtonReentrant_0506;
-  CrProtonReentrant_0607* crProtonReentrant_0607;
-  CrProtonReentrant_0708* crProtonReentrant_0708;
-  CrProtonReentrant_0809* crProtonReentrant_0809;
-  CrProtonReentrant_0910* crProtonReentrant_0910;
+  CrLatitudeBinnedModel m_model;
 
 };
 #endif // CrProtonReentrant_H
@@ -12,18 +12,10 @@
 #include <string>
 
 #include "CrSpectrum.hh"
+#include "CrLatitudeBinnedModel.hh"
 
 // Forward declaration:
 class CLHEP::HepRandomEngine;
-class CrProtonSplash_0002;
-class CrProtonSplash_0203;
-class CrProtonSplash_0304;
-class CrProtonSplash_0405;
-class CrProtonSplash_0506;
-class CrProtonSplash_0607;
-class CrProtonSplash_0708;
-class CrProtonSplash_0809;
-class CrProtonSplash_0910;
 
 class CrProtonSplash : public CrSpectrum
 {
@@ -50,17 +42,15 @@ public:
   // Gives back the name of the component
   std::string title() const;
 
-  // cr particle generator sorted in theta_M
+  // Gives back the table of the model
+  const CrLatitudeBinnedModel& model() const;
+
+  /// Table file read instead of the built-in model, if not empty
+  static std::string s_tableFile;
+
+  // upward proton spectra sorted in theta_M
 private:
-  CrProtonSplash_0002* crProtonSplash_0002;
-  CrProtonSplash_0203* crProtonSplash_0203;
-  CrProtonSplash_0304* crProtonSplash_0304;
-  CrProtonSplash_0405* crProtonSplash_0405;
-  CrProtonSplash_0506* crProtonSplash_0506;
-  CrProtonSplash_0607* crProtonSplash_0607;
-  CrProtonSplash_0708* crProtonSplash_0708;
-  CrProtonSplash_0809* crProtonSplash_0809;
-  CrProtonSplash_0910* crProtonSplash_0910;
+  CrLatitudeBinnedModel m_model;
 
 };
 #endif // CrProtonSplash_H
@@ -0,0 +1,84 @@
+/****************************************************************************
+ * CrSamplingCounters.cxx:
+ ****************************************************************************
+ * The counters live in a map which is never shrunk, so the references
+ * kept by the loops (in static variables) stay valid.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <map>
+#include <mutex>
+#include <iomanip>
+
+#include "CrSamplingCounters.hh"
+
+namespace {
+  std::mutex& registryMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  std::map<std::string, CrSamplingCounters::Counter>& registry()
+  {
+    static std::map<std::string, CrSamplingCounters::Counter> counters;
+    return counters;
+  }
+}
+
+CrSamplingCounters::Counter& CrSamplingCounters::counter(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  Counter& c = registry()[name];
+  c.name = name;
+  return c;
+}
+
+std::vector<const CrSamplingCounters::Counter*> CrSamplingCounters::counters()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  std::vector<const Counter*> list;
+  std::map<std::string, Counter>::const_iterator it;
+  for (it = registry().begin(); it != registry().end(); ++it){
+    list.push_back(&it->second);
+  }
+  return list;
+}
+
+void CrSamplingCounters::reset()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  std::map<std::string, Counter>::iterator it;
+  for (it = registry().begin(); it != registry().end(); ++it){
+    it->second.attempts = 0;
+    it->second.accepts = 0;
+    it->second.draws = 0;
+  }
+}
+
+void CrSamplingCounters::print(std::ostream& out)
+{
+  std::vector<const Counter*> list = counters();
+  for (unsigned int i = 0; i < list.size(); i++){
+    unsigned long attempts = list[i]->attempts;
+    unsigned long accepts = list[i]->accepts;
+    unsigned long draws = list[i]->draws;
+    out << std::left << std::setw(48) << list[i]->name << std::right
+        << " attempts " << std::setw(12) << attempts
+        << " accepts " << std::setw(12) << accepts
+        << " efficiency " << std::setw(8) << (attempts ? double(accepts)/attempts : 0.)
+        << " draws/accept " << std::setw(8) << (accepts ? double(draws)/accepts : 0.)
+        << std::endl;
+  }
+}
+
+bool CrSamplingCounters::enabled()
+{
+#ifdef CRFLUX_SAMPLING_COUNTERS
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,76 @@
+/**
+ * CrSamplingCounters:
+ *  Counters of the accept/reject loops of the components, compiled in
+ *  only with CRFLUX_SAMPLING_COUNTERS defined.
+ */
+
+//$Header$
+
+#ifndef CrSamplingCounters_H
+#define CrSamplingCounters_H
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** @class CrSamplingCounters
+ *  @brief attempts, accepts and random numbers of the rejection loops
+ *
+ * Each loop (or each envelope of a loop) has a counter, named after
+ * the component and the envelope, made on its first use.  An attempt
+ * counts the random numbers it draws; attempts/accepts is the mean
+ * number of trials, so a loose envelope or a parameter that makes a
+ * loop spin shows up directly.
+ *
+ * The loops use the macros below, which are empty unless the library
+ * is compiled with -DCRFLUX_SAMPLING_COUNTERS, so the counters cost
+ * nothing in a normal build.  The counters are atomic and may be
+ * updated from several threads.
+ */
+class CrSamplingCounters
+{
+public:
+  struct Counter {
+    Counter() : attempts(0), accepts(0), draws(0) {}
+    std::string name;
+    std::atomic<unsigned long> attempts;
+    std::atomic<unsigned long> accepts;
+    std::atomic<unsigned long> draws; ///< random numbers of the attempts
+  };
+
+  /// Gives back the counter of that name, made at the first call
+  static Counter& counter(const std::string& name);
+
+  /// Gives back all the counters, sorted by name
+  static std::vector<const Counter*> counters();
+
+  /// Set all the counters to 0
+  static void reset();
+
+  /// Print one line per counter with attempts, accepts, the
+  /// efficiency and the random numbers per accepted particle
+  static void print(std::ostream& out);
+
+  /// true if the loops were compiled with the counters
+  static bool enabled();
+};
+
+#ifdef CRFLUX_SAMPLING_COUNTERS
+/// Declare the counter var of a loop
+#define CRFLUX_COUNTER(var, name) \
+  static CrSamplingCounters::Counter& var = CrSamplingCounters::counter(name)
+/// Count an attempt which draws n random numbers
+#define CRFLUX_COUNT_ATTEMPT(var, n) \
+  ((var).attempts.fetch_add(1, std::memory_order_relaxed), \
+   (var).draws.fetch_add(n, std::memory_order_relaxed))
+/// Count an accepted attempt
+#define CRFLUX_COUNT_ACCEPT(var) \
+  ((var).accepts.fetch_add(1, std::memory_order_relaxed))
+#else
+#define CRFLUX_COUNTER(var, name)
+#define CRFLUX_COUNT_ATTEMPT(var, n) ((void)0)
+#define CRFLUX_COUNT_ACCEPT(var) ((void)0)
+#endif
+
+#endif // CrSamplingCounters_H
@@ -0,0 +1,118 @@
+/****************************************************************************
+ * CrSourceFactory.cxx:
+ ****************************************************************************
+ * The entry-point classes make their components in their constructor
+ * and draw from the global engine.  Programs without Gaudi, and
+ * CrParallelGenerator which needs one set of components per thread,
+ * make the same components here.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <cstdlib>
+
+#include "CrSourceFactory.hh"
+#include "CrSpectrum.hh"
+#include "CrProtonPrimary.hh"
+#include "CrProtonReentrant.hh"
+#include "CrProtonSplash.hh"
+#include "CrAlphaPrimary.hh"
+#include "CrElectronPrimary.hh"
+#include "CrElectronReentrant.hh"
+#include "CrElectronSplash.hh"
+#include "CrPositronPrimary.hh"
+#include "CrPositronReentrant.hh"
+#include "CrPositronSplash.hh"
+#include "CrGammaPrimary.hh"
+#include "CrGammaSecondaryUpward.hh"
+#include "CrNeutronSplash.hh"
+#include "CrHeavyIonPrimary.hh"
+#include "CrHeavyIonPrimaryZ.hh"
+
+namespace {
+  // the parameters after the source name, as parseParamList of the sources
+  std::vector<float> parameters(const std::string& source)
+  {
+    std::vector<float> params;
+    std::string::size_type comma = source.find(',');
+    std::string input = comma==std::string::npos ? "" : source.substr(comma+1);
+    while (!input.empty()){
+      params.push_back(std::atof(input.c_str()));
+      comma = input.find(',');
+      input = comma==std::string::npos ? "" : input.substr(comma+1);
+    }
+    return params;
+  }
+}
+
+CrSourceFactory::CrSourceFactory(const std::string& source,
+                                 double gammaLowEnergy, double gammaHighEnergy)
+  : m_name(source.substr(0, source.find(','))), m_source(source),
+    m_params(parameters(source)),
+    m_gammaLowEnergy(gammaLowEnergy), m_gammaHighEnergy(gammaHighEnergy),
+    m_useSolidAngle(false)
+{
+  m_flag = m_params.empty() || m_params[0]==0 ? 7 : int(m_params[0]);
+  // as the entry-point classes: CrHeavyIon weights by flux(), the
+  // others by flux()*solidAngle() if they have several components
+  if (m_name == "CrProton" || m_name == "CrElectron" || m_name == "CrPositron"){
+    int n = (m_flag&1 ? 1 : 0) + (m_flag&2 ? 1 : 0) + (m_flag&4 ? 1 : 0);
+    m_useSolidAngle = n > 1;
+  } else if (m_name == "CrGamma"){
+    m_useSolidAngle = (m_flag&1) && (m_flag&4);
+  }
+}
+
+bool CrSourceFactory::valid() const
+{
+  return m_name == "CrProton" || m_name == "CrAlpha" || m_name == "CrElectron"
+    || m_name == "CrPositron" || m_name == "CrGamma" || m_name == "CrNeutron"
+    || m_name == "CrHeavyIon";
+}
+
+// Make the components
+bool CrSourceFactory::make(std::vector<CrSpectrum*>& components) const
+{
+  std::vector<CrSpectrum*> made;
+  if (m_name == "CrProton"){
+    if (m_flag & 1) made.push_back(new CrProtonPrimary);
+    if (m_flag & 2) made.push_back(new CrProtonReentrant);
+    if (m_flag & 4) made.push_back(new CrProtonSplash);
+  } else if (m_name == "CrAlpha"){
+    made.push_back(new CrAlphaPrimary);
+  } else if (m_name == "CrElectron"){
+    if (m_flag & 1) made.push_back(new CrElectronPrimary);
+    if (m_flag & 2) made.push_back(new CrElectronReentrant);
+    if (m_flag & 4) made.push_back(new CrElectronSplash);
+  } else if (m_name == "CrPositron"){
+    if (m_flag & 1) made.push_back(new CrPositronPrimary);
+    if (m_flag & 2) made.push_back(new CrPositronReentrant);
+    if (m_flag & 4) made.push_back(new CrPositronSplash);
+  } else if (m_name == "CrGamma"){
+    if (m_flag & 1) made.push_back(new CrGammaPrimary);
+    if (m_flag & 4) made.push_back(new CrGammaSecondaryUpward);
+  } else if (m_name == "CrNeutron"){
+    made.push_back(new CrNeutronSplash);
+  } else if (m_name == "CrHeavyIon"){
+    if (m_params.empty() || m_params[0]==0){
+      made.push_back(new CrHeavyIonPrimary());
+    } else {
+      made.push_back(new CrHeavyIonPrimaryZ(int(m_params[0])));
+    }
+  } else {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < made.size(); i++){
+    if (m_name != "CrHeavyIon" && m_params.size()>1 && m_params[1]>0){
+      made[i]->setNormalization(m_params[1]);
+    }
+    // the upper limit twice, in case the range is below the default one
+    made[i]->setGammaHighEnergy(m_gammaHighEnergy);
+    made[i]->setGammaLowEnergy(m_gammaLowEnergy);
+    made[i]->setGammaHighEnergy(m_gammaHighEnergy);
+    components.push_back(made[i]);
+  }
+  return true;
+}
@@ -0,0 +1,56 @@
+/**
+ * CrSourceFactory:
+ *  Makes the components of a CRflux source from its name and
+ *  parameters, as the entry-point classes (CrProton, ...) do.
+ */
+
+//$Header$
+
+#ifndef CrSourceFactory_H
+#define CrSourceFactory_H
+
+#include <string>
+#include <vector>
+
+class CrSpectrum;
+
+/** @class CrSourceFactory
+ *  @brief components of a source given as "CrProton,3" etc.
+ *
+ * The source is CrProton, CrAlpha, CrElectron, CrPositron, CrGamma,
+ * CrNeutron or CrHeavyIon, optionally followed by the parameters of
+ * the source library: the bit field of the components and the
+ * normalisation, or the Z of CrHeavyIon.  make() can be called any
+ * number of times, e.g. once per thread; the components follow the
+ * CrPositionProvider::current() at that time.
+ */
+class CrSourceFactory
+{
+public:
+  /// source and energy range of the gammas [GeV]
+  explicit CrSourceFactory(const std::string& source,
+                           double gammaLowEnergy=1.0e-3, double gammaHighEnergy=100.);
+
+  /// true if the source is known
+  bool valid() const;
+
+  const std::string& source() const { return m_source; }
+
+  /// true if the components are weighted by flux()*solidAngle(), as
+  /// the entry-point classes weight them; by flux() otherwise
+  bool useSolidAngle() const { return m_useSolidAngle; }
+
+  /// Make the components, owned by the caller; gives back false
+  /// for an unknown source
+  bool make(std::vector<CrSpectrum*>& components) const;
+
+private:
+  std::string m_name;
+  std::string m_source;
+  std::vector<float> m_params;
+  int m_flag;
+  double m_gammaLowEnergy, m_gammaHighEnergy;
+  bool m_useSolidAngle;
+};
+
+#endif // CrSourceFactory_H
@@ -32,6 +32,7 @@
 
 #include "CrSpectrum.hh"
 #include <iostream>
+#include <sstream>
 
 // CLHEP
 //#include <CLHEP/config/CLHEP.h>
@@ -39,14 +40,63 @@
 #include <CLHEP/Random/RandGeneral.h>
 #include <CLHEP/Random/JamesRandom.h>
 
-#include "astro/IGRField.h"
 
-#include "CrLocation.h"
-#include "CrCoordinateTransfer.hh"
+#include "CrPositionProvider.hh"
+#include "CrGeomagneticState.hh"
+#include "CrSamplingCounters.hh"
+#include "CrEastWestTable.hh"
+#include "CrDiagnostics.hh"
 
 typedef double G4double;
 
+namespace {
+  // Restrict the cutoff rigidity to 0.5 < cor < 14.9 [GV]; over the
+  // poles and the SAA this happens at almost every position update,
+  // so it is reported through CrDiagnostics
+  void restrictCutOffRigidity(double& cor)
+  {
+    static CrDiagnostics::Message& low =
+      CrDiagnostics::message("CrSpectrum: cutoff rigidity set to 0.5 GV");
+    static CrDiagnostics::Message& high =
+      CrDiagnostics::message("CrSpectrum: cutoff rigidity set to 14.9 GV");
+    if (!CrSpectrum::s_restrictRange || (cor >= 0.5 && cor <= 14.9)){ return; }
+    CrDiagnostics::Message& message = cor < 0.5 ? low : high;
+    double value = cor;
+    cor = cor < 0.5 ? 0.5 : 14.9;
+    if (CrDiagnostics::report(message)){
+      std::ostringstream text;
+      text << "CrSpectrum: geomagnetic cutoff rigidity of " << value
+           << " [GV] is restricted in 0.5 < cor < 14.9 [GV]; set at " << cor;
+      CrDiagnostics::print(message, text.str());
+    }
+  }
+
+  // Restrict the solar potential to 500 < phi < 1100 [MV]
+  void restrictSolarWindPotential(double& phi)
+  {
+    static CrDiagnostics::Message& low =
+      CrDiagnostics::message("CrSpectrum: solar potential set to 500 MV");
+    static CrDiagnostics::Message& high =
+      CrDiagnostics::message("CrSpectrum: solar potential set to 1100 MV");
+    if (!CrSpectrum::s_restrictRange || (phi >= 500.0 && phi <= 1100.0)){ return; }
+    CrDiagnostics::Message& message = phi < 500.0 ? low : high;
+    double value = phi;
+    phi = phi < 500.0 ? 500.0 : 1100.0;
+    if (CrDiagnostics::report(message)){
+      std::ostringstream text;
+      text << "CrSpectrum: solar potential of " << value
+           << " [MV] is restricted in 500 < phi < 1100 [MV]; set at " << phi;
+      CrDiagnostics::print(message, text.str());
+    }
+  }
+}
+
+bool CrSpectrum::s_eastWestTable = true;
+bool CrSpectrum::s_restrictRange = true;
+const unsigned int CrSpectrum::noIon = ~0u;
+
 CrSpectrum::CrSpectrum()
+  : m_eastWest(0), m_epoch(1), m_fluxEpoch(0), m_flux(0), m_fluxEvaluations(0)
 {
   // earth radius in km
   m_earthRadius = 6380;
@@ -71,8 +121,9 @@ CrSpectrum::CrSpectrum()
   // m_longitude = -95.73;
 
   // set callback to be notified when the position changes
+  m_provider = CrPositionProvider::current();
   m_observer.setAdapter( new ActionAdapter<CrSpectrum>(this,&CrSpectrum::askGPS) );
-  CrLocation::instance()->getFluxSvc()->GPSinstance()->notification().attach( &m_observer);
+  m_provider->notification().attach( &m_observer);
   askGPS(); //initial setup
 
   // set lower and upper energy to generate gammas
@@ -86,31 +137,40 @@ CrSpectrum::CrSpectrum()
 
 CrSpectrum::~CrSpectrum()
 {
-  ;
+  // stop the call backs to a component which no longer exists
+  m_provider->notification().detach( &m_observer);
 }
 
 void CrSpectrum::setGammaLowEnergy(double ene){ 
-  using std::cout;
-  using std::endl;
-
   if (ene>m_gammaHighEnergy){
-    cout << "low energy limit to generate gamma should be less than high energy limit of " 
-         << m_gammaHighEnergy << " GeV" << endl;
+    static CrDiagnostics::Message& message =
+      CrDiagnostics::message("CrSpectrum: gamma low energy limit above the high one");
+    if (CrDiagnostics::report(message)){
+      std::ostringstream text;
+      text << "low energy limit to generate gamma should be less than high energy limit of " 
+           << m_gammaHighEnergy << " GeV";
+      CrDiagnostics::print(message, text.str());
+    }
     ene = m_gammaHighEnergy;
   }
   m_gammaLowEnergy = ene;
+  newEpoch();
 }
 
 void CrSpectrum::setGammaHighEnergy(double ene){ 
-  using std::cout;
-  using std::endl;
-
   if (ene<m_gammaLowEnergy){
-    cout << "high energy limit to generate gamma should be more than low energy limit of " 
-         << m_gammaLowEnergy << " GeV" << endl;
+    static CrDiagnostics::Message& message =
+      CrDiagnostics::message("CrSpectrum: gamma high energy limit below the low one");
+    if (CrDiagnostics::report(message)){
+      std::ostringstream text;
+      text << "high energy limit to generate gamma should be more than low energy limit of " 
+           << m_gammaLowEnergy << " GeV";
+      CrDiagnostics::print(message, text.str());
+    }
     ene = m_gammaLowEnergy;
   }
   m_gammaHighEnergy = ene;
+  newEpoch();
 }
 
 // set observation time, which is the elapsed seconds from 
@@ -138,30 +198,24 @@ void CrSpectrum::setPosition(double latitude, double longitude, double time)
 void CrSpectrum::setPosition
 (double latitude, double longitude, double time, double altitude)
 {
-  using std::cout;
-  using std::endl;
-
   m_latitude  = latitude;
   m_longitude  = longitude;
   m_time = time;
   m_altitude = altitude;
-  // compute the geomagnetic coordinates
-
-  CrCoordinateTransfer transfer;
-  m_geomagneticLatitude = 
-    transfer.geomagneticLatitude(m_latitude, m_longitude);
-  m_geomagneticLongitude = 
-    transfer.geomagneticLongitude(m_latitude, m_longitude);
-
- // year based on time in s after 11-01-2001
-  float year = (time+304.*86400.)/(365.*86400.)+2001. ;
-  astro::IGRField::Model().compute(m_latitude,m_longitude,m_altitude,year);
-  
- // the relation between r and lambda and the McIlwain L is 
- // cos(lambda)^2 = R/L  
-  m_geomagneticLambda = astro::IGRField::Model().lambda();
-  m_geomagneticR = astro::IGRField::Model().R();
-  m_cutOffRigidity = astro::IGRField::Model().verticalRigidityCutoff();
+  // compute the geomagnetic coordinates; the field model is evaluated
+  // once per position for all the components
+  CrGeomagneticState::Field field = 
+    CrGeomagneticState::instance()->field(m_latitude, m_longitude, m_time, m_altitude);
+  m_geomagneticLatitude = field.geomagneticLatitude;
+  m_geomagneticLongitude = field.geomagneticLongitude;
+
+  // the relation between r and lambda and the McIlwain L is 
+  // cos(lambda)^2 = R/L  
+  m_geomagneticLambda = field.lambda;
+  m_geomagneticR = field.R;
+  m_cutOffRigidity = field.cutOffRigidity;
+  m_geomagneticL = field.L;
+  m_geomagneticB = field.B;
 
 // set effective geomagnetic latitude to the lambda value  
   m_geomagneticLatitude = m_geomagneticLambda*180./M_PI;
@@ -194,18 +248,7 @@ void CrSpectrum::setPosition
 */
 
   // magnetic cutoff rigidity is restricted in 0.5 < cor < 14.9[GV]
-  if (m_cutOffRigidity < 0.5){
-    cout << "In this program, geomagnetic cutoff rigidity is" << endl;
-    cout << " restricted in 0.5 < cor < 14.9[GV]" << endl;
-    m_cutOffRigidity = 0.5; 
-    cout << "COR is set at " << m_cutOffRigidity << " [GV]" << endl;
-  }
-  if (m_cutOffRigidity > 14.9){ 
-    cout << "In this program, geomagnetic cutoff rigidity is" << endl;
-    cout << " restricted in 0.5 < cor < 14.9[GV]" << endl;
-    m_cutOffRigidity = 14.9; 
-    cout << "COR is set at " << m_cutOffRigidity << " [GV]"<< endl;
-  }
+  restrictCutOffRigidity(m_cutOffRigidity);
 
   // compute the force-field approximation potential (MV)
   // solar activity is assumed to be minimum in 1996-05-01,
@@ -225,43 +268,20 @@ void CrSpectrum::setPosition
   m_solarWindPotential = 820+280*cos(2*M_PI*(m_time-time_0)/(11*365*86400));
 
   // Solar potential is restricted in 500 < phi < 1100[MV]
-  if (m_solarWindPotential < 500.0){ 
-    cout << "In this program, solar potential is" << endl;
-    cout << " restricted in 500 < phi < 1100[MV]" << endl;
-    m_solarWindPotential = 500.0; 
-    cout << "Phi is set at " << m_solarWindPotential << " [MV]" << endl;
-  }
-  if (m_solarWindPotential > 1100.0){ 
-    cout << "In this program, solar potential is" << endl;
-    cout << " restricted in 500 < phi < 1100[MV]" << endl;
-    m_solarWindPotential = 1100.0; 
-    cout << "Phi is set at " << m_solarWindPotential << " [MV]" << endl;
-  }
+  restrictSolarWindPotential(m_solarWindPotential);
 
+  newEpoch();
 }
 
 
 // set solar modulation potential
 void CrSpectrum::setSolarWindPotential(double phi)
 {
-  using std::cout;
-  using std::endl;
-
   m_solarWindPotential = phi;
 
   // Solar potential is restricted in 500 < phi < 1100[MV]
-  if (m_solarWindPotential < 500.0){ 
-    cout << "In this program, solar potential is" << endl;
-    cout << " restricted in 500 < phi < 1100[MV]" << endl;
-    m_solarWindPotential = 500.0; 
-    cout << "Phi is set at " << m_solarWindPotential << " [MV]" << endl;
-  }
-  if (m_solarWindPotential > 1100.0){ 
-    cout << "In this program, solar potential is" << endl;
-    cout << " restricted in 500 < phi < 1100[MV]" << endl;
-    m_solarWindPotential = 1100.0; 
-    cout << "Phi is set at " << m_solarWindPotential << " [MV]" << endl;
-  }
+  restrictSolarWindPotential(m_solarWindPotential);
+  newEpoch();
 }
 
 // set cutoff rigidity
@@ -271,23 +291,9 @@ void CrSpectrum::setSolarWindPotential(double phi)
 // it is not used anyhow. so remove it ?
 void CrSpectrum::setCutOffRigidity(double cor)
 {
-  using std::cout;
-  using std::endl;
-
   m_cutOffRigidity = cor;
   // magnetic cutoff rigidity is restricted in 0.5 < cor < 14.9[GV]
-  if (m_cutOffRigidity < 0.5){
-    cout << "In this program, geomagnetic cutoff rigidity is" << endl;
-    cout << " restricted in 0.5 < cor < 14.9[GV]" << endl;
-    m_cutOffRigidity = 0.5; 
-    cout << "COR is set at " << m_cutOffRigidity << " [GV]" << endl;
-  }
-  if (m_cutOffRigidity > 14.9){ 
-    cout << "In this program, geomagnetic cutoff rigidity is" << endl;
-    cout << " restricted in 0.5 < cor < 14.9[GV]" << endl;
-    m_cutOffRigidity = 14.9; 
-    cout << "COR is set at " << m_cutOffRigidity << " [GV]"<< endl;
-  }
+  restrictCutOffRigidity(m_cutOffRigidity);
 
   // calculate geomagnetic latitude
 
@@ -297,6 +303,7 @@ void CrSpectrum::setCutOffRigidity(double cor)
   m_geomagneticLatitude = acos(tmp);
   // convert from radian to degree
   m_geomagneticLatitude = m_geomagneticLatitude*180.0/M_PI;
+  newEpoch();
 }
 
 
@@ -377,14 +384,41 @@ double CrSpectrum::cutOffRigidityThisDirection(double theta, double phi) const
 }
 
 
-// Gives back particle direction with EW effect 
+// Gives back particle direction with EW effect.
+// theta is drawn as in EW_dirRejection and phi by inversion of the
+// azimuth distribution at q = cos(magLat)^3*sin(theta) and rig/cor
 std::pair<double,double> CrSpectrum::EW_dir(double rig, double coeff, double polarity,
 			  CLHEP::HepRandomEngine* engine)const
 {
+  if (!s_eastWestTable){
+    return EW_dirRejection(rig, coeff, polarity, engine);
+  }
+  if (m_eastWest == 0 || m_eastWest->coeff() != coeff){
+    m_eastWest = &CrEastWestTable::instance(coeff);
+  }
+
+  double cosTheta = 1.4*engine->flat()-0.4;
+  double sinTheta = sqrt(1-cosTheta*cosTheta);
+  double cosMagLat = cos(m_geomagneticLatitude/180.0*M_PI);
+  double q = cosMagLat*cosMagLat*cosMagLat*sinTheta;
+  double x = m_cutOffRigidity>0 ? rig/m_cutOffRigidity : 1e10;
+  double phi = m_eastWest->sample(q, x, engine);
+  if (polarity<0){
+    phi = phi+M_PI;
+  }
+  return std::pair<double,double>(cosTheta, phi);
+}
+
+
+// Gives back particle direction with EW effect, by accept/reject in phi
+std::pair<double,double> CrSpectrum::EW_dirRejection(double rig, double coeff,
+			  double polarity, CLHEP::HepRandomEngine* engine)const
+{
 
   double theta, phi;
   double cor, cor_west;
   double flux, flux_west;
+  CRFLUX_COUNTER(counter, "CrSpectrum EW_dir");
   theta = acos(1.4*engine->flat()-0.4);
   while(1){
     phi   = engine->flat() * 2 * M_PI;
@@ -392,7 +426,9 @@ std::pair<double,double> CrSpectrum::EW_dir(double rig, double coeff, double pol
     cor_west = CrSpectrum::cutOffRigidityThisDirection(M_PI/2., 180.0/180.0*M_PI);
     flux = 1./(1+pow(rig/cor, coeff));
     flux_west = 1./(1+pow(rig/cor_west, coeff));
+    CRFLUX_COUNT_ATTEMPT(counter, 2);
     if (engine->flat()<=flux/flux_west){
+      CRFLUX_COUNT_ACCEPT(counter);
       break;
     }
   }
@@ -404,31 +440,72 @@ std::pair<double,double> CrSpectrum::EW_dir(double rig, double coeff, double pol
 }
 
 
+// Fill n particles, one by one
+void CrSpectrum::sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+			     double* energy, double* cosTheta, double* phi) const
+{
+  for (int i = 0; i < n; i++){
+    energy[i] = energySrc(engine);
+    std::pair<double,double> direction = dir(energy[i], engine);
+    cosTheta[i] = direction.first;
+    phi[i] = direction.second;
+  }
+}
+
+// Fill n particles that are not heavy ions
+void CrSpectrum::sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+			     double* energy, double* cosTheta, double* phi,
+			     unsigned int* ion) const
+{
+  sampleBlock(engine, n, energy, cosTheta, phi);
+  for (int i = 0; i < n && ion; i++){ ion[i] = noIon; }
+}
+
+// Gives back flux(), evaluated once per epoch.  The splash and
+// reentrant components interpolate their latitude tables and the
+// primaries their flux tables in flux(), which is asked for every event.
+double CrSpectrum::cachedFlux() const
+{
+  if (m_fluxEpoch != m_epoch){
+    m_flux = flux();
+    m_fluxEpoch = m_epoch;
+    m_fluxEvaluations++;
+  }
+  return m_flux;
+}
+
 // Gives back solar modulation potential in [MV]
 double CrSpectrum::solarWindPotential() const
 {
   return m_solarWindPotential;
 }
 
-// call back from GPS when position changes
+// call back from the position provider (GPS) when position changes
 int CrSpectrum::askGPS()
 {
-    astro::GPS* gps=CrLocation::instance()->getFluxSvc()->GPSinstance();
-
-    astro::EarthCoordinate pos = gps->earthpos();
-    setPosition(pos.latitude(), pos.longitude(), gps->time(), pos.altitude());
+    double latitude, longitude, altitude, time;
+    m_provider->position(latitude, longitude, altitude, time);
+    setPosition(latitude, longitude, time, altitude);
     
     return 0; // can't be void in observer pattern
 }
 
 
 void CrSpectrum::setNormalization(float norm){
-      using std::cout;
-      using std::endl;
-
-      cout<<"CrSpectrum::setNormalization: "<<norm<<endl;
-      if(norm!=1.0) cout<<"CrSpectrum Warning: Setting normalization of flux to a value different from 1. "
-                        <<"Please check if that is what you intent to do."<<endl; 
+      // the sources call it for each of their components, so the
+      // warning is given once per run rather than once per call
+      if(norm!=1.0){
+        static CrDiagnostics::Message& message =
+          CrDiagnostics::message("CrSpectrum: normalization different from 1");
+        if (CrDiagnostics::report(message)){
+          std::ostringstream text;
+          text<<"CrSpectrum Warning: Setting normalization of flux to "<<norm
+              <<", a value different from 1. "
+              <<"Please check if that is what you intent to do.";
+          CrDiagnostics::print(message, text.str());
+        }
+      }
       
       m_normalization=norm;
+      newEpoch();
    };
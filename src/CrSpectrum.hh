@@ -16,6 +16,8 @@
 #include "astro/EarthCoordinate.h"
 
 namespace CLHEP {class HepRandomEngine;}
+class CrPositionProvider;
+class CrEastWestTable;
 
 /** @class CrSpectrum 
  *  @brief base class
@@ -67,13 +69,51 @@ public:
   virtual double energySrc(CLHEP::HepRandomEngine* engine) const=0;
   virtual std::pair<double,double> 
   dir(double energy, CLHEP::HepRandomEngine* engine) const=0;
+  /// Fill n particles: kinetic energy [GeV], cos(theta) and phi [rad].
+  /// The default calls energySrc() and dir() for each particle; components
+  /// override it to share the setup and draw random numbers in blocks.
+  virtual void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+			   double* energy, double* cosTheta, double* phi) const;
+  /// The same, with ion[i] set to the index in CrIonSpecies of the
+  /// heavy ion of particle i.  The default sets noIon for all the
+  /// particles; the heavy ion components override it.
+  virtual void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+			   double* energy, double* cosTheta, double* phi,
+			   unsigned int* ion) const;
+  /// ion of the particles that are not heavy ions
+  static const unsigned int noIon;
   /// Gives back the direction of the particle with EW effect
   std::pair<double, double> EW_dir(double rigidity, double coeff, double polarity, 
 				   CLHEP::HepRandomEngine* engine)const;
+  /// The same by the accept/reject loop in azimuth, which EW_dir
+  /// uses when s_eastWestTable is false; kept as the reference
+  std::pair<double, double> EW_dirRejection(double rigidity, double coeff,
+					    double polarity,
+					    CLHEP::HepRandomEngine* engine)const;
+  /// EW_dir samples the azimuth from a CrEastWestTable (default true)
+  static bool s_eastWestTable;
+  /// The cutoff rigidity is restricted to 0.5-14.9 GV and the solar
+  /// potential to 500-1100 MV, the range of the models (default true);
+  /// without, the flux tables of the primaries are computed outside
+  /// their grids
+  static bool s_restrictRange;
+  /// Set the engine of the random numbers a component draws outside
+  /// energySrc() and dir() (the ion species of CrHeavyIonPrimary);
+  /// nothing for the others
+  virtual void setEngine(CLHEP::HepRandomEngine* /* engine */) {}
   /// Gives back the flux
   virtual double flux() const=0;
   /// Gives back the solid angle from which particle comes
   virtual double solidAngle() const=0;
+  /// Gives back flux(), evaluated again only in a new epoch; the
+  /// sources and the component mixtures ask it for every event
+  double cachedFlux() const;
+  /// Gives back the epoch, which counts the changes of the quantities
+  /// flux() depends on: position, time, cutoff rigidity, solar
+  /// potential, gamma energy range and normalization
+  unsigned long epoch() const { return m_epoch; }
+  /// Gives back the number of times cachedFlux() has evaluated flux()
+  unsigned long fluxEvaluations() const { return m_fluxEvaluations; }
 
   /// Gives back the particle type and component name
   virtual const char* particleName() const=0;
@@ -86,13 +126,17 @@ public:
   inline virtual double gammaLowEnergy() const { return m_gammaLowEnergy;}
   inline virtual double gammaHighEnergy() const { return m_gammaHighEnergy;}
 
-  /// this one asks the GPS for position
+  /// this one asks the GPS (the position provider) for position
   int askGPS();
 
   /// 
   void setNormalization(float norm);
   
 protected:
+  /// Start a new epoch: the setters call it, and so should a component
+  /// whose flux() follows other state when that state changes
+  void newEpoch() { m_epoch++; }
+
   // Following member variables defines satellite position 
   // in geographic/geomagnetic coordinate, altitude, time of observation, 
   // geomagnetic cutoff rigidity and solar modulation potential.
@@ -104,6 +148,8 @@ protected:
   double m_geomagneticLongitude; ///< [deg]
   double m_geomagneticLambda; ///< [rad]
   double m_geomagneticR; ///< [R_earth]
+  double m_geomagneticL; ///< McIlwain L [R_earth]
+  double m_geomagneticB; ///< field strength as given by astro::IGRField
   double m_cutOffRigidity; ///< [GV]
   double m_solarWindPotential; ///< [MV]
 
@@ -117,6 +163,13 @@ protected:
 
 private:
    ObserverAdapter< CrSpectrum > m_observer; ///< obsever tag
+   CrPositionProvider* m_provider; ///< followed since the construction
+   mutable const CrEastWestTable* m_eastWest; ///< azimuth table of EW_dir
+
+   unsigned long m_epoch; ///< see epoch()
+   mutable unsigned long m_fluxEpoch; ///< epoch of m_flux
+   mutable double m_flux; ///< flux() in m_fluxEpoch
+   mutable unsigned long m_fluxEvaluations;
 
    //! will be set by the call back from GPS.
    astro::EarthCoordinate m_pos;
@@ -0,0 +1,61 @@
+/****************************************************************************
+ * CrTrajectory.cxx:
+ ****************************************************************************
+ * Simple trajectories of the observer.  The circular orbit neglects
+ * the precession of the orbit and the oblateness of the earth; it is
+ * meant for tests and production outside Gaudi, where the GPS of
+ * FluxSvc follows the real orbit.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <cmath>
+
+#include "CrTrajectory.hh"
+
+namespace {
+  const double earthRadius = 6378.14;        // [km]
+  const double earthGM = 398600.4418;        // [km^3/s^2]
+  const double earthRotation = 360./86164.1; // [deg/s]
+}
+
+CrTrajectory::~CrTrajectory()
+{
+  ;
+}
+
+
+CrCircularOrbit::CrCircularOrbit(double inclination, double altitude)
+  : m_inclination(inclination), m_altitude(altitude)
+{
+  ;
+}
+
+void CrCircularOrbit::position(double time, double& latitude, double& longitude,
+                               double& altitude) const
+{
+  double a = earthRadius+m_altitude;
+  double period = 2*M_PI*sqrt(a*a*a/earthGM);
+  double u = 2*M_PI*fmod(time/period, 1.);
+  double incl = m_inclination*M_PI/180.;
+  latitude = asin(sin(incl)*sin(u))*180./M_PI;
+  longitude = atan2(cos(incl)*sin(u), cos(u))*180./M_PI - fmod(time*earthRotation, 360.);
+  longitude = fmod(longitude+540., 360.)-180.;
+  altitude = m_altitude;
+}
+
+
+CrFixedTrajectory::CrFixedTrajectory(double latitude, double longitude, double altitude)
+  : m_latitude(latitude), m_longitude(longitude), m_altitude(altitude)
+{
+  ;
+}
+
+void CrFixedTrajectory::position(double /* time */, double& latitude, double& longitude,
+                                 double& altitude) const
+{
+  latitude = m_latitude;
+  longitude = m_longitude;
+  altitude = m_altitude;
+}
@@ -0,0 +1,63 @@
+/**
+ * CrTrajectory:
+ *  Position of the observer as a function of time, for the programs
+ *  which generate particles without the GPS of FluxSvc.
+ */
+
+//$Header$
+
+#ifndef CrTrajectory_H
+#define CrTrajectory_H
+
+/** @class CrTrajectory
+ *  @brief geographic position of the observer at a given time
+ *
+ * crflux_generate and CrParallelGenerator place their
+ * CrFixedPosition along a trajectory: a circular orbit or a fixed
+ * place.
+ */
+class CrTrajectory
+{
+public:
+  virtual ~CrTrajectory();
+
+  /// Gives back the geographic latitude and longitude [deg] and the
+  /// altitude [km] at time [s]
+  virtual void position(double time, double& latitude, double& longitude,
+                        double& altitude) const=0;
+};
+
+/** @class CrCircularOrbit
+ *  @brief circular orbit whose ascending node is at longitude 0 at time 0
+ */
+class CrCircularOrbit : public CrTrajectory
+{
+public:
+  /// inclination [deg] and altitude [km]
+  CrCircularOrbit(double inclination=25.6, double altitude=565.);
+
+  void position(double time, double& latitude, double& longitude,
+                double& altitude) const;
+
+private:
+  double m_inclination; ///< [deg]
+  double m_altitude;    ///< [km]
+};
+
+/** @class CrFixedTrajectory
+ *  @brief the observer stays at one place
+ */
+class CrFixedTrajectory : public CrTrajectory
+{
+public:
+  CrFixedTrajectory(double latitude, double longitude, double altitude=565.);
+
+  void position(double time, double& latitude, double& longitude,
+                double& altitude) const;
+
+private:
+  double m_latitude, m_longitude; ///< [deg]
+  double m_altitude;              ///< [km]
+};
+
+#endif // CrTrajectory_H
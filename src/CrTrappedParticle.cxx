@@ -14,12 +14,21 @@
 
 #undef ALLOW_SAA_SERVER
 
+// *****************************************************************************
+// if this switch is turned on every energy is also computed from the integral spectrum
+// rebuilt in the std::map m_intSpectrum, the way it was sampled before the flat table with
+// guide index was introduced, and any difference is printed. For debugging only.
+
+#undef CHECK_TRAPPED_SAMPLING
+
 // *****************************************************************************
 
 
 #include <cmath>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <cstdlib>
 
 // CLHEP
 //#include <CLHEP/config/CLHEP.h>
@@ -28,7 +37,7 @@
 #include <CLHEP/Random/JamesRandom.h>
 
 #include "CrTrappedParticle.hh"
-#include "CrLocation.h"
+#include "CrPositionProvider.hh"
 
 #include <facilities/Observer.h>
 
@@ -68,16 +77,34 @@ CrTrappedParticle::CrTrappedParticle(const std::string& paramstring="8,psb97,.",
 
    m_particleType=invalid;
    m_thresholdEnergy=0.;
+   m_cacheReport=0;
   
   
   
    
-   if(tokens.size()!=3 || facilities::Util::stringToInt(tokens[0])!=8){
+   if(tokens.size()<3 || facilities::Util::stringToInt(tokens[0])!=8){
         std::cerr<<"Found illegal parameter string in CrTrappedParticle: "<<paramstring<<std::endl;
         std::cerr<<"param for CrTrappedParticle must be of the form \"8,<model>,<dir/serveraddress>\"."<<std::endl;
         std::cerr<<"NO TRAPPED PARTICLE FLUX IS GENERATED."<<std::endl;
 	return;
    };
+
+// optional settings of the spectrum cache, e.g. "8,psb97,<dir>,dL=0.002,dB=0.005,cacheMB=16,cacheStats=10000":
+// dL, dB: rounding of L and B (0 switches the cache off), cacheMB: memory limit,
+// cacheStats: print the hit rate every so many spectrum updates
+   double lStep=0.001, bStep=0.0025, cacheMB=8.;
+   for(unsigned int i=3;i<tokens.size();i++){
+      std::string::size_type eq=tokens[i].find("=");
+      std::string key=tokens[i].substr(0,eq);
+      double value= eq==std::string::npos ? 0. : atof(tokens[i].substr(eq+1).c_str());
+      if(key=="dL") lStep=value;
+      else if(key=="dB") bStep=value;
+      else if(key=="cacheMB") cacheMB=value;
+      else if(key=="cacheStats") m_cacheReport=(unsigned long)value;
+      else std::cerr<<"CrTrappedParticle: ignoring unknown parameter "<<tokens[i]<<std::endl;
+   };
+   m_spectrumCache.setResolution(lStep,bStep);
+   m_spectrumCache.setMaxMegabytes(cacheMB);
   
    m_model=tokens[1];
 
@@ -126,7 +153,7 @@ CrTrappedParticle::CrTrappedParticle(const std::string& paramstring="8,psb97,.",
 
 /// "overload" the askGPS call-back, so we can also update the spectrum when the coordinates change
    m_updater.setAdapter( new ActionAdapter<CrTrappedParticle>(this,&CrTrappedParticle::update) );
-   CrLocation::instance()->getFluxSvc()->GPSinstance()->notification().attach( &m_updater);
+   CrPositionProvider::current()->notification().attach( &m_updater);
 
 // next line can be used to test the notification adapter with small statistics
 //   CrLocation::instance()->getFluxSvc()->GPSinstance()->sampleintvl(0.002);
@@ -139,7 +166,9 @@ CrTrappedParticle::CrTrappedParticle(const std::string& paramstring="8,psb97,.",
 
 
 CrTrappedParticle::~CrTrappedParticle()
-{}
+{
+  if(m_cacheReport>0) reportCache();
+}
 
 //#######################################################################################
 
@@ -168,21 +197,34 @@ double CrTrappedParticle::energySrc(CLHEP::HepRandomEngine* engine) const
    
   if(m_maxNonzeroFluxEnergy==0) return 0;
 
-  G4double random = engine->flat();
+  return energyFromRandom(engine->flat());
+}
 
-  std::map<G4double,G4double>::const_iterator spec_it = m_intSpectrum.lower_bound(random);
-  if(spec_it == m_intSpectrum.end()) return 0;
+//#######################################################################################
 
-  G4double r2=(*spec_it).first;
-  G4double e2=(*spec_it).second;
-  if(--spec_it == m_intSpectrum.end()) return 0;
-  G4double r1=(*spec_it).first;
-  G4double e1=(*spec_it).second;
-  
-  G4double energy=e1+(random-r1)*(e2-e1)/(r2-r1);
-  
-//  std::cout<<"TrappedParticle "<<particleName()<<" "
-//      <<"rand="<<random<<" r1="<<r1<<" r2="<<r2<<" e1="<<e1<<" e2="<<e2<<" energy="<<energy<<std::endl;
+
+// Inverts the integral spectrum for a flat random number; the energy is in GeV
+double CrTrappedParticle::energyFromRandom(G4double random) const
+{
+  if(!m_spectrum) return 0;
+  G4double energy=m_spectrum->sample(random);
+
+#ifdef CHECK_TRAPPED_SAMPLING
+  G4double mapEnergy=0;
+  std::map<G4double,G4double>::const_iterator spec_it = m_intSpectrum.lower_bound(random);
+  if(spec_it != m_intSpectrum.end() && spec_it != m_intSpectrum.begin()){
+     G4double r2=(*spec_it).first;
+     G4double e2=(*spec_it).second;
+     --spec_it;
+     G4double r1=(*spec_it).first;
+     G4double e1=(*spec_it).second;
+     mapEnergy=e1+(random-r1)*(e2-e1)/(r2-r1);
+  };
+  if(mapEnergy!=energy){
+     std::cout<<"TrappedParticle "<<particleName()<<" "
+	      <<"rand="<<random<<" energy="<<energy<<" from map="<<mapEnergy<<std::endl;
+  };
+#endif
   
   return 1e-3*energy;  // in GeV
 }
@@ -190,6 +232,34 @@ double CrTrappedParticle::energySrc(CLHEP::HepRandomEngine* engine) const
 //#######################################################################################
 
 
+// Fill n particles at once from one array of random numbers
+void CrTrappedParticle::sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                                    double* energy, double* cosTheta,
+                                    double* phi) const
+{
+  if(n<=0) return;
+  if(m_maxNonzeroFluxEnergy==0){
+    // no energy random numbers are drawn, as in energySrc()
+    for(int i=0;i<n;i++){
+      energy[i]=0;
+      std::pair<double,double> d=dir(0, engine);
+      cosTheta[i]=d.first;
+      phi[i]=d.second;
+    }
+    return;
+  }
+  std::vector<double> rnd(3*n);
+  engine->flatArray(3*n, &rnd[0]);
+  for(int i=0;i<n;i++) energy[i]=energyFromRandom(rnd[3*i]);
+  for(int i=0;i<n;i++){
+    cosTheta[i]=2.0*rnd[3*i+1]-1.0;
+    phi[i]=rnd[3*i+2] * 2 * M_PI;
+  }
+}
+
+//#######################################################################################
+
+
 // flux() returns the energy integrated flux averaged over
 // the region from which particle is coming from 
 // and the unit is [c/s/m^2/sr].
@@ -232,6 +302,48 @@ std::string CrTrappedParticle::title() const
   return  "CrTrappedParticle";
 }
 
+//#######################################################################################
+
+
+// Gives back the cache of the PSB97 spectra
+const CrTrappedSpectrumCache& CrTrappedParticle::spectrumCache() const
+{
+  return m_spectrumCache;
+}
+
+//#######################################################################################
+
+
+// give the flux and the guide to a spectrum just filled and use it for
+// sampling; it is owned by m_spectrum
+void CrTrappedParticle::newSpectrum(CrTrappedSpectrumCache::Spectrum* spectrum)
+{
+  spectrum->integralFlux=m_integralFlux;
+  spectrum->maxNonzeroFluxEnergy=m_maxNonzeroFluxEnergy;
+  spectrum->buildGuide();
+  useSpectrum(CrTrappedSpectrumCache::SpectrumPtr(spectrum));
+}
+
+void CrTrappedParticle::useSpectrum(const CrTrappedSpectrumCache::SpectrumPtr& spectrum)
+{
+  m_spectrum=spectrum;
+  m_integralFlux=spectrum->integralFlux;
+  m_maxNonzeroFluxEnergy=spectrum->maxNonzeroFluxEnergy;
+#ifdef CHECK_TRAPPED_SAMPLING
+  m_intSpectrum.clear();
+  for(unsigned int i=0;i<spectrum->random.size();i++) m_intSpectrum[spectrum->random[i]]=spectrum->energy[i];
+#endif
+}
+
+void CrTrappedParticle::reportCache() const
+{
+  unsigned long hits=m_spectrumCache.hits(), misses=m_spectrumCache.misses();
+  if(hits+misses==0) return;
+  std::cout<<title()<<": spectrum cache "<<hits<<" hits, "<<misses<<" misses ("
+           <<100.*hits/(hits+misses)<<"%), "<<m_spectrumCache.size()<<" spectra, "
+           <<m_spectrumCache.bytes()/1024<<" kB"<<std::endl;
+}
+
 
 //#######################################################################################
 
@@ -240,9 +352,10 @@ int CrTrappedParticle::update() {
   //do we need a new spectrum ? if yes, request it from the server....
   //...or get it from the PSB97 tables
 
+  // position first: the PSB97 spectrum needs L and B of this position
+  askGPS();
   if(m_serverAddress!="") requestNewSpectrum(m_thresholdEnergy,m_eMax,m_eStep);  
   else  psb97UpdateSpectrum(m_thresholdEnergy,m_eMax,m_eStep);
-  askGPS();
   return 0;
 };
 
@@ -251,9 +364,10 @@ int CrTrappedParticle::update() {
 bool CrTrappedParticle::psb97UpdateSpectrum(const G4double minE,const G4double maxE,const G4double stepE) {
     static TrappedParticleModels::PSB97Model psb97(m_xmlDirectory);
 
-// values computed by askGPS. We just get them now from the IGRField.
-    double ll = astro::IGRField::Model().L();
-    double bb = astro::IGRField::Model().B();
+// values computed by askGPS for this instance; the shared IGRField
+// may already hold the field of another component's position.
+    double ll = m_geomagneticL;
+    double bb = m_geomagneticB;
 
 // catch rounding/accuracy errors in the field model because
 // tables are not defined at ll,bb<1
@@ -261,25 +375,57 @@ bool CrTrappedParticle::psb97UpdateSpectrum(const G4double minE,const G4double m
     if(ll<1.) ll=1.;
     if(bb<1.) bb=1.;    
 
+// spectra are kept for the (L,B) cells visited before, e.g. on the previous pass
+// through the SAA; they are computed at the rounded (L,B) so that they do not depend
+// on the point of the cell where the orbit came in first
+    CrTrappedSpectrumCache::Key cell;
+    bool cached=m_spectrumCache.enabled();
+    if(cached){
+       cell=m_spectrumCache.cell(ll,bb);
+       CrTrappedSpectrumCache::SpectrumPtr spectrum=m_spectrumCache.find(cell);
+       unsigned long lookups=m_spectrumCache.hits()+m_spectrumCache.misses();
+       if(m_cacheReport>0 && lookups%m_cacheReport==0) reportCache();
+       if(spectrum){
+          useSpectrum(spectrum);
+          return true;
+       };
+    };
+
+// the integral flux above each energy of the spectrum, minE first,
+// evaluated in one call
+    std::vector<G4double> energies(1,minE);
+    for(G4double e=minE+stepE;e<=maxE;e+=stepE) energies.push_back(e);
+    std::vector<float> ee(energies.begin(),energies.end());
+    std::vector<float> integral(ee.size());
+    psb97(ll,bb,&ee[0],&integral[0],ee.size());
+
 //    std::cout<<"CrTrappedParticle: Update spectrum: lat="<<m_latitude<<", lon="<<m_longitude<<", ll="<<ll<<", bb="<<bb;
-    m_integralFlux=psb97(ll,bb,minE);
-    m_intSpectrum[0.]=minE;
+// the fraction of the flux below each energy, filled straight into the
+// table used for sampling
+    CrTrappedSpectrumCache::Spectrum* spectrum=new CrTrappedSpectrumCache::Spectrum;
+    spectrum->random.reserve(energies.size()+1);
+    spectrum->energy.reserve(energies.size()+1);
+    m_integralFlux=integral[0];
+    spectrum->setNode(0.,minE);
 //    std::cout<<" <--> integral flux="<<m_integralFlux<<std::endl;
 
     if(m_integralFlux>0){
-       for(G4double e=minE+stepE;e<=maxE;e+=stepE) {
-	  float fluxval=1. - psb97(ll,bb,e)/m_integralFlux;
+       for(unsigned int i=1;i<energies.size();i++) {
+	  G4double e=energies[i];
+	  float fluxval=1. - integral[i]/m_integralFlux;
 	  if (fluxval<0.999999){ 
 	     m_maxNonzeroFluxEnergy=e;
-             m_intSpectrum[fluxval]=e;
+             spectrum->setNode(fluxval,e);
 	  };
        };        
-       m_intSpectrum[1.]=m_maxNonzeroFluxEnergy+stepE;
+       spectrum->setNode(1.,m_maxNonzeroFluxEnergy+stepE);
     } else {
        m_maxNonzeroFluxEnergy=0;   
        m_integralFlux=0;
     };
 
+    newSpectrum(spectrum);
+    if(cached) m_spectrumCache.insert(cell,m_spectrum);
    return true;
 };
 
@@ -412,13 +558,13 @@ bool CrTrappedParticle::requestNewSpectrum(const G4double minE,
 
 // got the spectrum. now we read the values
 // first value corresponds to total flux.
-// all fluxes are stored normalized to the total flux, in an inverted map 
+// all fluxes are stored normalized to the total flux, in an inverted table 
 // optimal for energySrc to sample the spectrum from flat random numbers.... 
-    m_intSpectrum.clear();
+    CrTrappedSpectrumCache::Spectrum* spectrum=new CrTrappedSpectrumCache::Spectrum;
     
     std::string flux=spectrum_string.substr(0,spectrum_string.find(","));    
     m_integralFlux=atof(flux.c_str());
-    m_intSpectrum[0.]=minE;
+    spectrum->setNode(0.,minE);
     
     if(m_integralFlux>0){
        spectrum_string=spectrum_string.substr(spectrum_string.find(",")+1,spectrum_string.length());
@@ -427,11 +573,11 @@ bool CrTrappedParticle::requestNewSpectrum(const G4double minE,
 	  float fluxval=1. - atof(flux.c_str())/m_integralFlux;
 	  if (fluxval<1.){ 
 	     m_maxNonzeroFluxEnergy=e;
-             m_intSpectrum[fluxval]=e;
+             spectrum->setNode(fluxval,e);
 	  };
 	  spectrum_string=spectrum_string.substr(spectrum_string.find(",")+1,spectrum_string.length());    
        };        
-       m_intSpectrum[1.]=m_maxNonzeroFluxEnergy+stepE;
+       spectrum->setNode(1.,m_maxNonzeroFluxEnergy+stepE);
     } else {
        m_maxNonzeroFluxEnergy=0;   
        m_integralFlux=0;
@@ -440,6 +586,7 @@ bool CrTrappedParticle::requestNewSpectrum(const G4double minE,
     // disconnect from server
     
     disconnectFromServer();
+    newSpectrum(spectrum);
        
 // set new spectrum coordinates      
     m_spectrumLatitude=m_latitude;
@@ -13,6 +13,7 @@
 #include <map>
 
 #include "CrSpectrum.hh"
+#include "CrTrappedSpectrumCache.hh"
 
 typedef double G4double;
 
@@ -25,7 +26,8 @@ class CrTrappedParticle : public CrSpectrum
 
 protected:  
   G4double m_spectrumLatitude, m_spectrumLongitude, m_spectrumAltitude;
-  std::map<G4double,G4double> m_intSpectrum;
+  std::map<G4double,G4double> m_intSpectrum; ///< only with CHECK_TRAPPED_SAMPLING
+  CrTrappedSpectrumCache::SpectrumPtr m_spectrum; ///< used for sampling
   G4double m_integralFlux;
   G4double m_maxNonzeroFluxEnergy;
   G4double m_thresholdEnergy,m_eStep,m_eMax,m_modelMinEnergy,m_modelMaxEnergy;
@@ -38,6 +40,8 @@ private:
   std::string m_serverAddress;
   std::string m_xmlDirectory;
   int m_socketHandle;
+  CrTrappedSpectrumCache m_spectrumCache;
+  unsigned long m_cacheReport; ///< print the cache counters every m_cacheReport lookups
 
 
 public:
@@ -51,6 +55,10 @@ public:
   // Gives back particle energy
   double energySrc(CLHEP::HepRandomEngine* engine) const;
 
+  // Fill n particles at once
+  void sampleBlock(CLHEP::HepRandomEngine* engine, int n,
+                   double* energy, double* cosTheta, double* phi) const;
+
   // flux() returns the value averaged over the region from which
   // the particle is coming from and the unit is [c/s/m^2/sr]
   double flux() const;
@@ -63,6 +71,9 @@ public:
 
   // Gives back the name of the component
   std::string title() const;
+
+  // Gives back the cache of the PSB97 spectra
+  const CrTrappedSpectrumCache& spectrumCache() const;
   
 protected:
    bool checkModelCompatibility(const std::string& model,const std::string& particle);
@@ -71,6 +82,11 @@ protected:
    bool psb97UpdateSpectrum(const G4double minE,const G4double maxE,const G4double stepE);
    void connectToServer();
    void disconnectFromServer();
+   double energyFromRandom(double random) const;
+   // complete a spectrum just computed and use it for sampling
+   void newSpectrum(CrTrappedSpectrumCache::Spectrum* spectrum);
+   void useSpectrum(const CrTrappedSpectrumCache::SpectrumPtr& spectrum);
+   void reportCache() const;
 
    ObserverAdapter< CrTrappedParticle > m_updater; ///< obsever tag
    int update();
@@ -0,0 +1,182 @@
+/****************************************************************************
+ * CrTrappedSpectrumCache.cxx:
+ ****************************************************************************
+ * The (L,B) cells are numbered by the nearest multiple of the steps, so a
+ * step equal to the one of the PSB97 maps (0.002, 0.005) puts the
+ * spectra on the nodes of the maps.  The default is half of that.
+ ****************************************************************************
+ */
+
+//$Header$
+
+#include <cmath>
+#include <algorithm>
+
+#include "CrTrappedSpectrumCache.hh"
+
+CrTrappedSpectrumCache::CrTrappedSpectrumCache(double lStep, double bStep,
+                                               double maxMegabytes)
+  : m_lStep(lStep), m_bStep(bStep), m_maxBytes(0), m_bytes(0),
+    m_hits(0), m_misses(0)
+{
+  setMaxMegabytes(maxMegabytes);
+}
+
+CrTrappedSpectrumCache::~CrTrappedSpectrumCache()
+{
+  ;
+}
+
+// Set a node as std::map::operator[] did with the former integral
+// spectrum; the fractions come in increasing order but for rounding,
+// so the node is appended in nearly all cases
+void CrTrappedSpectrumCache::Spectrum::setNode(double r, double e)
+{
+  if (random.empty() || random.back() < r){
+    random.push_back(r);
+    energy.push_back(e);
+    return;
+  }
+  std::vector<double>::iterator it = std::lower_bound(random.begin(), random.end(), r);
+  std::size_t i = it - random.begin();
+  if (*it == r){
+    energy[i] = e;
+    return;
+  }
+  random.insert(it, r);
+  energy.insert(energy.begin()+i, e);
+}
+
+// Fill the guide table: node of the first random >= k/nGuide
+void CrTrappedSpectrumCache::Spectrum::buildGuide()
+{
+  unsigned int nGuide = random.size()>1 ? random.size()-1 : 1;
+  guide.resize(nGuide+1);
+  unsigned int i = 0;
+  for (unsigned int k = 0; k <= nGuide; k++){
+    double r = double(k)/nGuide;
+    while (i < random.size() && random[i] < r){ i++; }
+    guide[k] = i;
+  }
+}
+
+// Find the first node with random >= r and interpolate in the interval
+// below it
+double CrTrappedSpectrumCache::Spectrum::sample(double r) const
+{
+  unsigned int n = random.size();
+  unsigned int i;
+  if (r >= 0 && r <= 1 && !guide.empty()){
+    i = guide[(unsigned int)(r*(guide.size()-1))];
+    // the guide node may be off by one where r*nGuide was rounded
+    while (i > 0 && random[i-1] >= r){ i--; }
+    while (i < n && random[i] < r){ i++; }
+  } else {
+    i = std::lower_bound(random.begin(), random.end(), r) - random.begin();
+  }
+  if (i == n || i == 0){ return 0; }
+
+  double r1 = random[i-1], r2 = random[i];
+  double e1 = energy[i-1], e2 = energy[i];
+  return e1+(r-r1)*(e2-e1)/(r2-r1);
+}
+
+void CrTrappedSpectrumCache::setResolution(double lStep, double bStep)
+{
+  m_lStep = lStep;
+  m_bStep = bStep;
+  clear();
+}
+
+void CrTrappedSpectrumCache::setMaxMegabytes(double maxMegabytes)
+{
+  m_maxBytes = maxMegabytes>0 ? std::size_t(maxMegabytes*1024.*1024.) : 0;
+  shrink();
+}
+
+bool CrTrappedSpectrumCache::enabled() const
+{
+  return m_lStep>0 && m_bStep>0 && m_maxBytes>0;
+}
+
+// Round ll and bb to their cell and gives back the key of the cell
+CrTrappedSpectrumCache::Key CrTrappedSpectrumCache::cell(double& ll, double& bb) const
+{
+  long il = long(floor(ll/m_lStep + 0.5));
+  long ib = long(floor(bb/m_bStep + 0.5));
+  ll = il*m_lStep;
+  bb = ib*m_bStep;
+  return Key(il, ib);
+}
+
+CrTrappedSpectrumCache::SpectrumPtr CrTrappedSpectrumCache::find(const Key& key)
+{
+  std::map<Key, Entries::iterator>::iterator it = m_index.find(key);
+  if (it == m_index.end()){
+    m_misses++;
+    return SpectrumPtr();
+  }
+  m_hits++;
+  // move to the front, the iterators stay valid
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void CrTrappedSpectrumCache::insert(const Key& key, const SpectrumPtr& spectrum)
+{
+  if (!enabled() || !spectrum){ return; }
+  std::map<Key, Entries::iterator>::iterator it = m_index.find(key);
+  if (it != m_index.end()){
+    m_bytes -= bytes(*it->second->second);
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+  m_entries.push_front(std::make_pair(key, spectrum));
+  m_index[key] = m_entries.begin();
+  m_bytes += bytes(*spectrum);
+  shrink();
+}
+
+void CrTrappedSpectrumCache::clear()
+{
+  m_entries.clear();
+  m_index.clear();
+  m_bytes = 0;
+}
+
+unsigned long CrTrappedSpectrumCache::hits() const
+{
+  return m_hits;
+}
+
+unsigned long CrTrappedSpectrumCache::misses() const
+{
+  return m_misses;
+}
+
+std::size_t CrTrappedSpectrumCache::size() const
+{
+  return m_entries.size();
+}
+
+std::size_t CrTrappedSpectrumCache::bytes() const
+{
+  return m_bytes;
+}
+
+std::size_t CrTrappedSpectrumCache::bytes(const Spectrum& spectrum)
+{
+  return sizeof(Spectrum) + sizeof(std::pair<Key,SpectrumPtr>)
+    + (spectrum.random.capacity() + spectrum.energy.capacity())*sizeof(double)
+    + spectrum.guide.capacity()*sizeof(unsigned int);
+}
+
+// Drop the spectra used longest ago until the limit is met
+void CrTrappedSpectrumCache::shrink()
+{
+  while (m_bytes > m_maxBytes && !m_entries.empty()){
+    m_bytes -= bytes(*m_entries.back().second);
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+}
@@ -0,0 +1,102 @@
+/**
+ * CrTrappedSpectrumCache:
+ *  Integral spectra of the trapped particles, ready for sampling,
+ *  kept for the (L,B) cells visited last.
+ */
+
+//$Header$
+
+#ifndef CrTrappedSpectrumCache_H
+#define CrTrappedSpectrumCache_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/** @class CrTrappedSpectrumCache
+ *  @brief least-recently-used cache of trapped particle spectra
+ *
+ * McIlwain L and B are rounded to multiples of a step each; the
+ * spectrum of a cell is computed once at the rounded (L,B) and used
+ * again whenever the orbit comes back to the cell, e.g. on the next
+ * pass through the SAA.  When the spectra take more memory than the
+ * limit, those not used for the longest time are dropped.
+ * A step of 0 switches the cache off.
+ */
+class CrTrappedSpectrumCache
+{
+public:
+  /// Integral spectrum inverted for sampling from flat random numbers:
+  /// random[i] is the fraction of the flux below energy[i] [MeV].
+  /// guide[k] is the first node with random >= k/(guide.size()-1), so
+  /// a sample starts next to its node and needs no search.
+  struct Spectrum {
+    double integralFlux;          ///< flux above the threshold [c/s/cm^2]
+    double maxNonzeroFluxEnergy;  ///< [MeV], 0 if there is no flux
+    std::vector<double> random;
+    std::vector<double> energy;
+    std::vector<unsigned int> guide;
+
+    /// Set the energy at the fraction r; random is kept sorted, and a
+    /// fraction already in the table takes the new energy
+    void setNode(double r, double e);
+    /// Fill guide from random, one entry per node
+    void buildGuide();
+    /// Gives back the energy [MeV] for a flat random number, 0 if it
+    /// is not inside the table
+    double sample(double r) const;
+  };
+  typedef std::shared_ptr<const Spectrum> SpectrumPtr;
+  typedef std::pair<long,long> Key;
+
+  CrTrappedSpectrumCache(double lStep=0.001, double bStep=0.0025,
+                         double maxMegabytes=8.);
+  ~CrTrappedSpectrumCache();
+
+  /// Set the steps in L [R_earth] and B; the cache is cleared
+  void setResolution(double lStep, double bStep);
+  /// Set the memory limit; spectra above the limit are dropped
+  void setMaxMegabytes(double maxMegabytes);
+
+  /// true if the steps and the memory limit are positive
+  bool enabled() const;
+
+  /// Round ll and bb to their cell and gives back the key of the cell
+  Key cell(double& ll, double& bb) const;
+
+  /// Gives back the spectrum of the cell, or an empty pointer
+  SpectrumPtr find(const Key& key);
+
+  /// Store the spectrum of a cell
+  void insert(const Key& key, const SpectrumPtr& spectrum);
+
+  void clear();
+
+  /// Number of lookups answered from the cache and missed
+  unsigned long hits() const;
+  unsigned long misses() const;
+  /// Number of spectra and the memory they take [bytes]
+  std::size_t size() const;
+  std::size_t bytes() const;
+
+private:
+  typedef std::list< std::pair<Key,SpectrumPtr> > Entries;
+
+  static std::size_t bytes(const Spectrum& spectrum);
+  // Drop the spectra used longest ago until the limit is met
+  void shrink();
+
+  double m_lStep, m_bStep;
+  std::size_t m_maxBytes;
+  std::size_t m_bytes;
+
+  Entries m_entries;  ///< most recently used first
+  std::map<Key, Entries::iterator> m_index;
+
+  unsigned long m_hits, m_misses;
+};
+
+#endif // CrTrappedSpectrumCache_H
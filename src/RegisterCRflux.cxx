@@ -7,8 +7,13 @@
 #include "FluxSvc/IFluxSvc.h"
 // CR includes
 #include "CrCoordinateTransfer.hh"
+#include "CrGeomagneticState.hh"
 #include "CrExample.h"
 #include "CrProton.hh"
+#include "CrProtonPrimary.hh"
+#include "CrProtonReentrant.hh"
+#include "CrProtonSplash.hh"
+#include "CrLatitudeBinnedModel.hh"
 #include "CrAlpha.hh"
 #include "CrElectron.hh"
 #include "CrPositron.hh"
@@ -20,6 +25,10 @@
 //#include "CrHeavyIonZ.h"
 
 #include "CrLocation.h"
+#include "CrPositionProvider.hh"
+#include "CrPhiloxEngine.hh"
+#include "CrDiagnostics.hh"
+#include "CrFluxIntegralTable.hh"
 
 #include "CLHEP/Random/Random.h"
 
@@ -41,6 +50,22 @@ public:
     StatusCode initialize(); // overload
     
     double m_cutoff;
+    std::string m_primarySampler;
+    std::string m_eastWestSampler;
+    bool m_geomagneticGrid;
+    std::string m_geomagneticGridFile;
+    double m_geomagneticGridTolerance;
+    std::string m_protonSplashTable;
+    std::string m_protonReentrantTable;
+    bool m_secondaryCompatible;
+    bool m_secondaryBlended;
+    int m_randomStream;
+    int m_randomSeed;
+    int m_warningLimit;
+    std::vector<double> m_fluxTableCutOffRigidities;
+    std::vector<double> m_fluxTableSolarPotentials;
+    std::string m_fluxTableCache;
+    bool m_restrictRange;
 };
 
 
@@ -61,6 +86,54 @@ RegisterCRflux::RegisterCRflux(const std::string& type,
     // for testing with a given cutoff
     declareProperty("FixedCutoff", m_cutoff=0);
 
+    // energy sampling of the primary protons: "table" or "rejection"
+    declareProperty("PrimarySampler", m_primarySampler="table");
+
+    // azimuth of the East-West effect: "table" (CrEastWestTable) or
+    // "rejection", the former accept/reject loop
+    declareProperty("EastWestSampler", m_eastWestSampler="table");
+
+    // interpolate the geomagnetic field in a grid made once per model year,
+    // kept in GeomagneticGridFile, with the year before the extension, if
+    // given; the grid is used only if it agrees with the field model
+    // within GeomagneticGridTolerance
+    declareProperty("GeomagneticGrid", m_geomagneticGrid=false);
+    declareProperty("GeomagneticGridFile", m_geomagneticGridFile="");
+    declareProperty("GeomagneticGridTolerance", m_geomagneticGridTolerance=0.01);
+
+    // tables of the secondary proton models (see CrLatitudeBinnedModel::read)
+    // used instead of the built-in ones; with SecondaryCompatible the random
+    // numbers are used as by the former code, which gives the same particles
+    declareProperty("ProtonSplashTable", m_protonSplashTable="");
+    declareProperty("ProtonReentrantTable", m_protonReentrantTable="");
+    declareProperty("SecondaryCompatible", m_secondaryCompatible=true);
+    // sample the splash and reentrant p, e- and e+ from the mixture of the
+    // latitude bins, tabulated when the geomagnetic latitude changes
+    declareProperty("SecondaryBlended", m_secondaryBlended=false);
+
+    // with RandomStream >= 0 (e.g. the job index) the CRflux sources
+    // draw from that stream of a CrPhiloxEngine of RandomSeed instead
+    // of the engine of FluxSvc, so jobs have independent, reproducible
+    // random numbers
+    declareProperty("RandomStream", m_randomStream=-1);
+    declareProperty("RandomSeed", m_randomSeed=12345);
+
+    // number of times each kind of warning (e.g. a cutoff rigidity
+    // restricted to 0.5 GV) is printed; CRfluxSvc counts them all and
+    // prints the counts at finalize.  -1 prints every one.
+    declareProperty("WarningLimit", m_warningLimit=1);
+
+    // nodes [GV], [MV] of the flux tables of the primaries, computed at
+    // the first flux() and again if the nodes change (empty: 0.5, 1,
+    // ..., 15 GV and 500, ..., 1100 MV), and a directory where they are
+    // kept for the next runs
+    declareProperty("FluxTableCutOffRigidities", m_fluxTableCutOffRigidities);
+    declareProperty("FluxTableSolarPotentials", m_fluxTableSolarPotentials);
+    declareProperty("FluxTableCache", m_fluxTableCache="");
+    // restrict the cutoff rigidity to 0.5-14.9 GV and the solar
+    // potential to 500-1100 MV
+    declareProperty("RestrictRange", m_restrictRange=true);
+
 }
 
 
@@ -88,6 +161,9 @@ StatusCode RegisterCRflux::registerMe(IFluxSvc* fsvc)
 
    // Get the initial location from FluxSvc and store in the CrLocation singleton
    CrLocation::instance()->setFluxSvc(fsvc);
+   // the components follow the GPS of FluxSvc
+   static CrGPSPosition gpsPosition(fsvc->GPSinstance());
+   CrPositionProvider::setCurrent(&gpsPosition);
    initialize(); //?
 
    return StatusCode::SUCCESS;
@@ -97,6 +173,30 @@ StatusCode RegisterCRflux::initialize()
    //Set the properties
     setProperties();
     if( m_cutoff != 0 ) CrCoordinateTransfer::s_fixedCutoff=0;
+    if( m_primarySampler == "rejection" ){
+        CrProtonPrimary::s_defaultSamplerMode = CrProtonPrimary::rejection;
+    }else{
+        CrProtonPrimary::s_defaultSamplerMode = CrProtonPrimary::inverseCDF;
+    }
+    CrSpectrum::s_eastWestTable = m_eastWestSampler != "rejection";
+    if( m_geomagneticGrid ){
+        CrGeomagneticState::instance()->useGrid(true, m_geomagneticGridFile,
+                                                m_geomagneticGridTolerance);
+    }
+    CrProtonSplash::s_tableFile = m_protonSplashTable;
+    CrProtonReentrant::s_tableFile = m_protonReentrantTable;
+    CrLatitudeBinnedModel::s_defaultCompatible = m_secondaryCompatible;
+    CrLatitudeBinnedModel::s_defaultBlended = m_secondaryBlended;
+    if( m_randomStream >= 0 ){
+        static CrPhiloxEngine philox;
+        philox = CrPhiloxEngine(m_randomSeed).stream(m_randomStream);
+        CLHEP::HepRandom::setTheEngine(&philox);
+    }
+    CrDiagnostics::setLimit(m_warningLimit);
+    CrFluxIntegralTable::s_corNodes = m_fluxTableCutOffRigidities;
+    CrFluxIntegralTable::s_phiNodes = m_fluxTableSolarPotentials;
+    CrFluxIntegralTable::s_cacheDirectory = m_fluxTableCache;
+    CrSpectrum::s_restrictRange = m_restrictRange;
 
     return StatusCode::SUCCESS;
 }
@@ -0,0 +1,169 @@
+/**
+ * batch_math_bench:
+ *  Measures the largest error of the functions of CrBatchMath against
+ *  long double references and times them against the loops over libm
+ *  which they replace.  Fails if an error exceeds the bound given in
+ *  CrBatchMath.hh.
+ *
+ *  usage: batch_math_bench [samples]
+ *
+ *  The arguments are random over the ranges of the envelope samplers:
+ *  energies from 1e-13 to 1e13, exponents from -4 to 4.
+ */
+
+//$Header$
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../CrBatchMath.hh"
+
+namespace {
+  // error of a in units of the last place of the rounded reference
+  double ulps(double a, long double ref)
+  {
+    double r = std::fabs(double(ref));
+    double ulp = std::nextafter(r, HUGE_VAL) - r;
+    return double(std::fabs(a - ref)/ulp);
+  }
+
+  double seconds(std::clock_t start)
+  {
+    return double(std::clock()-start)/CLOCKS_PER_SEC;
+  }
+
+  double uniform()
+  {
+    return (std::rand()+0.5)/(RAND_MAX+1.);
+  }
+
+  int status = 0;
+
+  // prints one line and keeps the failure; excess is the largest
+  // error minus its bound, over the elements
+  void report(const char* name, double maxUlp, double excess, double tBatch, double tLibm,
+              unsigned int n)
+  {
+    bool ok = excess <= 0;
+    if (!ok) status = 1;
+    std::cout << std::left << std::setw(16) << name << std::right
+              << "  max " << std::setw(8) << maxUlp << " ulp"
+              << "  " << std::setw(7) << tBatch/n*1e9 << " ns"
+              << "  libm " << std::setw(7) << tLibm/n*1e9 << " ns"
+              << (ok ? "" : "  FAILED") << std::endl;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  unsigned int n = argc>1 ? std::atoi(argv[1]) : 1000000;
+
+  std::vector<double> x(n), y(n), v(n), r(n), s(n);
+  std::srand(12345);
+  for (unsigned int i = 0; i < n; i++){
+    x[i] = std::exp(uniform()*60-30);
+    y[i] = uniform()*8-4;
+    v[i] = -uniform()*100;
+  }
+  std::cout << "instruction set: " << CrBatchMath::instructionSet() << std::endl;
+
+  // the bounds of CrBatchMath.hh, with |y*log(x)| of each element
+  double maxUlp, excess;
+  std::clock_t start;
+  double tBatch, tLibm;
+
+  start = std::clock();
+  CrBatchMath::log(n, &x[0], &r[0]);
+  tBatch = seconds(start);
+  start = std::clock();
+  for (unsigned int i = 0; i < n; i++) s[i] = std::log(x[i]);
+  tLibm = seconds(start);
+  maxUlp = 0;
+  for (unsigned int i = 0; i < n; i++) maxUlp = std::max(maxUlp, ulps(r[i], logl(x[i])));
+  report("log", maxUlp, maxUlp - 1, tBatch, tLibm, n);
+
+  start = std::clock();
+  CrBatchMath::exp(n, &y[0], &r[0]);
+  tBatch = seconds(start);
+  start = std::clock();
+  for (unsigned int i = 0; i < n; i++) s[i] = std::exp(y[i]);
+  tLibm = seconds(start);
+  maxUlp = 0;
+  for (unsigned int i = 0; i < n; i++) maxUlp = std::max(maxUlp, ulps(r[i], expl(y[i])));
+  report("exp", maxUlp, maxUlp - 1, tBatch, tLibm, n);
+
+  start = std::clock();
+  CrBatchMath::pow(n, &x[0], &y[0], &r[0]);
+  tBatch = seconds(start);
+  start = std::clock();
+  for (unsigned int i = 0; i < n; i++) s[i] = std::pow(x[i], y[i]);
+  tLibm = seconds(start);
+  maxUlp = 0;
+  excess = 0;
+  for (unsigned int i = 0; i < n; i++){
+    double e = ulps(r[i], powl(x[i], y[i]));
+    maxUlp = std::max(maxUlp, e);
+    excess = std::max(excess, e - (1 + 2*std::fabs(y[i]*std::log(x[i]))));
+  }
+  report("pow", maxUlp, excess, tBatch, tLibm, n);
+
+  const double A = 40, a = 2.15;
+  start = std::clock();
+  CrBatchMath::powerLaw(n, &x[0], A, a, &r[0]);
+  tBatch = seconds(start);
+  start = std::clock();
+  for (unsigned int i = 0; i < n; i++) s[i] = A*std::pow(x[i], -a);
+  tLibm = seconds(start);
+  maxUlp = 0;
+  excess = 0;
+  for (unsigned int i = 0; i < n; i++){
+    double e = ulps(r[i], A*powl(x[i], -a));
+    maxUlp = std::max(maxUlp, e);
+    excess = std::max(excess, e - (1.5 + 2*std::fabs(a*std::log(x[i]))));
+  }
+  report("powerLaw", maxUlp, excess, tBatch, tLibm, n);
+
+  start = std::clock();
+  CrBatchMath::powerLawInverse(n, &v[0], A, a, &r[0]);
+  tBatch = seconds(start);
+  start = std::clock();
+  for (unsigned int i = 0; i < n; i++) s[i] = std::pow((-a+1)/A*v[i], 1./(-a+1));
+  tLibm = seconds(start);
+  maxUlp = 0;
+  excess = 0;
+  for (unsigned int i = 0; i < n; i++){
+    long double base = (-a+1)/A*v[i];
+    double e = ulps(r[i], powl(base, 1/(1-(long double)a)));
+    maxUlp = std::max(maxUlp, e);
+    excess = std::max(excess, e - (1 + 2*std::fabs(std::log(double(base))/(-a+1))));
+  }
+  report("powerLawInverse", maxUlp, excess, tBatch, tLibm, n);
+
+  // the cutoff of the upward secondary gamma rays
+  const double Ac = 1.1e5, ac = 2.5, cut = 120, b = -1.5;
+  start = std::clock();
+  CrBatchMath::cutoffPowerLaw(n, &x[0], Ac, ac, cut, b, &r[0]);
+  tBatch = seconds(start);
+  start = std::clock();
+  for (unsigned int i = 0; i < n; i++) s[i] = Ac*std::pow(x[i], -ac)*std::exp(-std::pow(x[i]/cut, b));
+  tLibm = seconds(start);
+  maxUlp = 0;
+  excess = 0;
+  for (unsigned int i = 0; i < n; i++){
+    long double q = powl(x[i]/(long double)cut, b);
+    long double ref = Ac*powl(x[i], -ac)*expl(-q);
+    // not for subnormal results, whose ulp is that of the smallest double
+    if (ref < 1e-300L) continue;
+    double e = ulps(r[i], ref);
+    maxUlp = std::max(maxUlp, e);
+    excess = std::max(excess, e - (1 + 5*(std::fabs(ac*std::log(x[i])) + double(q))));
+  }
+  report("cutoffPowerLaw", maxUlp, excess, tBatch, tLibm, n);
+
+  return status;
+}
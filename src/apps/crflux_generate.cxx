@@ -0,0 +1,174 @@
+/**
+ * crflux_generate:
+ *  Generates cosmic-ray particles along an orbit with the CRflux
+ *  components only, without Gaudi, FluxSvc or the xml libraries, and
+ *  writes them to a text file.
+ *
+ *  usage: crflux_generate source [options]
+ *
+ *    source           CrProton, CrAlpha, CrElectron, CrPositron, CrGamma,
+ *                     CrNeutron or CrHeavyIon, optionally followed by the
+ *                     parameters of the source library, e.g. "CrProton,3"
+ *                     (primary and reentrant) or "CrHeavyIon,26"
+ *    -n events        number of particles (default 1000)
+ *    -o file          output file (default: standard output)
+ *    -time t0,t1      time range [s from 2001-01-01] (default 2.4e8, one day later)
+ *    -orbit i,h       circular orbit of inclination i [deg] and altitude h [km]
+ *                     (default 25.6,565)
+ *    -position lat,lon  fixed geographic position [deg] instead of the orbit
+ *    -step s          the position is updated every s seconds (default 30)
+ *    -energy e0,e1    energy range of the gammas [GeV] (default 1e-3,100)
+ *    -seed n          seed of the random engine (default 12345)
+ *    -stream j        draw from the stream j (e.g. the job index) of the
+ *                     CrPhiloxEngine of the seed (default 0)
+ *    -threads n       number of threads (default 1)
+ *    -fluxcache dir   keep the flux tables of the primaries in dir
+ *
+ *  The particles are shared among the steps of the orbit in the ratio
+ *  of the total flux at each step, and placed at random within a step.
+ *  Each step draws from its own stream of the CrPhiloxEngine, so the
+ *  output does not depend on the number of threads; it is in time order.
+ *  The species of CrHeavyIon is drawn for every particle.
+ *  One line per particle:
+ *    time latitude longitude component particle energy[GeV] cos(theta) phi[rad]
+ *  The warnings of the components, with their counts at the end, go to
+ *  the standard error.
+ */
+
+//$Header$
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../CrDiagnostics.hh"
+#include "../CrFluxIntegralTable.hh"
+#include "../CrParallelGenerator.hh"
+#include "../CrSourceFactory.hh"
+#include "../CrTrajectory.hh"
+
+namespace {
+  // one line per particle
+  class TextOutput : public CrParallelGenerator::Output {
+  public:
+    TextOutput(std::ostream& out, const std::vector<std::string>& names)
+      : m_out(out), m_names(names), m_count(0) {}
+
+    void write(const CrParallelGenerator::Event& event)
+    {
+      m_out << event.time << " " << event.latitude << " " << event.longitude << " "
+            << m_names[event.component] << " " << event.particle << " "
+            << event.energy << " " << event.cosTheta << " " << event.phi << "\n";
+      m_count++;
+    }
+
+    long count() const { return m_count; }
+
+  private:
+    std::ostream& m_out;
+    const std::vector<std::string>& m_names;
+    long m_count;
+  };
+
+  bool pair(const std::string& arg, double& first, double& second)
+  {
+    std::istringstream in(arg);
+    char comma = 0;
+    in >> first >> comma >> second;
+    return !in.fail() && comma == ',';
+  }
+
+  void usage()
+  {
+    std::cerr << "usage: crflux_generate source[,params] [-n events] [-o file]"
+              << " [-time t0,t1] [-orbit i,h | -position lat,lon] [-step s]"
+              << " [-energy e0,e1] [-seed n] [-stream j] [-threads n] [-fluxcache dir]" << std::endl;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1, argv+argc);
+  if (args.empty() || args[0][0] == '-'){ usage(); return 1; }
+
+  std::string source = args[0];
+  std::string output;
+  double inclination = 25.6, altitude = 565.;
+  bool fixed = false;
+  double fixedLatitude = 0, fixedLongitude = 0;
+  double eLow = 1.0e-3, eHigh = 100.;
+  long stream = 0;
+  CrParallelGenerator::Settings settings;
+
+  for (unsigned int i = 1; i < args.size(); i++){
+    bool ok = i+1 < args.size();
+    const std::string& opt = args[i];
+    const std::string value = ok ? args[++i] : "";
+    if (opt == "-n"){ settings.events = std::atol(value.c_str()); }
+    else if (opt == "-o"){ output = value; }
+    else if (opt == "-time"){ ok = ok && pair(value, settings.startTime, settings.stopTime); }
+    else if (opt == "-orbit"){ ok = ok && pair(value, inclination, altitude); }
+    else if (opt == "-position"){ ok = ok && pair(value, fixedLatitude, fixedLongitude); fixed = true; }
+    else if (opt == "-step"){ settings.step = std::atof(value.c_str()); }
+    else if (opt == "-energy"){ ok = ok && pair(value, eLow, eHigh); }
+    else if (opt == "-seed"){ settings.seed = std::atol(value.c_str()); }
+    else if (opt == "-stream"){ stream = std::atol(value.c_str()); ok = ok && stream >= 0; }
+    else if (opt == "-threads"){ settings.threads = std::atoi(value.c_str()); ok = ok && settings.threads > 0; }
+    else if (opt == "-fluxcache"){ CrFluxIntegralTable::s_cacheDirectory = value; }
+    else { ok = false; }
+    if (!ok){
+      std::cerr << "crflux_generate: bad option " << opt << std::endl;
+      usage();
+      return 1;
+    }
+  }
+  settings.job = stream;
+  if (!(settings.stopTime > settings.startTime) || !(settings.step > 0)
+      || settings.events < 0 || !(eHigh >= eLow)){
+    std::cerr << "crflux_generate: empty time, energy range or step" << std::endl;
+    return 1;
+  }
+
+  // the particles may go to the standard output
+  CrDiagnostics::setStream(&std::cerr);
+
+  CrSourceFactory factory(source, eLow, eHigh);
+  if (!factory.valid()){
+    std::cerr << "crflux_generate: unknown source " << source << std::endl;
+    return 1;
+  }
+  CrCircularOrbit orbit(inclination, altitude);
+  CrFixedTrajectory position(fixedLatitude, fixedLongitude, altitude);
+  CrParallelGenerator generator(factory, fixed ? static_cast<const CrTrajectory&>(position)
+                                               : static_cast<const CrTrajectory&>(orbit));
+
+  std::ofstream file;
+  if (!output.empty()){
+    file.open(output.c_str());
+    if (!file){
+      std::cerr << "crflux_generate: cannot write " << output << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& out = output.empty() ? std::cout : file;
+  out.precision(10);
+  out << "# crflux_generate " << source << " events " << settings.events
+      << " time " << settings.startTime << " " << settings.stopTime << std::endl;
+  out << "# time latitude longitude component particle energy[GeV] cos(theta) phi[rad]"
+      << std::endl;
+
+  TextOutput text(out, generator.componentNames());
+  if (!generator.run(settings, text)){
+    std::cerr << "crflux_generate: no flux in the time range" << std::endl;
+    return 1;
+  }
+  out.flush();
+
+  std::cerr << "crflux_generate: " << text.count() << " particles of " << source
+            << ", mean rate " << generator.meanRate() << " [c/s/m^2]" << std::endl;
+  CrDiagnostics::summary(std::cerr);
+  return out ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/**
+ * envelope_sampling_bench:
+ *  Times the sampling of energies from a piecewise power-law envelope,
+ *  with the integrals of the pieces computed for every particle as the
+ *  gamma components did before and with the integrals kept in a
+ *  CrEnvelopeIntegrals, and checks that both give the same energies.
+ *
+ *  usage: envelope_sampling_bench [samples]
+ *
+ *  The envelope is the one of CrGammaPrimary, sampled between 1 MeV
+ *  and 100 GeV and between 30 keV and 100 GeV.
+ */
+
+//$Header$
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "../CrEnvelopeIntegrals.hh"
+
+namespace {
+  // A*(E/MeV)^-a [c/s/m^2/sr/MeV] between eLow and eHigh [GeV]
+  struct Piece {
+    double A, a, eLow, eHigh;
+  };
+
+  // the three power laws of CrGammaPrimary
+  const Piece pieces[] = {
+    {570.8, 1.86, 30.0e-6, 50.0e-6},
+    { 40.0, 2.75, 50.0e-6, 1.0e-3},
+    { 40.0, 2.15, 1.0e-3, 100.0}
+  };
+  const int nPieces = sizeof(pieces)/sizeof(pieces[0]);
+
+  inline double integral(const Piece& p, double E /* GeV */)
+  {
+    return p.A/(-p.a+1) * pow(E*1e3, -p.a+1);
+  }
+
+  inline double integral_inv(const Piece& p, double value)
+  {
+    return pow((-p.a+1)/p.A * value, 1./(-p.a+1)) * 1e-3;
+  }
+
+  inline double clip(double E, double lowE, double highE)
+  {
+    return E<lowE ? lowE : (E>highE ? highE : E);
+  }
+
+  // integrals at the ends of the pieces within [lowE, highE]
+  void integrals(double lowE, double highE, double* low, double* high)
+  {
+    for (int k = 0; k < nPieces; k++){
+      low[k] = integral(pieces[k], clip(lowE, pieces[k].eLow, pieces[k].eHigh));
+      high[k] = integral(pieces[k], clip(highE, pieces[k].eLow, pieces[k].eHigh));
+    }
+  }
+
+  // as energySrc() of the components did: all integrals per particle
+  double sampleRecomputed(double lowE, double highE, double r1, double r2)
+  {
+    double low[nPieces], high[nPieces];
+    integrals(lowE, highE, low, high);
+    double area = 0;
+    for (int k = 0; k < nPieces; k++){ area += high[k]-low[k]; }
+    double sum = 0;
+    int k = 0;
+    for (; k < nPieces-1; k++){
+      sum += high[k]-low[k];
+      if (r1 <= sum/area){ break; }
+    }
+    return integral_inv(pieces[k], r2*(high[k]-low[k]) + low[k]);
+  }
+
+  // with the integrals kept
+  double sampleKept(const CrEnvelopeIntegrals& envelope, double r1, double r2)
+  {
+    int k = envelope.piece(r1);
+    return integral_inv(pieces[k], r2*envelope.area(k) + envelope.low(k));
+  }
+
+  double seconds(std::clock_t start)
+  {
+    return double(std::clock()-start)/CLOCKS_PER_SEC;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  unsigned int nSample = argc>1 ? std::atoi(argv[1]) : 10000000;
+
+  std::vector<double> rnd(2*nSample);
+  std::srand(12345);
+  for (unsigned int i = 0; i < 2*nSample; i++) rnd[i] = (std::rand()+0.5)/(RAND_MAX+1.);
+
+  const double ranges[][2] = {{1.0e-3, 100.}, {30.0e-6, 100.}};
+  int status = 0;
+  for (unsigned int p = 0; p < sizeof(ranges)/sizeof(ranges[0]); p++){
+    double lowE = ranges[p][0], highE = ranges[p][1];
+
+    std::clock_t start = std::clock();
+    CrEnvelopeIntegrals envelope;
+    double low[nPieces], high[nPieces];
+    integrals(lowE, highE, low, high);
+    envelope.set(nPieces, low, high);
+    double tSet = seconds(start);
+
+    double sumRecomputed = 0, sumKept = 0;
+    unsigned int differ = 0;
+    start = std::clock();
+    for (unsigned int i = 0; i < nSample; i++){
+      sumRecomputed += sampleRecomputed(lowE, highE, rnd[2*i], rnd[2*i+1]);
+    }
+    double tRecomputed = seconds(start);
+    start = std::clock();
+    for (unsigned int i = 0; i < nSample; i++){
+      sumKept += sampleKept(envelope, rnd[2*i], rnd[2*i+1]);
+    }
+    double tKept = seconds(start);
+    for (unsigned int i = 0; i < nSample; i++){
+      if (sampleRecomputed(lowE, highE, rnd[2*i], rnd[2*i+1])
+          != sampleKept(envelope, rnd[2*i], rnd[2*i+1])) differ++;
+    }
+    if (differ) status = 1;
+
+    std::cout << lowE << "-" << highE << " GeV"
+              << "  per particle: " << tRecomputed/nSample*1e9 << " ns"
+              << "  kept: " << tKept/nSample*1e9 << " ns"
+              << " (set up " << tSet*1e6 << " us)"
+              << "  saving " << (tRecomputed-tKept)/nSample*1e9 << " ns/particle"
+              << "  mean energy " << sumRecomputed/nSample << " / " << sumKept/nSample << " GeV"
+              << "  differences " << differ << std::endl;
+  }
+  return status;
+}
@@ -0,0 +1,156 @@
+/**
+ * ew_dir_ks:
+ *  Compares the directions of CrSpectrum::EW_dir (azimuth from the
+ *  table of CrEastWestTable) with those of the accept/reject loop
+ *  EW_dirRejection by two-sample Kolmogorov-Smirnov tests.
+ *
+ *  usage: ew_dir_ks [samples]
+ *
+ *  For each species (coeff), position, cutoff and rigidity the test
+ *  is made on phi for all the particles and for three bands of
+ *  cos(theta), and on cos(theta).  One line per test:
+ *    coeff geomagneticLatitude cor rig/cor variable D p-value
+ *  A test fails when p < 0.001; the program gives back the number
+ *  of failed tests.
+ */
+
+//$Header$
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <CLHEP/Random/JamesRandom.h>
+
+#include "../CrPositionProvider.hh"
+#include "../CrSamplingCounters.hh"
+#include "../CrSpectrum.hh"
+#include "../CrProtonPrimary.hh"
+#include "../CrElectronPrimary.hh"
+
+namespace {
+  // Gives back the statistic D of two samples, which are sorted
+  double distance(std::vector<double>& a, std::vector<double>& b)
+  {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    double d = 0;
+    unsigned int i = 0, j = 0;
+    while (i < a.size() && j < b.size()){
+      double x = std::min(a[i], b[j]);
+      while (i < a.size() && a[i] <= x){ i++; }
+      while (j < b.size() && b[j] <= x){ j++; }
+      d = std::max(d, std::fabs(double(i)/a.size() - double(j)/b.size()));
+    }
+    return d;
+  }
+
+  // Gives back the asymptotic probability of a distance above d
+  double pValue(double d, unsigned int n, unsigned int m)
+  {
+    double ne = double(n)*m/(n+m);
+    double lambda = (sqrt(ne)+0.12+0.11/sqrt(ne))*d;
+    double p = 0;
+    for (int k = 1; k <= 100; k++){
+      double term = 2*((k%2) ? 1 : -1)*exp(-2*k*k*lambda*lambda);
+      p += term;
+      if (std::fabs(term) < 1e-12){ break; }
+    }
+    return p<0 ? 0 : p>1 ? 1 : p;
+  }
+
+  struct Sample {
+    std::vector<double> cosTheta, phi;
+    std::vector<double> band[3]; ///< phi for cos(theta) in 3 bands
+  };
+
+  void fill(Sample& sample, const std::pair<double,double>& direction)
+  {
+    double phi = fmod(direction.second, 2*M_PI);
+    sample.cosTheta.push_back(direction.first);
+    sample.phi.push_back(phi);
+    int band = direction.first < 0.0 ? 0 : direction.first < 0.6 ? 1 : 2;
+    sample.band[band].push_back(phi);
+  }
+
+  int test(std::vector<double>& a, std::vector<double>& b, const char* variable,
+           double coeff, double magLat, double cor, double x)
+  {
+    if (a.empty() || b.empty()){ return 0; }
+    double d = distance(a, b);
+    double p = pValue(d, a.size(), b.size());
+    std::cout << coeff << "\t" << magLat << "\t" << cor << "\t" << x
+              << "\t" << variable << "\t" << d << "\t" << p << std::endl;
+    return p < 0.001 ? 1 : 0;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  unsigned int nSample = argc>1 ? std::atoi(argv[1]) : 200000;
+
+  CrFixedPosition position(0., 0., 565., 2.4e8);
+  CrPositionProvider::setCurrent(&position);
+
+  // protons and electrons, coeff -12 and -6
+  CrProtonPrimary proton;
+  CrElectronPrimary electron;
+  CrSpectrum* species[] = { &proton, &electron };
+  const double coeffs[] = { -12.0, -6.0 };
+  const double polarities[] = { 1.0, -1.0 };
+  const double latitudes[] = { 0., 25., 50. };
+  const double cors[] = { 14., 5., 1.5 };
+  const double ratios[] = { 0.7, 1.0, 1.3, 2.0, 5.0 };
+
+  CLHEP::HepJamesRandom engine(12345);
+  int failed = 0;
+  double secondsTable = 0, secondsRejection = 0;
+
+  std::cout << "#coeff\tgeomagneticLatitude\tcor\trig/cor\tvariable\tD\tp" << std::endl;
+  for (unsigned int s = 0; s < 2; s++){
+    for (unsigned int l = 0; l < 3; l++){
+      position.setPosition(latitudes[l], 0., 565., 2.4e8);
+      CrSpectrum* component = species[s];
+      component->setCutOffRigidity(cors[l]);
+      double magLat = component->geomagneticLatitude();
+      for (unsigned int r = 0; r < 5; r++){
+        double rig = ratios[r]*cors[l];
+        Sample table, rejection;
+
+        std::clock_t start = std::clock();
+        for (unsigned int i = 0; i < nSample; i++){
+          fill(table, component->EW_dir(rig, coeffs[s], polarities[s], &engine));
+        }
+        secondsTable += double(std::clock()-start)/CLOCKS_PER_SEC;
+        start = std::clock();
+        for (unsigned int i = 0; i < nSample; i++){
+          fill(rejection, component->EW_dirRejection(rig, coeffs[s], polarities[s], &engine));
+        }
+        secondsRejection += double(std::clock()-start)/CLOCKS_PER_SEC;
+
+        failed += test(table.phi, rejection.phi, "phi",
+                       coeffs[s], magLat, cors[l], ratios[r]);
+        failed += test(table.cosTheta, rejection.cosTheta, "cos(theta)",
+                       coeffs[s], magLat, cors[l], ratios[r]);
+        const char* bands[] = { "phi|cos<0", "phi|cos<0.6", "phi|cos>=0.6" };
+        for (int b = 0; b < 3; b++){
+          failed += test(table.band[b], rejection.band[b], bands[b],
+                         coeffs[s], magLat, cors[l], ratios[r]);
+        }
+      }
+    }
+  }
+
+  std::cerr << "ew_dir_ks: " << failed << " failed tests; time per direction "
+            << secondsTable/(30.*nSample)*1e9 << " ns (table), "
+            << secondsRejection/(30.*nSample)*1e9 << " ns (rejection)" << std::endl;
+  // trials per particle of both, with -DCRFLUX_SAMPLING_COUNTERS
+  if (CrSamplingCounters::enabled()){
+    CrSamplingCounters::print(std::cerr);
+  }
+  return failed;
+}
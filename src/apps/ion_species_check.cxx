@@ -0,0 +1,182 @@
+/**
+ * ion_species_check:
+ *  Checks that CrParallelGenerator draws the species of the heavy ions
+ *  for every particle: the species of the particles of each slice must
+ *  follow the abundances of CrIonSpecies.  So must the ions given back
+ *  by a block of events per slice particles of CrHeavyIonPrimary,
+ *  filled through CrComponentMix::sampleBlock() as CrHeavyIon does.
+ *
+ *  usage: ion_species_check [source [events per slice [slices [threads]]]]
+ *
+ *  The source is given as to crflux_generate (default CrHeavyIon); the
+ *  slices are 300 s of the default orbit.  One line per slice:
+ *    slice events species chi2
+ *  with the number of species seen and the chi-square of their counts
+ *  against the abundances, and a last line "block" for sampleBlock().
+ *  The program gives back 1 if a slice or the block is beyond the 1e-4
+ *  tail of the chi-square distribution, or if a particle is not a
+ *  heavy ion.
+ */
+
+//$Header$
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../CrComponentMix.hh"
+#include "../CrHeavyIonPrimary.hh"
+#include "../CrIonSpecies.hh"
+#include "../CrParallelGenerator.hh"
+#include "../CrPhiloxEngine.hh"
+#include "../CrPositionProvider.hh"
+#include "../CrSourceFactory.hh"
+#include "../CrTrajectory.hh"
+
+namespace {
+  // counts of the species of the particles, per slice
+  class SpeciesOutput : public CrParallelGenerator::Output {
+  public:
+    SpeciesOutput(double start, double step, long nSlice)
+      : m_start(start), m_step(step), m_unknown(0),
+        m_counts(nSlice, std::vector<long>(CrIonSpecies::instance().size(), 0)) {}
+
+    void write(const CrParallelGenerator::Event& event)
+    {
+      const CrIonSpecies& ions = CrIonSpecies::instance();
+      long slice = long(floor((event.time-m_start)/m_step));
+      if (slice < 0 || slice >= long(m_counts.size())){ m_unknown++; return; }
+      for (unsigned int i = 0; i < ions.size(); i++){
+        if (std::strcmp(event.particle, ions[i].name) == 0){
+          m_counts[slice][i]++;
+          return;
+        }
+      }
+      m_unknown++;
+    }
+
+    const std::vector<long>& counts(long slice) const { return m_counts[slice]; }
+    long unknown() const { return m_unknown; }
+
+  private:
+    double m_start, m_step;
+    long m_unknown;
+    std::vector<std::vector<long> > m_counts;
+  };
+
+  // Gives back the number of species seen and the chi-square of their
+  // counts against the abundances
+  int chi2(const std::vector<long>& counts, long& events, double& value)
+  {
+    const CrIonSpecies& ions = CrIonSpecies::instance();
+    double total = 0;
+    int seen = 0;
+    events = 0;
+    for (unsigned int i = 0; i < ions.size(); i++){
+      total += ions[i].abundance;
+      events += counts[i];
+      if (counts[i] > 0){ seen++; }
+    }
+    value = 0;
+    for (unsigned int i = 0; i < ions.size() && events > 0; i++){
+      double expected = events*ions[i].abundance/total;
+      value += (counts[i]-expected)*(counts[i]-expected)/expected;
+    }
+    return seen;
+  }
+
+  // Gives back the value the chi-square of dof degrees of freedom
+  // exceeds with probability 1e-4 (Wilson-Hilferty)
+  double chi2Limit(int dof)
+  {
+    const double z = 3.719; // 1e-4 tail of the normal distribution
+    double v = 2./(9.*dof);
+    return dof*pow(1.-v+z*sqrt(v), 3);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::string source = argc > 1 ? argv[1] : "CrHeavyIon";
+  long perSlice = argc > 2 ? std::atol(argv[2]) : 20000;
+  long nSlice = argc > 3 ? std::atol(argv[3]) : 10;
+  int nThread = argc > 4 ? std::atoi(argv[4]) : 1;
+  if (perSlice < 1 || nSlice < 1){
+    std::cerr << "ion_species_check: no particles" << std::endl;
+    return 1;
+  }
+
+  CrSourceFactory factory(source);
+  if (!factory.valid()){
+    std::cerr << "ion_species_check: unknown source " << source << std::endl;
+    return 1;
+  }
+  CrCircularOrbit orbit;
+
+  CrParallelGenerator::Settings settings;
+  settings.step = 300.;
+  settings.stopTime = settings.startTime + nSlice*settings.step;
+  settings.events = perSlice*nSlice;
+  settings.threads = nThread;
+  CrParallelGenerator generator(factory, orbit);
+  SpeciesOutput output(settings.startTime, settings.step, nSlice);
+  if (!generator.run(settings, output)){
+    std::cerr << "ion_species_check: no flux" << std::endl;
+    return 1;
+  }
+
+  const CrIonSpecies& ions = CrIonSpecies::instance();
+  const double limit = chi2Limit(ions.size()-1);
+
+  std::cout << "# " << source << ", chi2 limit " << limit << std::endl;
+  std::cout << "# slice\tevents\tspecies\tchi2" << std::endl;
+  bool good = output.unknown() == 0;
+  for (long k = 0; k < nSlice; k++){
+    long events;
+    double value;
+    int seen = chi2(output.counts(k), events, value);
+    good = good && events > 0 && value < limit;
+    std::cout << k << "\t" << events << "\t" << seen << "\t" << value << std::endl;
+  }
+
+  // one block of the primary heavy ions at the start of the orbit,
+  // through the mixture of the components as in CrHeavyIon
+  {
+    double latitude, longitude, altitude;
+    orbit.position(settings.startTime, latitude, longitude, altitude);
+    CrFixedPosition position;
+    position.setPosition(latitude, longitude, altitude, settings.startTime);
+    CrPositionProvider* previous = CrPositionProvider::current();
+    CrPositionProvider::setCurrent(&position);
+    CrHeavyIonPrimary primary;
+    CrPositionProvider::setCurrent(previous);
+    CrComponentMix mix;
+    mix.setComponents(std::vector<CrSpectrum*>(1, &primary), false);
+
+    CrPhiloxEngine engine(settings.seed);
+    std::vector<double> energy(perSlice), cosTheta(perSlice), phi(perSlice);
+    std::vector<unsigned int> ion(perSlice);
+    mix.sampleBlock(&engine, perSlice, &energy[0], &cosTheta[0], &phi[0], 0, &ion[0]);
+    std::vector<long> counts(ions.size(), 0);
+    for (long i = 0; i < perSlice; i++){
+      if (ion[i] < ions.size()){ counts[ion[i]]++; }
+      else { good = false; }
+    }
+    long events;
+    double value;
+    int seen = chi2(counts, events, value);
+    good = good && value < limit;
+    std::cout << "block\t" << events << "\t" << seen << "\t" << value << std::endl;
+  }
+  if (output.unknown() > 0){
+    std::cerr << "ion_species_check: " << output.unknown()
+              << " particles are not heavy ions" << std::endl;
+  }
+  if (!good){
+    std::cerr << "ion_species_check: the species do not follow the abundances" << std::endl;
+  }
+  return good ? 0 : 1;
+}
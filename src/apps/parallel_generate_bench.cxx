@@ -0,0 +1,110 @@
+/**
+ * parallel_generate_bench:
+ *  Times CrParallelGenerator with 1, 2, 4, ... threads and checks that
+ *  the particles do not depend on the number of threads.
+ *
+ *  usage: parallel_generate_bench [source [events [max threads]]]
+ *
+ *  The source is given as to crflux_generate (default CrProton); one
+ *  day of the default orbit is generated with the default seed.  The
+ *  number of threads goes up to max threads (default: the number of
+ *  cores).  One line per number of threads:
+ *    threads events/s speedup efficiency steals checksum
+ *  with the speedup over one thread and the efficiency speedup/threads.
+ *  The program gives back 1 if the checksums differ.
+ */
+
+//$Header$
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../CrParallelGenerator.hh"
+#include "../CrSourceFactory.hh"
+#include "../CrTrajectory.hh"
+
+namespace {
+  // FNV-1a hash of the particles, in the order they are written
+  class ChecksumOutput : public CrParallelGenerator::Output {
+  public:
+    ChecksumOutput() : m_hash(14695981039346656037ULL) {}
+
+    void write(const CrParallelGenerator::Event& event)
+    {
+      add(&event.time, sizeof(event.time));
+      add(&event.component, sizeof(event.component));
+      add(event.particle, std::strlen(event.particle));
+      add(&event.energy, sizeof(event.energy));
+      add(&event.cosTheta, sizeof(event.cosTheta));
+      add(&event.phi, sizeof(event.phi));
+    }
+
+    unsigned long long hash() const { return m_hash; }
+
+  private:
+    void add(const void* data, std::size_t size)
+    {
+      const unsigned char* bytes = static_cast<const unsigned char*>(data);
+      for (std::size_t i = 0; i < size; i++){
+        m_hash = (m_hash ^ bytes[i]) * 1099511628211ULL;
+      }
+    }
+
+    unsigned long long m_hash;
+  };
+}
+
+int main(int argc, char** argv)
+{
+  std::string source = argc > 1 ? argv[1] : "CrProton";
+  long nEvent = argc > 2 ? std::atol(argv[2]) : 200000;
+  int maxThread = argc > 3 ? std::atoi(argv[3]) : int(std::thread::hardware_concurrency());
+  if (maxThread < 1){ maxThread = 1; }
+
+  CrSourceFactory factory(source);
+  if (!factory.valid()){
+    std::cerr << "parallel_generate_bench: unknown source " << source << std::endl;
+    return 1;
+  }
+  CrCircularOrbit orbit;
+
+  std::cout << "# " << source << " " << nEvent << " particles" << std::endl;
+  std::cout << "# threads\tevents/s\tspeedup\tefficiency\tsteals\tchecksum" << std::endl;
+  double reference = 0;
+  unsigned long long checksum = 0;
+  bool same = true;
+  for (int nThread = 1; ; nThread *= 2){
+    if (nThread > maxThread){ nThread = maxThread; }
+    CrParallelGenerator::Settings settings;
+    settings.events = nEvent;
+    settings.threads = nThread;
+    CrParallelGenerator generator(factory, orbit);
+    ChecksumOutput output;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!generator.run(settings, output)){
+      std::cerr << "parallel_generate_bench: no flux" << std::endl;
+      return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+    double rate = nEvent/seconds;
+    if (nThread == 1){ reference = rate; checksum = output.hash(); }
+    same = same && output.hash() == checksum;
+    std::cout << nThread << "\t" << std::setprecision(4) << rate << "\t"
+              << rate/reference << "\t" << rate/reference/nThread << "\t"
+              << generator.steals() << "\t"
+              << std::hex << output.hash() << std::dec << std::endl;
+    if (nThread == maxThread){ break; }
+  }
+  if (!same){
+    std::cerr << "parallel_generate_bench: the particles depend on the number of threads"
+              << std::endl;
+  }
+  return same ? 0 : 1;
+}
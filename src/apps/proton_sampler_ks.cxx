@@ -0,0 +1,126 @@
+/**
+ * proton_sampler_ks:
+ *  Compares the energies of the primary protons drawn from the table
+ *  of CrProtonPrimary (sampler mode inverseCDF) with those of the
+ *  accept/reject loop (mode rejection) by two-sample Kolmogorov-Smirnov
+ *  tests.
+ *
+ *  usage: proton_sampler_ks [samples]
+ *
+ *  The table is made where the bin of (cor, phi) is entered and kept
+ *  inside the bin, so for each cutoff and solar potential the test is
+ *  made with the loop at the point where the table was made ("entry")
+ *  and at the far corner of the bin ("corner": cor 0.5% higher and phi
+ *  10 MV higher, the most the table lags behind).  One line per test:
+ *    cor phi point D p-value
+ *  A test fails when p < 0.001; the program gives back the number
+ *  of failed tests.
+ */
+
+//$Header$
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include <CLHEP/Random/JamesRandom.h>
+
+#include "../CrPositionProvider.hh"
+#include "../CrProtonPrimary.hh"
+
+namespace {
+  // Gives back the statistic D of two samples, which are sorted
+  double distance(std::vector<double>& a, std::vector<double>& b)
+  {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    double d = 0;
+    unsigned int i = 0, j = 0;
+    while (i < a.size() && j < b.size()){
+      double x = std::min(a[i], b[j]);
+      while (i < a.size() && a[i] <= x){ i++; }
+      while (j < b.size() && b[j] <= x){ j++; }
+      d = std::max(d, std::fabs(double(i)/a.size() - double(j)/b.size()));
+    }
+    return d;
+  }
+
+  // Gives back the asymptotic probability of a distance above d
+  double pValue(double d, unsigned int n, unsigned int m)
+  {
+    double ne = double(n)*m/(n+m);
+    double lambda = (sqrt(ne)+0.12+0.11/sqrt(ne))*d;
+    double p = 0;
+    for (int k = 1; k <= 100; k++){
+      double term = 2*((k%2) ? 1 : -1)*exp(-2*k*k*lambda*lambda);
+      p += term;
+      if (std::fabs(term) < 1e-12){ break; }
+    }
+    return p<0 ? 0 : p>1 ? 1 : p;
+  }
+
+  // Gives back n energies of the proton in its current mode
+  std::vector<double> energies(const CrProtonPrimary& proton, unsigned int n,
+                               CLHEP::HepRandomEngine* engine)
+  {
+    std::vector<double> e(n);
+    for (unsigned int i = 0; i < n; i++){ e[i] = proton.energySrc(engine); }
+    return e;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  unsigned int nSample = argc>1 ? std::atoi(argv[1]) : 200000;
+
+  CrFixedPosition position(0., 0., 565., 2.4e8);
+  CrPositionProvider::setCurrent(&position);
+
+  // just above the lower edge of a bin of 0.005 in log(cor) and 10 MV
+  const double cors[] = { exp(0.005*81+1e-6), exp(0.005*322+1e-6), exp(0.005*528+1e-6) };
+  const double phis[] = { 540.001, 1080.001 };
+  const double corCorner = exp(0.005*(1-2e-6)), phiCorner = 10.*(1-2e-6);
+
+  CLHEP::HepJamesRandom engine(12345);
+  int failed = 0;
+  double secondsTable = 0, secondsRejection = 0;
+
+  std::cout << "#cor\tphi\tpoint\tD\tp" << std::endl;
+  for (unsigned int c = 0; c < 3; c++){
+    for (unsigned int f = 0; f < 2; f++){
+      for (int corner = 0; corner < 2; corner++){
+        CrProtonPrimary proton;
+        proton.setSamplerMode(CrProtonPrimary::inverseCDF);
+        proton.setSolarWindPotential(phis[f]);
+        proton.setCutOffRigidity(cors[c]);
+        if (corner){
+          // inside the same bin: the table stays as it was made
+          proton.setSolarWindPotential(phis[f]+phiCorner);
+          proton.setCutOffRigidity(cors[c]*corCorner);
+        }
+
+        std::clock_t start = std::clock();
+        std::vector<double> table = energies(proton, nSample, &engine);
+        secondsTable += double(std::clock()-start)/CLOCKS_PER_SEC;
+        proton.setSamplerMode(CrProtonPrimary::rejection);
+        start = std::clock();
+        std::vector<double> rejection = energies(proton, nSample, &engine);
+        secondsRejection += double(std::clock()-start)/CLOCKS_PER_SEC;
+
+        double d = distance(table, rejection);
+        double p = pValue(d, table.size(), rejection.size());
+        std::cout << cors[c] << "\t" << phis[f] << "\t"
+                  << (corner ? "corner" : "entry") << "\t" << d << "\t" << p << std::endl;
+        if (p < 0.001){ failed++; }
+      }
+    }
+  }
+
+  std::cerr << "proton_sampler_ks: " << failed << " failed tests; time per energy "
+            << secondsTable/(12.*nSample)*1e9 << " ns (table), "
+            << secondsRejection/(12.*nSample)*1e9 << " ns (rejection)" << std::endl;
+  return failed;
+}
@@ -0,0 +1,52 @@
+/**
+ * psb97_convert:
+ *  Writes the binary flux maps used by the PSB97 trapped proton model
+ *  (see psb97/PSB97_model.h) from the xml files.
+ *
+ *  usage: psb97_convert [xml directory [binary directory]]
+ *         psb97_convert file.xml [file.bin]
+ *
+ *  The default directory is $(CRFLUXXMLPATH)/psb97.  The binary files
+ *  are put next to the xml files unless another directory is given;
+ *  PSB97Model looks for them next to the xml files.
+ */
+
+//$Header$
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../psb97/PSB97_model.h"
+
+using TrappedParticleModels::PSB97Model;
+
+int main(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1, argv+argc);
+
+  // a single file
+  if (!args.empty() && args[0].size()>4 
+      && args[0].substr(args[0].size()-4)==".xml"){
+    std::string binfile = args.size()>1 ? args[1] : PSB97Model::binaryName(args[0]);
+    if (!PSB97Model::convert(args[0], binfile)) return 1;
+    std::cout << args[0] << " -> " << binfile << std::endl;
+    return 0;
+  }
+
+  // the flux maps of a directory
+  std::string xmldir = args.empty() ? "$(CRFLUXXMLPATH)/psb97" : args[0];
+  std::string bindir = args.size()>1 ? args[1] : xmldir;
+  std::vector<std::string> names = PSB97Model::tableNames();
+  int status = 0;
+  for (unsigned int i = 0; i < names.size(); i++){
+    std::string xmlfile = xmldir+"/"+names[i];
+    std::string binfile = PSB97Model::binaryName(bindir+"/"+names[i]);
+    if (PSB97Model::convert(xmlfile, binfile)){
+      std::cout << xmlfile << " -> " << binfile << std::endl;
+    } else {
+      status = 1;
+    }
+  }
+  return status;
+}
@@ -0,0 +1,218 @@
+/**
+ * spectrum_bench:
+ *  Times energySrc() and dir() of every CRflux component and counts
+ *  the random numbers they draw, at a few working points of
+ *  (position, cutoff rigidity, solar potential).
+ *
+ *  usage: spectrum_bench [samples [psb97 xml directory]]
+ *
+ *  The trapped protons are included when the directory of the PSB97
+ *  tables is given.  One tab separated line per component and working
+ *  point is written to the standard output, after a header line that
+ *  starts with '#':
+ *    component latitude longitude cor phi geomagneticLatitude rate
+ *    ns_energy ns_dir draws_energy draws_dir
+ *  with the class name of the component, the rate flux()*solidAngle()
+ *  [c/s/m^2], the times in ns per particle and the random numbers
+ *  per particle.  Built with -DCRFLUX_SAMPLING_COUNTERS, the counters
+ *  of the rejection loops are printed to the standard error at the end.
+ *  The warnings of the components go to the standard error as well.
+ *
+ *  At the end the flux is asked samples times per component at a fixed
+ *  position, as FluxSvc asks it for every event, and once after a
+ *  position change; the program fails unless CrSpectrum::cachedFlux()
+ *  evaluates flux() never in the former and once in the latter.
+ */
+
+//$Header$
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <CLHEP/Random/JamesRandom.h>
+
+#include "../CrPositionProvider.hh"
+#include "../CrSamplingCounters.hh"
+#include "../CrDiagnostics.hh"
+#include "../CrSpectrum.hh"
+#include "../CrProtonPrimary.hh"
+#include "../CrProtonReentrant.hh"
+#include "../CrProtonSplash.hh"
+#include "../CrAlphaPrimary.hh"
+#include "../CrElectronPrimary.hh"
+#include "../CrElectronReentrant.hh"
+#include "../CrElectronSplash.hh"
+#include "../CrPositronPrimary.hh"
+#include "../CrPositronReentrant.hh"
+#include "../CrPositronSplash.hh"
+#include "../CrGammaPrimary.hh"
+#include "../CrGammaSecondaryDownward.hh"
+#include "../CrGammaSecondaryUpward.hh"
+#include "../CrNeutronSplash.hh"
+#include "../CrHeavyIonPrimary.hh"
+#include "../CrHeavyIonPrimaryZ.hh"
+#include "../CrHeavyIonPrimaryVertical.hh"
+#include "../CrTrappedParticle.hh"
+
+namespace {
+  // HepJamesRandom which counts the random numbers drawn
+  class CountingEngine : public CLHEP::HepJamesRandom {
+  public:
+    explicit CountingEngine(long seed) : CLHEP::HepJamesRandom(seed), m_draws(0) {}
+    double flat(){ m_draws++; return CLHEP::HepJamesRandom::flat(); }
+    void flatArray(const int size, double* vect){
+      m_draws += size;
+      CLHEP::HepJamesRandom::flatArray(size, vect);
+    }
+    unsigned long draws() const { return m_draws; }
+  private:
+    unsigned long m_draws;
+  };
+
+  // working point: geographic position [deg], cutoff rigidity [GV]
+  // and solar modulation potential [MV]
+  struct Point {
+    double latitude, longitude, cor, phi;
+  };
+
+  const Point points[] = {
+    {  0.0,   0.0, 14.0,  500.},  // equator, solar minimum
+    { 20.0, -90.0,  8.0,  700.},
+    { 25.6,  30.0,  4.5,  900.},
+    {-25.6, -45.0,  2.0, 1100.}   // SAA, solar maximum
+  };
+
+  void add(std::vector<CrSpectrum*>& components, std::vector<std::string>& names,
+           CrSpectrum* component, const char* name)
+  {
+    components.push_back(component);
+    names.push_back(name);
+  }
+
+  double nsPerCall(std::clock_t start, unsigned int n)
+  {
+    return double(std::clock()-start)/CLOCKS_PER_SEC/n*1e9;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  unsigned int nSample = argc>1 ? std::atoi(argv[1]) : 100000;
+  std::string psb97dir = argc>2 ? argv[2] : "";
+  if (nSample == 0){ nSample = 1; }
+  CrDiagnostics::setStream(&std::cerr);
+
+  CrFixedPosition position(points[0].latitude, points[0].longitude, 565., 2.4e8);
+  CrPositionProvider::setCurrent(&position);
+
+  // by class name, as some components share a title
+  std::vector<CrSpectrum*> components;
+  std::vector<std::string> names;
+  add(components, names, new CrProtonPrimary, "CrProtonPrimary");
+  add(components, names, new CrProtonReentrant, "CrProtonReentrant");
+  add(components, names, new CrProtonSplash, "CrProtonSplash");
+  add(components, names, new CrAlphaPrimary, "CrAlphaPrimary");
+  add(components, names, new CrElectronPrimary, "CrElectronPrimary");
+  add(components, names, new CrElectronReentrant, "CrElectronReentrant");
+  add(components, names, new CrElectronSplash, "CrElectronSplash");
+  add(components, names, new CrPositronPrimary, "CrPositronPrimary");
+  add(components, names, new CrPositronReentrant, "CrPositronReentrant");
+  add(components, names, new CrPositronSplash, "CrPositronSplash");
+  add(components, names, new CrGammaPrimary, "CrGammaPrimary");
+  add(components, names, new CrGammaSecondaryDownward, "CrGammaSecondaryDownward");
+  add(components, names, new CrGammaSecondaryUpward, "CrGammaSecondaryUpward");
+  add(components, names, new CrNeutronSplash, "CrNeutronSplash");
+  add(components, names, new CrHeavyIonPrimary, "CrHeavyIonPrimary");
+  add(components, names, new CrHeavyIonPrimaryZ(26), "CrHeavyIonPrimaryZ(26)");
+  add(components, names, new CrHeavyIonPrimaryVertical, "CrHeavyIonPrimaryVertical");
+  if (!psb97dir.empty()){
+    add(components, names, new CrTrappedProton("8,psb97,"+psb97dir), "CrTrappedProton");
+  }
+
+  CountingEngine engine(12345);
+  std::vector<double> energy(nSample);
+
+  std::cout << "#component\tlatitude\tlongitude\tcor\tphi\tgeomagneticLatitude\trate"
+            << "\tns_energy\tns_dir\tdraws_energy\tdraws_dir" << std::endl;
+  for (unsigned int p = 0; p < sizeof(points)/sizeof(points[0]); p++){
+    const Point& point = points[p];
+    position.setPosition(point.latitude, point.longitude, 565., 2.4e8);
+
+    for (unsigned int k = 0; k < components.size(); k++){
+      CrSpectrum* component = components[k];
+      component->setCutOffRigidity(point.cor);
+      component->setSolarWindPotential(point.phi);
+      // FluxSvc asks the rate before it samples; CrHeavyIonPrimary
+      // selects its ion in solidAngle()
+      double rate = component->cachedFlux()*component->solidAngle();
+
+      unsigned long draws = engine.draws();
+      std::clock_t start = std::clock();
+      for (unsigned int i = 0; i < nSample; i++){
+        energy[i] = component->energySrc(&engine);
+      }
+      double nsEnergy = nsPerCall(start, nSample);
+      double drawsEnergy = double(engine.draws()-draws)/nSample;
+
+      draws = engine.draws();
+      double sum = 0;
+      start = std::clock();
+      for (unsigned int i = 0; i < nSample; i++){
+        sum += component->dir(energy[i], &engine).first;
+      }
+      double nsDir = nsPerCall(start, nSample);
+      double drawsDir = double(engine.draws()-draws)/nSample;
+
+      std::cout << names[k] << "\t" << point.latitude << "\t" << point.longitude
+                << "\t" << point.cor << "\t" << point.phi
+                << "\t" << component->geomagneticLatitude() << "\t" << rate
+                << "\t" << nsEnergy << "\t" << nsDir
+                << "\t" << drawsEnergy << "\t" << drawsDir << std::endl;
+      if (sum != sum){ std::cerr << names[k] << ": invalid direction" << std::endl; }
+    }
+  }
+
+  // the flux of the steady state events, then after a position change
+  int status = 0;
+  unsigned long steady = 0, moved = 0;
+  std::vector<unsigned long> evaluations(components.size());
+  for (unsigned int k = 0; k < components.size(); k++){
+    evaluations[k] = components[k]->fluxEvaluations();
+    double sum = 0;
+    for (unsigned int i = 0; i < nSample; i++){ sum += components[k]->cachedFlux(); }
+    unsigned long n = components[k]->fluxEvaluations() - evaluations[k];
+    if (n != 0 || sum != sum){
+      std::cerr << names[k] << ": " << n << " flux evaluations at a fixed position" << std::endl;
+      status = 1;
+    }
+    steady += n;
+  }
+  position.setPosition(points[0].latitude, points[0].longitude, 565., 2.4e8);
+  for (unsigned int k = 0; k < components.size(); k++){
+    evaluations[k] = components[k]->fluxEvaluations();
+    for (unsigned int i = 0; i < nSample; i++){ components[k]->cachedFlux(); }
+    unsigned long n = components[k]->fluxEvaluations() - evaluations[k];
+    if (n != 1){
+      std::cerr << names[k] << ": " << n << " flux evaluations after a position change" << std::endl;
+      status = 1;
+    }
+    moved += n;
+  }
+  std::cerr << "flux evaluations in " << nSample << " events per component: "
+            << steady << " at a fixed position, " << moved
+            << " after a position change" << std::endl;
+
+  // efficiencies of the rejection loops, with -DCRFLUX_SAMPLING_COUNTERS
+  if (CrSamplingCounters::enabled()){
+    CrSamplingCounters::print(std::cerr);
+  }
+  CrDiagnostics::summary(std::cerr);
+
+  for (unsigned int k = 0; k < components.size(); k++){
+    delete components[k];
+  }
+  return status;
+}
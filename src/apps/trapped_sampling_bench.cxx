@@ -0,0 +1,122 @@
+/**
+ * trapped_sampling_bench:
+ *  Times the sampling of trapped proton energies from PSB97 spectra,
+ *  with the std::map search CrTrappedParticle used before and with the
+ *  flat table and guide index of CrTrappedSpectrumCache::Spectrum, and
+ *  checks that both give the same energies.
+ *
+ *  usage: trapped_sampling_bench [xml directory [samples]]
+ *
+ *  The default directory is $(CRFLUXXMLPATH)/psb97.
+ */
+
+//$Header$
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../psb97/PSB97_model.h"
+#include "../CrTrappedSpectrumCache.hh"
+
+using TrappedParticleModels::PSB97Model;
+
+namespace {
+  // spectrum as in CrTrappedParticle::psb97UpdateSpectrum: 8 to 1000 MeV in 2 MeV
+  bool makeSpectrum(const PSB97Model& psb97, float ll, float bb,
+                    std::map<double,double>& intSpectrum,
+                    CrTrappedSpectrumCache::Spectrum& spectrum)
+  {
+    const double minE = 8., maxE = 1000., stepE = 2.;
+    std::vector<float> ee(1, minE);
+    for (double e = minE+stepE; e <= maxE; e += stepE) ee.push_back(e);
+    std::vector<float> integral(ee.size());
+    psb97(ll, bb, &ee[0], &integral[0], ee.size());
+    if (!(integral[0] > 0)) return false;
+
+    double maxNonzeroFluxEnergy = 0;
+    intSpectrum.clear();
+    intSpectrum[0.] = minE;
+    for (unsigned int i = 1; i < ee.size(); i++){
+      float fluxval = 1. - integral[i]/integral[0];
+      if (fluxval < 0.999999){
+        maxNonzeroFluxEnergy = ee[i];
+        intSpectrum[fluxval] = ee[i];
+      }
+    }
+    intSpectrum[1.] = maxNonzeroFluxEnergy+stepE;
+
+    spectrum.random.clear();
+    spectrum.energy.clear();
+    std::map<double,double>::const_iterator it;
+    for (it = intSpectrum.begin(); it != intSpectrum.end(); ++it){
+      spectrum.random.push_back(it->first);
+      spectrum.energy.push_back(it->second);
+    }
+    spectrum.buildGuide();
+    return true;
+  }
+
+  // the search of the std::map which CrTrappedParticle::energyFromRandom did
+  double sampleMap(const std::map<double,double>& intSpectrum, double random)
+  {
+    std::map<double,double>::const_iterator it = intSpectrum.lower_bound(random);
+    if (it == intSpectrum.end() || it == intSpectrum.begin()) return 0;
+    double r2 = it->first, e2 = it->second;
+    --it;
+    double r1 = it->first, e1 = it->second;
+    return e1+(random-r1)*(e2-e1)/(r2-r1);
+  }
+
+  double seconds(std::clock_t start)
+  {
+    return double(std::clock()-start)/CLOCKS_PER_SEC;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::string xmldir = argc>1 ? argv[1] : "$(CRFLUXXMLPATH)/psb97";
+  unsigned int nSample = argc>2 ? std::atoi(argv[2]) : 10000000;
+  PSB97Model psb97(xmldir);
+
+  // (L,B) where the flux maps have trapped protons
+  const float points[][2] = {{1.15f, 1.05f}, {1.20f, 1.20f}, {1.30f, 1.50f}, {1.50f, 2.50f}};
+  std::vector<double> rnd(nSample);
+  std::srand(12345);
+  for (unsigned int i = 0; i < nSample; i++) rnd[i] = (std::rand()+0.5)/(RAND_MAX+1.);
+
+  int status = 0;
+  for (unsigned int p = 0; p < sizeof(points)/sizeof(points[0]); p++){
+    std::map<double,double> intSpectrum;
+    CrTrappedSpectrumCache::Spectrum spectrum;
+    if (!makeSpectrum(psb97, points[p][0], points[p][1], intSpectrum, spectrum)){
+      std::cout << "L=" << points[p][0] << " B=" << points[p][1] << ": no flux" << std::endl;
+      continue;
+    }
+
+    double sumMap = 0, sumTable = 0;
+    unsigned int differ = 0;
+    std::clock_t start = std::clock();
+    for (unsigned int i = 0; i < nSample; i++) sumMap += sampleMap(intSpectrum, rnd[i]);
+    double tMap = seconds(start);
+    start = std::clock();
+    for (unsigned int i = 0; i < nSample; i++) sumTable += spectrum.sample(rnd[i]);
+    double tTable = seconds(start);
+    for (unsigned int i = 0; i < nSample; i++){
+      if (sampleMap(intSpectrum, rnd[i]) != spectrum.sample(rnd[i])) differ++;
+    }
+    if (differ) status = 1;
+
+    std::cout << "L=" << points[p][0] << " B=" << points[p][1]
+              << " nodes=" << spectrum.random.size()
+              << "  map: " << (tMap>0 ? nSample/tMap*1e-6 : 0) << " M/s"
+              << "  table: " << (tTable>0 ? nSample/tTable*1e-6 : 0) << " M/s"
+              << "  mean energy " << sumMap/nSample << " / " << sumTable/nSample << " MeV"
+              << "  differences " << differ << std::endl;
+  }
+  return status;
+}
@@ -48,6 +48,173 @@ The following heavy ion sources are defined:
     CrHeavyIonVert26                 
 @endverbatum
 
+  The trapped proton flux maps of the PSB97 model (xml/psb97) are read
+  faster from binary files made with the psb97_convert program:
+@verbatum
+    psb97_convert [xml directory [binary directory]]
+@endverbatum
+  The binary files go next to the xml files; a binary file made from
+  another version of its xml file is ignored and the xml file is parsed.
+
+  The PSB97 spectra are kept for the (L,B) cells visited last.  The
+  cells, the memory limit and a printout of the hit rate are set after
+  the data directory in the source parameters:
+@verbatum
+    params="8,psb97,<dir>,dL=0.001,dB=0.0025,cacheMB=8,cacheStats=0"
+@endverbatum
+  (the defaults); dL=0 turns the cache off.
+
+  The splash and reentrant proton spectra, sorted in geomagnetic
+  latitude, are tables of CrLatitudeBinnedModel.  A new fit can be
+  given as a text file (format in CrLatitudeBinnedModel::read) with the
+  RegisterCRflux properties ProtonSplashTable and ProtonReentrantTable.
+  The splash and reentrant e- and e+ use the tables of
+  CrLeptonSecondaryModel.  Between two latitude bins a particle is taken
+  from one of them; with the property SecondaryBlended the energy and
+  zenith angle are sampled instead from inverse CDFs of the mixture of
+  both bins, made when the latitude changes, with one random number each.
+
+  The gamma and neutron components keep the integrals of their envelope
+  functions (CrEnvelopeIntegrals) and compute them again only when the
+  energy range is changed.  envelope_sampling_bench times the sampling
+  with the integrals computed per particle and kept.
+
+  FluxSvc asks the flux of a source for every event.  The sources and
+  the alias tables of their components (CrComponentMix) take it from
+  CrSpectrum::cachedFlux(), which calls flux() again only when the
+  epoch of the component has changed: the setters of position, time,
+  cutoff rigidity, solar potential, gamma energy range and
+  normalization start a new epoch.  CrSpectrum::fluxEvaluations()
+  counts the calls of flux(); spectrum_bench checks that events at a
+  fixed position make none.
+
+  The spectra are also built as the library CRfluxCore, which needs
+  neither Gaudi nor xerces.  The components follow the position of a
+  CrPositionProvider, the GPS of FluxSvc inside Gaudi; a program sets
+  its own (e.g. CrFixedPosition) with CrPositionProvider::setCurrent()
+  before it makes the components.  crflux_generate writes particles of
+  a source along an orbit to a text file:
+@verbatum
+    crflux_generate CrProton -n 100000 -time 2.4e8,2.401e8 -orbit 25.6,565 -o protons.txt
+@endverbatum
+
+  spectrum_bench times energySrc() and dir() of every component and
+  counts the random numbers per particle at a few working points of
+  position, cutoff rigidity and solar potential.  It writes one tab
+  separated line per component and point, to compare releases:
+@verbatum
+    spectrum_bench [samples [psb97 xml directory]] > bench.txt
+@endverbatum
+
+  The azimuth of the East-West effect (CrSpectrum::EW_dir) is drawn
+  from bounds tabulated once per species in CrEastWestTable, which
+  give the particles of the former accept/reject loop with less than
+  one rejection in ten; the property EastWestSampler of RegisterCRflux
+  set to "rejection" restores the loop.  ew_dir_ks compares both by
+  Kolmogorov-Smirnov tests:
+@verbatum
+    ew_dir_ks [samples]
+@endverbatum
+
+  The energies of the primary protons are likewise drawn by inverting
+  a table of the cumulative spectrum, made where the cutoff
+  rigidity and the solar potential enter a bin of 0.5% and 10 MV and
+  kept inside it; the property PrimarySampler set to "rejection"
+  restores the two-envelope loop.  proton_sampler_ks compares both,
+  also at the far corner of a bin:
+@verbatum
+    proton_sampler_ks [samples]
+@endverbatum
+
+  The sources draw from the global CLHEP engine, which RegisterCRflux
+  sets to that of FluxSvc; setEngine() gives a source another one.
+  CrPhiloxEngine is a counter-based engine (Philox4x32-10) whose
+  streams, CrPhiloxEngine(seed).stream(i), are reached without
+  drawing: a unit of work (a job, a segment of the orbit) with its own
+  stream gives the same particles on any thread.  The streams i of one
+  stream are distinct; the numbers of nested streams are 64-bit
+  hashes, independent with overwhelming probability (a collision
+  among a million streams has a probability of 3e-8).
+  The RegisterCRflux properties RandomSeed and RandomStream (e.g. the
+  job index, -1 for the engine of FluxSvc) and the option -stream of
+  crflux_generate select such a stream.
+
+  CrParallelGenerator makes the particles of a source (CrSourceFactory)
+  along a trajectory (CrTrajectory) with several threads.  Every thread
+  has its own components and CrFixedPosition; the orbit is cut into
+  slices, each drawing from its own stream, and the slices are written
+  in time order, so the output does not depend on the number of
+  threads.  The option -threads of crflux_generate uses it, and
+  parallel_generate_bench gives the speedup and checks the particles:
+@verbatum
+    parallel_generate_bench [source [events [max threads]]]
+@endverbatum
+  As FluxSvc, it asks the solid angle of a component before every
+  particle, where the heavy ions draw their species; ion_species_check
+  tests that the species of the particles of every slice follow the
+  abundances:
+@verbatum
+    ion_species_check [source [events per slice [slices [threads]]]]
+@endverbatum
+
+  The primary protons, alphas, electrons and positrons are
+  CrPrimaryComponent<Species>, where a traits class of compile-time
+  constants (e.g. CrProtonSpecies: rest energy, charge, spectral
+  normalization and index, cutoff exponent, upper energy) gives the
+  spectrum and the two-envelope sampler of CrPrimarySpectrum.  The
+  primary heavy ions, whose charge is drawn at run time, use the same
+  functions with the charge as an argument.  A new species is a traits
+  class.  The heavy ions, Li to Fe with their mass numbers and
+  abundances, are kept in CrIonSpecies, which draws one with an alias
+  table (CrAliasTable, as CrComponentMix does for the components);
+  the envelopes of the energy sampler of an ion (CrPrimarySampler)
+  are made at its first particle in a bin of cutoff rigidity and solar
+  potential and kept while these stay in the bin.  The block sampler of the heavy ions draws the ion of
+  every particle and makes the energies of each ion in one block;
+  CrHeavyIon::sampleBlock() gives back the index in CrIonSpecies of
+  the ion of each particle, through CrComponentMix and
+  CrSpectrum::sampleBlock().
+
+  The flux of the primaries (the spectrum integrated over energy) is
+  tabulated in cutoff rigidity and solar potential by quadrature of
+  the spectrum at the first flux() (CrFluxIntegralTable); the heavy
+  ions scale the table of the alphas.  The RegisterCRflux properties
+  FluxTableCutOffRigidities and FluxTableSolarPotentials give the
+  nodes (a table is made again when they change, with a warning), and
+  FluxTableCache a directory where the tables are kept, under a hash
+  of the spectrum and the nodes, for the next runs (the
+  option -fluxcache of crflux_generate).  RestrictRange=false lifts the
+  restriction of the cutoff rigidity to 0.5-14.9 GV and of the solar
+  potential to 500-1100 MV; outside the nodes the flux is then
+  integrated directly.
+
+  Compiled with -DCRFLUX_SAMPLING_COUNTERS, the rejection loops (the
+  energy loops of the primaries, CrSpectrum::EW_dir and the direction
+  of CrGammaSecondaryDownward) count their attempts, accepted particles
+  and random numbers in CrSamplingCounters.  CRfluxSvc prints them at
+  finalize and spectrum_bench at its end; without the flag the macros
+  are empty.
+
+  Warnings of conditions that repeat at every position update or
+  particle (a cutoff rigidity or solar potential out of the range of
+  the models, a latitude out of the table of CrCoordinateTransfer) are
+  counted per kind by CrDiagnostics and printed the first time, then at
+  10, 100, ... times.  The RegisterCRflux property WarningLimit sets the
+  number printed (-1 for all); CRfluxSvc prints the counts at finalize.
+
+  The block samplers (sampleBlock) of the primary gamma rays, the
+  secondary gamma rays, the neutron splash and the primary protons,
+  alphas, electrons and positrons compute their power laws for the
+  whole block with CrBatchMath, whose loops over lanes of 8 doubles
+  are compiled to SIMD instructions; with gcc on x86-64 Linux the
+  AVX-512, AVX2 or base version is chosen when the library is loaded.
+  The primaries test their candidates in blocks too.  batch_math_bench
+  gives the errors of the functions against their bounds and their
+  time against libm:
+@verbatum
+    batch_math_bench [samples]
+@endverbatum
+
   \section references References
     - Tsunefumi Mizuno et al.  (astro-ph/0406684)
     - GLAST-LAT Technical Note No. (LAT-TD-250.1) by T. Mizuno et al
@@ -2,8 +2,10 @@
 
 #include <iostream>
 #include <sstream>
+#include <fstream>
 #include <cmath>
 #include <cfloat>
+#include <cstring>
 #include <xmlBase/XmlParser.h>
 #include <xmlBase/Dom.h>
 
@@ -15,6 +17,12 @@
 
 #ifdef WIN32
 #define isnan(x) _isnan(x)
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 
@@ -24,26 +32,154 @@ namespace TrappedParticleModels {
 
     using namespace std;
 
+    namespace {
+       // Layout of the binary flux map files (native byte order):
+       //   char[8]  tag "PSB97BIN"
+       //   uint32   version (also tells the byte order)
+       //   uint32   header length, number of rows, number of values
+       //   uint64   checksum of the xml file the map was made from
+       //   float    header[header length]
+       //   uint32   offset[number of rows + 1]
+       //   float    value[number of values]
+       const char binaryTag[8] = {'P','S','B','9','7','B','I','N'};
+       const unsigned int binaryVersion = 1;
+       const size_t binaryHeaderSize = 32;
+    }
+
 
     PSB97Model::PSB97Model(const string &xmldir) {
-       m_Flux.push_back(new FluxTable(xmldir+"/psb97_20MeV_lbmap.xml"));
-       m_Flux.push_back(new FluxTable(xmldir+"/psb97_100MeV_lbmap.xml"));
-       m_Flux.push_back(new FluxTable(xmldir+"/psb97_200MeV_lbmap.xml"));
-       m_Flux.push_back(new FluxTable(xmldir+"/psb97_400MeV_lbmap.xml"));           
+       vector<string> names = tableNames();
+       for (unsigned int i=0; i<names.size(); i++) {
+          m_Flux.push_back(new FluxTable(xmldir+"/"+names[i]));
+       };
+       buildDense();
     };
-    
-    
-    PSB97Model::FluxTable::FluxTable(const string &xml_file){
-       using namespace xmlBase;
+
+
+    void PSB97Model::buildDense() {
+       m_Dense.clear();
+       m_denseL = m_denseB = 0;
+       if (m_Flux.size()<2) return;
+
+       // the batch evaluation keeps the maps of a cell on the stack
+       if (m_Flux.size()>maxDenseMaps) return;
+
+       const FluxTable* first = m_Flux.front();
+       unsigned int nrows = 0, ncols = 0;
+       for (unsigned int k=0; k<m_Flux.size(); k++) {
+          const FluxTable* t = m_Flux[k];
+          for (unsigned int h=1; h<7; h++) {
+             if (t->m_Header[h]!=first->m_Header[h]) return;
+          };
+          if (t->m_nRows>nrows) nrows = t->m_nRows;
+          for (unsigned int l=0; l<t->m_nRows; l++) {
+             unsigned int len = t->m_Offset[l+1]-t->m_Offset[l];
+             if (len>ncols) ncols = len;
+          };
+       };
+
+       unsigned int ne = m_Flux.size();
+       m_denseL = nrows+1;
+       m_denseB = ncols+1;
+       m_Dense.assign(size_t(m_denseL)*m_denseB*ne, 0.);
+       for (unsigned int k=0; k<ne; k++) {
+          const FluxTable* t = m_Flux[k];
+          for (unsigned int l=0; l<t->m_nRows; l++) {
+             unsigned int len = t->m_Offset[l+1]-t->m_Offset[l];
+             const float* row = t->m_Values+t->m_Offset[l];
+             for (unsigned int b=0; b<len; b++) {
+                m_Dense[(size_t(l)*m_denseB+b)*ne+k] = row[b];
+             };
+          };
+       };
+    };
+
+
+    PSB97Model::~PSB97Model() {
+       for (unsigned int i=0; i<m_Flux.size(); i++) delete m_Flux[i];
+    };
+
+
+    vector<string> PSB97Model::tableNames() {
+       vector<string> names;
+       names.push_back("psb97_20MeV_lbmap.xml");
+       names.push_back("psb97_100MeV_lbmap.xml");
+       names.push_back("psb97_200MeV_lbmap.xml");
+       names.push_back("psb97_400MeV_lbmap.xml");
+       return names;
+    };
+
+
+    string PSB97Model::binaryName(const string &xmlfile) {
+       string::size_type dot = xmlfile.rfind(".xml");
+       if (dot != string::npos && dot+4 == xmlfile.size()) return xmlfile.substr(0,dot)+".bin";
+       return xmlfile+".bin";
+    };
+
+
+    bool PSB97Model::fileChecksum(const string &file, unsigned long long &checksum) {
+       ifstream in(file.c_str(), ios::binary);
+       if (!in) return false;
+       unsigned long long hash = 14695981039346656037ULL;
+       char buffer[65536];
+       while (in) {
+          in.read(buffer, sizeof(buffer));
+          streamsize n = in.gcount();
+          for (streamsize i=0; i<n; i++) {
+             hash ^= (unsigned char) buffer[i];
+             hash *= 1099511628211ULL;
+          };
+       };
+       checksum = hash;
+       return true;
+    };
+
+
+    bool PSB97Model::convert(const string &xml_file, const string &binfile) {
+       string xmlfile(xml_file);
+       facilities::Util::expandEnvVar(&xmlfile,"$(",")");
+       unsigned long long checksum;
+       if (!fileChecksum(xmlfile, checksum)) {
+          std::cerr << "Cannot read psb97 model data xml file " << xmlfile << std::endl;
+          return false;
+       };
+       FluxTable table(xmlfile, false);
+       return table.writeBinary(binfile, checksum);
+    };
+
+
+    PSB97Model::FluxTable::FluxTable(const string &xml_file, bool useBinary)
+       : m_Header(0), m_headerLen(0), m_Offset(0), m_nRows(0), m_Values(0), m_nValues(0),
+         m_map(0), m_mapSize(0)
+    {
        using namespace facilities;
-       
-       vector<string> tokens;        
-       vector<string> data_tokens;        
 
-       m_Header.resize(8);
-       
        string xmlfile(xml_file);
        Util::expandEnvVar(&xmlfile,"$(",")");
+
+       if (useBinary) {
+          // a binary file is used if it was made from this xml file,
+          // or on its own if the xml file is not there
+          unsigned long long checksum;
+          bool haveXml = PSB97Model::fileChecksum(xmlfile, checksum);
+          if (mapBinary(binaryName(xmlfile), haveXml ? &checksum : 0)) return;
+       };
+
+       if (!readXml(xmlfile)) {
+          std::cerr << "An error occurred during parsing psb97 model data xml file "<<xmlfile<<std::endl;
+          exit(1);
+       };
+    };
+
+
+    bool PSB97Model::FluxTable::readXml(const string &xmlfile){
+       using namespace xmlBase;
+       struct ParseError {};
+
+       vector<string> tokens;        
+       vector<string> data_tokens;        
+
+       m_headerData.resize(8);
        
        try {
 	    XmlParser *parser = new XmlParser;
@@ -55,7 +191,7 @@ namespace TrappedParticleModels {
 	    
         if(string(XMLString::transcode(xmlRootElement->getTagName()))!="PSB97ModelData"){
  	       std::cerr << "Could not find root element PSB97ModelData " <<XMLString::transcode(xmlRootElement->getTagName())<<std::endl;
-	       throw ;
+	       throw ParseError();
 	    };
 	    
 //	    std::cout<<"Trying to find tags in "<<xmlfile<<std::endl;
@@ -66,7 +202,7 @@ namespace TrappedParticleModels {
 //	    std::cout<<"Checking number of tags. "<<headerList->getLength()<<" "<<indexList->getLength()<<" "<<dataList->getLength()<<std::endl;
 	    if(headerList->getLength()!=1 || indexList->getLength()!=1 || dataList->getLength()!=1){
 	       std::cerr << "XML file must contain exactly one header, index and data element." << std::endl;
-	       throw ;	    
+	       throw ParseError();	    
 	    } 
        
 //	    std::cout<<"Extracting elements. "<<std::endl;
@@ -82,7 +218,7 @@ namespace TrappedParticleModels {
 		if(dataNode->getNodeType()==DOMNode::ELEMENT_NODE) data = static_cast<DOMElement*>(dataNode);
 		if(!header || !index || !data) {
 	       std::cerr << "Error parsing header. Node type wrong." << std::endl;
-		   throw;
+		   throw ParseError();
 		};
 		unsigned int header_len = Dom::getIntAttribute(header,"len");
 	    unsigned int index_len  = Dom::getIntAttribute(index,"len");
@@ -97,49 +233,48 @@ namespace TrappedParticleModels {
 
 //	    std::cout<<"Filling header. "<<std::endl;
 
-	    vector<float>::iterator h_it=m_Header.begin();
-	    m_Header.resize(header_len);
+	    m_headerData.resize(header_len);
+	    vector<float>::iterator h_it=m_headerData.begin();
 	    for (unsigned int i=0;i<header_len;i++,h_it++) {
-	      if (header_stream.eof()) throw;
+	      if (header_stream.eof()) throw ParseError();
 	      header_stream>> *h_it;
 //	      std::cout<< *h_it <<endl ;	      
 	    };
+	    if (header_len<7) throw ParseError();
 	    
         stringstream index_stream(index_string);
 	    stringstream data_stream(data_string);	        
 	    
 //	    std::cout<<"Filling data. "<<std::endl;
 
-	    m_Data.resize(index_len);
-	    vector< vector<float> >::iterator  d_it=m_Data.begin();
+	    m_offsetData.resize(index_len+1);
+	    m_valueData.resize(data_len);
+	    m_offsetData[0]=0;
 
 		unsigned int data_size=0;
         unsigned int index1,index2;
 
         index_stream>>index1;
-	    for (unsigned int i=0;i<index_len; i++,d_it++)  {
-	       vector<float>& data_vector = *d_it;
-	       if (index_stream.eof()) throw;
-	       if (data_stream.eof()) throw;
-	       
-	       index_stream>>index2;
+	    for (unsigned int i=0;i<index_len; i++)  {
+	       // the index holds the start of each row: the last row is empty
+	       if (!(index_stream>>index2)) index2=index1;
+	       if (index2<index1) throw ParseError();
 	       unsigned int length = index2 - index1;
-	       
-	       data_vector.resize(length);
-	       vector<float>::iterator dv_it = data_vector.begin();
+	       if (data_size+length>data_len) throw ParseError();
 
 //	       std::cout<<"  --> adding vector with length l="<<length<<" "<<index1<<" "<<index2<<std::endl; 
 
-	       for (unsigned int j=0; j<length; j++,dv_it++) {
-              data_stream >> *dv_it ; 	
+	       for (unsigned int j=0; j<length; j++) {
+              if (!(data_stream >> m_valueData[data_size])) throw ParseError();
 		      data_size++;
 	        };
+	       m_offsetData[i+1]=data_size;
             index1=index2; 	   
 	    };    
 	    
         if(data_size!=data_len) {
           std::cerr<<"Data length wrong in XML file. "<<data_size<<" <--> "<<data_len<<std::endl;
-          throw;
+          throw ParseError();
         };
 	    
 	    tokens.clear(); tokens.resize(1);
@@ -150,18 +285,188 @@ namespace TrappedParticleModels {
         delete parser;
        
       } catch(...) {     
-        std::cerr << "An error occurred during parsing psb97 model data xml file "<<xmlfile<<std::endl;
-        exit(1);
+        return false;
       };
- 
+
+      m_Header = &m_headerData[0];
+      m_headerLen = m_headerData.size();
+      m_Offset = &m_offsetData[0];
+      m_nRows = m_offsetData.size()-1;
+      m_Values = m_valueData.empty() ? 0 : &m_valueData[0];
+      m_nValues = m_valueData.size();
+      return true;
    };   
- 
+
+
+    bool PSB97Model::FluxTable::mapBinary(const string &binfile, const unsigned long long* checksum) {
+       const char* base = 0;
+       size_t size = 0;
+
+#ifndef WIN32
+       int fd = open(binfile.c_str(), O_RDONLY);
+       if (fd<0) return false;
+       struct stat st;
+       if (fstat(fd,&st)!=0 || st.st_size<(off_t)binaryHeaderSize) { close(fd); return false; };
+       size = st.st_size;
+       void* map = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+       close(fd);
+       if (map==MAP_FAILED) return false;
+       m_map = map;
+       m_mapSize = size;
+       base = static_cast<const char*>(map);
+#else
+       ifstream in(binfile.c_str(), ios::binary);
+       if (!in) return false;
+       in.seekg(0, ios::end);
+       size = in.tellg();
+       in.seekg(0, ios::beg);
+       if (size<binaryHeaderSize) return false;
+       m_fileData.resize((size+sizeof(float)-1)/sizeof(float));
+       in.read(reinterpret_cast<char*>(&m_fileData[0]), size);
+       if (!in) { m_fileData.clear(); return false; };
+       base = reinterpret_cast<const char*>(&m_fileData[0]);
+#endif
+
+       unsigned int counts[4];
+       unsigned long long sourceChecksum;
+       memcpy(counts, base+8, sizeof(counts));
+       memcpy(&sourceChecksum, base+8+sizeof(counts), sizeof(sourceChecksum));
+       unsigned int version = counts[0];
+       unsigned int headerLen = counts[1];
+       unsigned int nRows = counts[2];
+       unsigned int nValues = counts[3];
+
+       bool ok = memcmp(base, binaryTag, sizeof(binaryTag))==0
+          && version==binaryVersion && headerLen>=7
+          && size == binaryHeaderSize + sizeof(float)*(size_t(headerLen)+nValues)
+                     + sizeof(unsigned int)*(size_t(nRows)+1);
+       if (ok && checksum && *checksum!=sourceChecksum) {
+          std::cout << "PSB97: " << binfile << " was not made from the current xml file, using the xml file" << std::endl;
+          ok = false;
+       };
+
+       const float* header = reinterpret_cast<const float*>(base+binaryHeaderSize);
+       const unsigned int* offset = reinterpret_cast<const unsigned int*>(header+(ok ? headerLen : 0));
+       if (ok) {
+          ok = offset[0]==0 && offset[nRows]==nValues;
+          for (unsigned int i=0; ok && i<nRows; i++) ok = offset[i]<=offset[i+1];
+       };
+       if (!ok) {
+#ifndef WIN32
+          munmap(m_map, m_mapSize);
+#endif
+          m_map = 0;
+          m_mapSize = 0;
+          m_fileData.clear();
+          return false;
+       };
+
+       m_Header = header;
+       m_headerLen = headerLen;
+       m_Offset = offset;
+       m_nRows = nRows;
+       m_Values = reinterpret_cast<const float*>(offset+nRows+1);
+       m_nValues = nValues;
+       return true;
+    };
+
+
+    bool PSB97Model::FluxTable::writeBinary(const string &binfile, unsigned long long checksum) const {
+       ofstream out(binfile.c_str(), ios::binary);
+       if (!out) {
+          std::cerr << "Cannot write " << binfile << std::endl;
+          return false;
+       };
+       unsigned int counts[4] = {binaryVersion, m_headerLen, m_nRows, m_nValues};
+       out.write(binaryTag, sizeof(binaryTag));
+       out.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+       out.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+       out.write(reinterpret_cast<const char*>(m_Header), sizeof(float)*m_headerLen);
+       out.write(reinterpret_cast<const char*>(m_Offset), sizeof(unsigned int)*(m_nRows+1));
+       if (m_nValues>0) out.write(reinterpret_cast<const char*>(m_Values), sizeof(float)*m_nValues);
+       return bool(out);
+    };
  
 
-    PSB97Model::FluxTable::~FluxTable(){};
+    PSB97Model::FluxTable::~FluxTable(){
+#ifndef WIN32
+       if (m_map) munmap(m_map, m_mapSize);
+#endif
+    };
     
     
     float PSB97Model::operator()(float ll,float bb,float ee) const {
+       if (m_Dense.empty()) return tableFlux(ll,bb,ee);
+       float flux;
+       (*this)(ll,bb,&ee,&flux,1);
+       return flux;
+    };
+
+
+    void PSB97Model::operator()(float ll,float bb,const float* ee,float* flux,unsigned int n) const {
+
+       if (m_Dense.empty()) {
+          for (unsigned int i=0; i<n; i++) flux[i] = tableFlux(ll,bb,ee[i]);
+          return;
+       };
+
+       // all the maps share the grid: the cell is found once
+       FluxTable* fluxTab = m_Flux.front();
+       if( (!fluxTab->isInLRange(ll)) || (!fluxTab->isInBRange(bb)) ) {
+          for (unsigned int i=0; i<n; i++) flux[i] = 0.;
+          return;
+       };
+       unsigned int lindex= fluxTab->Lindex(ll);
+       unsigned int bindex= fluxTab->Bindex(bb);
+       float dll= fluxTab->DeltaL(ll);
+       float dbb= fluxTab->DeltaB(bb);
+       if (lindex+1>=m_denseL || bindex+1>=m_denseB) {
+          for (unsigned int i=0; i<n; i++) flux[i] = 0.;
+          return;
+       };
+
+       // interpolated log flux of each map; valid[k] is false where
+       // the scalar evaluation gives 0 whichever the energy
+       const unsigned int ne = m_Flux.size();
+       const float* c11 = &m_Dense[(size_t(lindex)*m_denseB+bindex)*ne];
+       const float* c21 = &m_Dense[(size_t(lindex+1)*m_denseB+bindex)*ne];
+       const float* c12 = &m_Dense[(size_t(lindex)*m_denseB+bindex+1)*ne];
+       const float* c22 = &m_Dense[(size_t(lindex+1)*m_denseB+bindex+1)*ne];
+       float logFlux[maxDenseMaps], energy[maxDenseMaps];
+       bool valid[maxDenseMaps];
+       for (unsigned int k=0; k<ne; k++) {
+          energy[k] = m_Flux[k]->Energy();
+          valid[k] = (c11[k]+c21[k]+c12[k]+c22[k])>1.e-5;
+          logFlux[k] = valid[k] ? log(linear_interpolation(dll,dbb,c11[k],c21[k],c12[k],c22[k])) : 0.f;
+       };
+
+       // the terms of the interpolation between the maps j and j+1,
+       // as in tableFlux; ok[j] is false where it gives 0
+       float lowEnergy[maxDenseMaps], width[maxDenseMaps];
+       float lowLogFlux[maxDenseMaps], logRatio[maxDenseMaps];
+       bool ok[maxDenseMaps];
+       for (unsigned int j=0; j+1<ne; j++) {
+          lowEnergy[j] = energy[j];
+          width[j] = energy[j+1]-energy[j];
+          lowLogFlux[j] = logFlux[j];
+          logRatio[j] = logFlux[j+1]-logFlux[j];
+          ok[j] = valid[j] && valid[j+1] && logFlux[j+1]<logFlux[j];
+       };
+
+       for (unsigned int i=0; i<n; i++) {
+          // the maps below and above the energy: the energies of the
+          // maps increase, so the interval is the number of inner maps
+          // below the energy, with the end intervals extrapolated
+          unsigned int j = 0;
+          for (unsigned int k=1; k+1<ne; k++) j += ee[i]>energy[k];
+
+          float f = exp( lowLogFlux[j]+ (ee[i]-lowEnergy[j])/width[j]*logRatio[j] );
+          flux[i] = (ok[j] && f>=0.01) ? f : 0.f;
+       };
+    };
+
+
+    float PSB97Model::tableFlux(float ll,float bb,float ee) const {
 
 // using namespace std;
 
@@ -5,42 +5,114 @@
 #include <cmath>
 #include <vector>
 #include <string>
+#include <cstddef>
 
 namespace TrappedParticleModels {
 
 
     class PSB97Model {
-      
+
+      /* One (L,B) flux map. The numbers are read from a binary file
+       * (see writeBinary) which is mapped into memory, or, if there is no
+       * binary file matching the xml file, parsed from the xml file.
+       * Row idxL of the map holds the fluxes for B index 0..length-1,
+       * the rows are stored one after the other and m_Offset[idxL] is
+       * the position of the first value of row idxL.
+       */
       struct FluxTable{
-         FluxTable(const std::string &xmlfile);
+         FluxTable(const std::string &xmlfile, bool useBinary=true);
 	 ~FluxTable();
-	 
-	 bool isInLRange(float ll){ return (ll>=m_Header[1] && ll<=m_Header[2] );}; 
-	 bool isInBRange(float bb){ return (bb>=m_Header[4] && bb<=m_Header[5] );}; 
+
+	 bool isInLRange(float ll){ return (ll>=m_Header[1] && ll<=m_Header[2] );};
+	 bool isInBRange(float bb){ return (bb>=m_Header[4] && bb<=m_Header[5] );};
 	 unsigned int Lindex(float ll){ return (unsigned int) ((ll-m_Header[1])/m_Header[3]);};
 	 unsigned int Bindex(float bb){ return (unsigned int) ((bb-m_Header[4])/m_Header[6]);};
 	 float DeltaL(float ll){ return (ll-(m_Header[1]+Lindex(ll)*m_Header[3]))/m_Header[3];};
 	 float DeltaB(float bb){ return (bb-(m_Header[4]+Bindex(bb)*m_Header[6]))/m_Header[6];};
 
-	 bool indexExists(unsigned int idxL,unsigned int idxB){ return idxB < m_Data[idxL].size() ;}; 
-	 float Flux(unsigned int idxL,unsigned int idxB){ return indexExists(idxL,idxB) ? (m_Data[idxL])[idxB] : 0. ;}; 
+	 bool indexExists(unsigned int idxL,unsigned int idxB){ return idxL < m_nRows && idxB < m_Offset[idxL+1]-m_Offset[idxL] ;};
+	 float Flux(unsigned int idxL,unsigned int idxB){ return indexExists(idxL,idxB) ? m_Values[m_Offset[idxL]+idxB] : 0. ;};
          float Energy(){ return m_Header[0];};
-	 
-         std::vector<float> m_Header;
-         std::vector< std::vector<float> > m_Data;
-
-      };	 
-	
-      std::vector<FluxTable*> m_Flux;	
-	 
+
+         // fill the table from the xml file; false on error
+         bool readXml(const std::string &xmlfile);
+         // map a binary file; if checksum is given, the file must have
+         // been made from an xml file with this checksum
+         bool mapBinary(const std::string &binfile, const unsigned long long* checksum);
+         // write the table in the binary format
+         bool writeBinary(const std::string &binfile, unsigned long long checksum) const;
+
+         // the numbers used by the lookups: they point either into
+         // the vectors below or into the mapped binary file
+         const float* m_Header;
+         unsigned int m_headerLen;
+         const unsigned int* m_Offset; ///< m_nRows+1 positions
+         unsigned int m_nRows;
+         const float* m_Values;
+         unsigned int m_nValues;
+
+         // storage of the numbers read from xml
+         std::vector<float> m_headerData;
+         std::vector<unsigned int> m_offsetData;
+         std::vector<float> m_valueData;
+
+         // mapped binary file, or its copy where it cannot be mapped
+         void* m_map;
+         std::size_t m_mapSize;
+         std::vector<float> m_fileData;
+
+      private:
+         FluxTable(const FluxTable&);
+         FluxTable& operator=(const FluxTable&);
+      };
+
+      std::vector<FluxTable*> m_Flux;
+
       public:
          PSB97Model(const std::string& xmldir=".");
-	 ~PSB97Model(){};
-         	  
+	 ~PSB97Model();
+
          float operator()(float ll,float bb, float ee) const;
-      
-      private:	 
+
+         /// flux[i] = (*this)(ll,bb,ee[i]) for n energies.  The (L,B)
+         /// interpolation and its logarithm are done once per flux map,
+         /// with no allocation; each energy then costs one exp and a
+         /// search of its interval without branches.
+         void operator()(float ll,float bb, const float* ee, float* flux, unsigned int n) const;
+
+         /// names of the xml files of the flux maps in the data directory
+         static std::vector<std::string> tableNames();
+
+         /// name of the binary file which goes with an xml file
+         static std::string binaryName(const std::string& xmlfile);
+
+         /// checksum of the content of a file (64 bit FNV-1a); false if
+         /// the file cannot be read
+         static bool fileChecksum(const std::string& file, unsigned long long& checksum);
+
+         /// write the binary file of an xml flux map; false on error
+         static bool convert(const std::string& xmlfile, const std::string& binfile);
+
+      private:
          float linear_interpolation (float dx,float dy,float v11, float v21, float v12, float v22) const;
+
+         // one energy, looking up the flux maps one by one; used if the
+         // maps do not share the (L,B) grid
+         float tableFlux(float ll,float bb, float ee) const;
+
+         // fill m_Dense if all the maps have the same (L,B) grid
+         void buildDense();
+
+         /// most flux maps of the batch evaluation, which keeps those of
+         /// a cell in arrays of this size; more use tableFlux()
+         enum { maxDenseMaps = 4 };
+
+         /// flux maps as one [L][B][E] array, zero outside the maps and
+         /// padded with one row and column of zeros, so that the four
+         /// corners of a cell need no bounds checks and the values of
+         /// all the energies at a corner are next to each other
+         std::vector<float> m_Dense;
+         unsigned int m_denseL, m_denseB;
     };
 
 
@@ -48,4 +120,3 @@ namespace TrappedParticleModels {
 };
 
 #endif
-
@@ -26,8 +26,20 @@
 #include <list>
 #include <string>
 #include <vector>
+#include <thread>
 #include "GaudiKernel/ParticleProperty.h"
 
+#include "CLHEP/Random/JamesRandom.h"
+
+// CRflux components used in the multithreaded test
+#include "../CrProtonPrimary.hh"
+#include "../CrAlphaPrimary.hh"
+#include "../CrElectronPrimary.hh"
+#include "../CrPositronPrimary.hh"
+#include "../CrHeavyIonPrimary.hh"
+#include "../CrHeavyIonPrimaryZ.hh"
+#include "../CrGeomagneticState.hh"
+
 /*! \class CRTestAlg
 \brief 
 
@@ -45,6 +57,13 @@ public:
 
 
 private:
+    /// run independent primary components sequentially and in threads
+    /// and check that they give identical particles
+    StatusCode threadTest();
+
+    /// check that the components share one field evaluation per position
+    StatusCode geomagneticCacheTest();
+
     IFlux* m_flux;
     IFluxSvc* m_fsvc; /// pointer to the flux Service 
     std::string m_source_name;
@@ -53,8 +72,90 @@ private:
     DoubleProperty m_longitude;
     DoubleProperty m_time;
     StringArrayProperty m_rootplot;
+    IntegerProperty m_threads;
+    IntegerProperty m_threadEvents;
 };
 
+namespace {
+    /// One independent source of the multithreaded test:
+    /// a primary component with its own random engine.
+    struct ThreadTestSource {
+        CrSpectrum* spectrum;
+        CLHEP::HepRandomEngine* engine;
+        std::vector<double> particles; ///< (energy, cos(theta), phi) triplets
+    };
+
+    /// Create source i of the test: the species cycles over the primaries
+    /// and each source gets its own cutoff rigidity and seed.
+    ThreadTestSource makeSource(int i, int nsource)
+    {
+        ThreadTestSource source;
+        source.engine = new CLHEP::HepJamesRandom(1000+i);
+        switch (i%6) {
+            case 0: source.spectrum = new CrProtonPrimary; break;
+            case 1: source.spectrum = new CrAlphaPrimary; break;
+            case 2: source.spectrum = new CrElectronPrimary; break;
+            case 3: source.spectrum = new CrPositronPrimary; break;
+            case 4: {
+                CrHeavyIonPrimary* ion = new CrHeavyIonPrimary;
+                ion->setEngine(source.engine);
+                source.spectrum = ion;
+                break;
+            }
+            default: source.spectrum = new CrHeavyIonPrimaryZ(26); break;
+        }
+        source.spectrum->setCutOffRigidity(1.0 + 13.0*i/nsource);
+        return source;
+    }
+
+    /// Generate n particles from one source
+    void generate(ThreadTestSource* source, int n)
+    {
+        source->particles.reserve(3*n);
+        for (int k = 0; k < n; ++k) {
+            source->spectrum->solidAngle(); // the heavy ions select Z here
+            double energy = source->spectrum->energySrc(source->engine);
+            std::pair<double,double> dir = source->spectrum->dir(energy, source->engine);
+            source->particles.push_back(energy);
+            source->particles.push_back(dir.first);
+            source->particles.push_back(dir.second);
+        }
+    }
+
+    /// Thread t of nthread generates the sources t, t+nthread, ...
+    void generateSlice(std::vector<ThreadTestSource>* sources, int t, int nthread, int n)
+    {
+        for (unsigned int i = t; i < sources->size(); i += nthread) {
+            generate(&(*sources)[i], n);
+        }
+    }
+
+    /// Run all sources, sequentially if nthread is 0, and give back the particles
+    std::vector<std::vector<double> > runSources(int nsource, int nthread, int n)
+    {
+        std::vector<ThreadTestSource> sources;
+        for (int i = 0; i < nsource; ++i) {
+            sources.push_back(makeSource(i, nsource));
+        }
+        if (nthread == 0) {
+            generateSlice(&sources, 0, 1, n);
+        } else {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < nthread; ++t) {
+                threads.push_back(std::thread(generateSlice, &sources, t, nthread, n));
+            }
+            for (int t = 0; t < nthread; ++t) threads[t].join();
+        }
+        std::vector<std::vector<double> > particles;
+        for (int i = 0; i < nsource; ++i) {
+            particles.push_back(sources[i].particles);
+            delete sources[i].spectrum;
+            delete sources[i].engine;
+        }
+        return particles;
+    }
+}
+
 
 //static const AlgFactory<CRTestAlg>  Factory;
 //const IAlgFactory& CRTestAlgFactory = Factory;
@@ -70,6 +171,9 @@ Algorithm(name, pSvcLocator){
     declareProperty("longitude", m_longitude=20);
     declareProperty("rootplot", m_rootplot);
     declareProperty("time", m_time=0);
+    // number of threads for the multithreaded test of the primaries (0: no test)
+    declareProperty("threads", m_threads=0);
+    declareProperty("threadEvents", m_threadEvents=10000);
 }
 
 //------------------------------------------------------------------------------
@@ -134,6 +238,14 @@ StatusCode CRTestAlg::initialize() {
     StatusCode sc = service("FluxSvc", m_fsvc);
     m_fsvc->GPSinstance()->time(m_time); //try somethin
     m_fsvc->GPSinstance()->notifyObservers();
+
+    sc = geomagneticCacheTest();
+    if( sc.isFailure() ) return sc;
+
+    if( m_threads > 0 ) {
+        sc = threadTest();
+        if( sc.isFailure() ) return sc;
+    }
 #if 1
     // make the root plots file here
     std::vector<std::string> sargs;
@@ -205,9 +317,64 @@ StatusCode CRTestAlg::execute() {
 }
 
 
+//------------------------------------------------------------------------------
+StatusCode CRTestAlg::threadTest() {
+
+    MsgStream log(msgSvc(), name());
+    int nthread = m_threads;
+    int nsource = 2*nthread;
+    int n = m_threadEvents;
+    log << MSG::INFO << "Multithreaded test: " << nsource << " sources, "
+        << nthread << " threads, " << n << " particles each" << endreq;
+
+    std::vector<std::vector<double> > reference = runSources(nsource, 0, n);
+    std::vector<std::vector<double> > threaded = runSources(nsource, nthread, n);
+
+    int mismatch = 0;
+    for (int i = 0; i < nsource; ++i) {
+        if (reference[i] != threaded[i]) {
+            log << MSG::ERROR << "source " << i
+                << " gives different particles when run in a thread" << endreq;
+            ++mismatch;
+        }
+    }
+    if (mismatch > 0) return StatusCode::FAILURE;
+    log << MSG::INFO << "Multithreaded test: identical output" << endreq;
+    return StatusCode::SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+StatusCode CRTestAlg::geomagneticCacheTest() {
+
+    MsgStream log(msgSvc(), name());
+    CrProtonPrimary proton;
+    CrElectronPrimary electron;
+    CrPositronPrimary positron;
+
+    // one position update for the three components
+    CrGeomagneticState* state = CrGeomagneticState::instance();
+    state->resetCounters();
+    m_fsvc->GPSinstance()->time(m_time+60.);
+    m_fsvc->GPSinstance()->notifyObservers();
+    log << MSG::INFO << "Geomagnetic field cache: " << state->misses()
+        << " evaluations, " << state->hits() << " hits" << endreq;
+
+    if (state->misses() != 1 || state->hits() < 2
+        || proton.cutOffRigidity() != electron.cutOffRigidity()
+        || proton.cutOffRigidity() != positron.cutOffRigidity()) {
+        log << MSG::ERROR << "the field is not shared by the components" << endreq;
+        return StatusCode::FAILURE;
+    }
+    return StatusCode::SUCCESS;
+}
+
 //------------------------------------------------------------------------------
 StatusCode CRTestAlg::finalize() {
 
+    MsgStream log(msgSvc(), name());
+    CrGeomagneticState* state = CrGeomagneticState::instance();
+    log << MSG::INFO << "Geomagnetic field cache: " << state->misses()
+        << " evaluations, " << state->hits() << " hits" << endreq;
     return StatusCode::SUCCESS;
 }
 